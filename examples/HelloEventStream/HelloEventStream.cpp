@@ -0,0 +1,90 @@
+#include <ArduinoHttpServer.h>
+
+#include <Arduino.h>
+
+
+#ifdef ESP8266 // This example is compatible with both, ATMega and ESP8266
+   #include <ESP8266WiFi.h>
+#else
+   #include <SPI.h> //! \todo Temporary see fix: https://github.com/platformio/platformio/issues/48
+   #include <WiFi.h>
+#endif
+
+const char* ssid = "";
+const char* password = "";
+
+WiFiServer wifiServer(80);
+
+// Browsers following /events receive a reading every second.
+ArduinoHttpServer::EventSubscribers<WiFiClient, 4> subscribers;
+unsigned long lastUpdateMs = 0;
+unsigned long lastKeepAliveMs = 0;
+
+const char PAGE[] =
+   "<html><body><pre id=\"log\"></pre><script>"
+   "var events = new EventSource('/events');"
+   "events.addEventListener('reading', function(e) { document.getElementById('log').textContent = e.data; });"
+   "</script></body></html>";
+
+void setup()
+{
+   Serial.begin(115200);
+   Serial.println("Starting Wifi Connection...");
+
+   WiFi.begin(const_cast<char*>(ssid), password);
+   while (WiFi.status() != WL_CONNECTED)
+   {
+      delay(500);
+   }
+
+   wifiServer.begin();
+}
+
+void loop()
+{
+   WiFiClient client( wifiServer.available() );
+   if (client.connected())
+   {
+      ArduinoHttpServer::StreamHttpRequest<128> httpRequest(client);
+
+      if (httpRequest.readRequest() && httpRequest.getResource().toString() == "/events")
+      {
+         // The subscriber set keeps its own copy of the connection.
+         if (!subscribers.add(client, 5000UL))
+         {
+            ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, "text/plain", "503");
+            httpReply.send("Too many subscribers");
+            client.stop();
+         }
+      }
+      else
+      {
+         if (httpRequest.getErrorCode() != ArduinoHttpServer::RequestError::OK)
+         {
+            ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, "text/plain");
+            String errorStr( httpRequest.getError().toString() );
+            httpReply.send( errorStr );
+         }
+         else
+         {
+            ArduinoHttpServer::StreamHttpReply httpReply(httpRequest, "text/html");
+            httpReply.send(PAGE);
+         }
+         client.stop();
+      }
+   }
+
+   if (millis() - lastUpdateMs >= 1000UL)
+   {
+      lastUpdateMs = millis();
+      char data[48];
+      snprintf(data, sizeof(data), "{\"a0\": %d, \"uptime\": %lu}", analogRead(A0), millis() / 1000UL);
+      subscribers.broadcast("reading", data);
+   }
+
+   if (millis() - lastKeepAliveMs >= 15000UL)
+   {
+      lastKeepAliveMs = millis();
+      subscribers.keepAlive();
+   }
+}
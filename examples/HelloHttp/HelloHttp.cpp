@@ -58,7 +58,7 @@ void loop()
          if(!httpRequest.authenticate("user", "secret"))
          {
             // Client did not supply correct credentials. Send request to authenticate itself via autheticate reply.
-            ArduinoHttpServer::StreamHttpAuthenticateReply httpReply(client, httpRequest.getContentType());
+            ArduinoHttpServer::StreamHttpAuthenticateReply httpReply(httpRequest, httpRequest.getContentType());
             httpReply.send();
          }
          else
@@ -72,16 +72,20 @@ void loop()
                Serial.println("Writing HIGH to digital pin 13.");
                digitalWrite(13, HIGH);
             }
+
+            // Reply with the state of the pin.
+            ArduinoHttpServer::StreamHttpReply httpReply(httpRequest, "application/json");
+            httpReply.send("{\"pin13\": " + String(digitalRead(13)) + "}");
          }
       }
       else
       {
          // HTTP parsing failed. Client did not provide correct HTTP data or
          // client requested an unsupported feature.
-         ArduinoHttpServer::StreamHttpErrorReply httpReply(client, httpRequest.getContentType());
+         ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, httpRequest.getContentType());
 
-         const char *pErrorStr( httpRequest.getError().cStr() );
-         String errorStr(pErrorStr); //! \todo Make HttpReply FixString compatible.
+         // Copy into a String while the temporary returned by getError() still exists.
+         String errorStr( httpRequest.getError().toString() ); //! \todo Make HttpReply FixString compatible.
 
          httpReply.send( errorStr );
       }
@@ -46,16 +46,18 @@ void loop()
          // Retrieve 1st part of HTTP resource.
          // E.g.: "api" from "/api/sensors/on"
          Serial.println(httpRequest.getResource()[0]);
-         
+
+         ArduinoHttpServer::StreamHttpReply httpReply(httpRequest, "text/plain");
+         httpReply.send(httpRequest.getResource().toString());
       }
       else
       {
          // HTTP parsing failed. Client did not provide correct HTTP data or
          // client requested an unsupported feature.
-         ArduinoHttpServer::StreamHttpErrorReply httpReply(client, httpRequest.getContentType());
+         ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, httpRequest.getContentType());
 
-         const char *pErrorStr( httpRequest.getError().cStr() );
-         String errorStr(pErrorStr); //! \todo Make HttpReply FixString compatible.
+         // Copy into a String while the temporary returned by getError() still exists.
+         String errorStr( httpRequest.getError().toString() ); //! \todo Make HttpReply FixString compatible.
 
          httpReply.send( errorStr );
       }
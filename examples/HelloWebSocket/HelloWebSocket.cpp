@@ -0,0 +1,113 @@
+#include <ArduinoHttpServer.h>
+
+#include <Arduino.h>
+
+
+#ifdef ESP8266 // This example is compatible with both, ATMega and ESP8266
+   #include <ESP8266WiFi.h>
+#else
+   #include <SPI.h> //! \todo Temporary see fix: https://github.com/platformio/platformio/issues/48
+   #include <WiFi.h>
+#endif
+
+const char* ssid = "";
+const char* password = "";
+
+WiFiServer wifiServer(80);
+
+// One dashboard at a time receives updates over a long-lived WebSocket.
+WiFiClient webSocketClient;
+ArduinoHttpServer::StreamWebSocket webSocket(webSocketClient);
+unsigned long lastUpdateMs = 0;
+char message[16];
+size_t messageLength = 0;
+
+const char PAGE[] =
+   "<html><body><pre id=\"log\"></pre><script>"
+   "var ws = new WebSocket('ws://' + location.host + '/ws');"
+   "ws.onmessage = function(e) { document.getElementById('log').textContent = e.data; };"
+   "</script></body></html>";
+
+void setup()
+{
+   Serial.begin(115200);
+   Serial.println("Starting Wifi Connection...");
+
+   WiFi.begin(const_cast<char*>(ssid), password);
+   while (WiFi.status() != WL_CONNECTED)
+   {
+      delay(500);
+   }
+
+   wifiServer.begin();
+}
+
+void loop()
+{
+   WiFiClient client( wifiServer.available() );
+   if (client.connected())
+   {
+      ArduinoHttpServer::StreamHttpRequest<128> httpRequest(client);
+
+      if (httpRequest.readRequest() && ArduinoHttpServer::StreamWebSocket::isUpgradeRequest(httpRequest) && !webSocketClient.connected())
+      {
+         // Keep the connection; replies are pushed from now on. A previous dashboard which went away
+         // without a close frame is replaced.
+         webSocketClient = client;
+         webSocket.accept(httpRequest);
+         messageLength = 0;
+         Serial.println("WebSocket connected.");
+      }
+      else
+      {
+         if (httpRequest.getErrorCode() != ArduinoHttpServer::RequestError::OK)
+         {
+            ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, "text/plain");
+            String errorStr( httpRequest.getError().toString() );
+            httpReply.send( errorStr );
+         }
+         else if (ArduinoHttpServer::StreamWebSocket::isOtherVersionRequest(httpRequest))
+         {
+            ArduinoHttpServer::StreamWebSocket::rejectVersion(client);
+         }
+         else
+         {
+            ArduinoHttpServer::StreamHttpReply httpReply(httpRequest, "text/html");
+            httpReply.send(PAGE);
+         }
+         client.stop();
+      }
+   }
+
+   if (webSocket.isOpen() && webSocketClient.connected())
+   {
+      // Messages from the dashboard, e.g. "on" or "off", possibly in fragments.
+      if (messageLength == sizeof(message) - 1)
+      {
+         messageLength = 0; // Too long for a command, drop it.
+      }
+      const int length( webSocket.read(message + messageLength, sizeof(message) - 1 - messageLength) );
+      if (length > 0)
+      {
+         messageLength += length;
+      }
+      if (webSocket.isMessageComplete())
+      {
+         message[messageLength] = '\0';
+         messageLength = 0;
+         digitalWrite(13, strcmp(message, "on") == 0 ? HIGH : LOW);
+         webSocket.send(String("pin13 set ") + message);
+      }
+
+      if (millis() - lastUpdateMs >= 1000UL)
+      {
+         lastUpdateMs = millis();
+         webSocket.send("{\"pin13\": " + String(digitalRead(13)) + ", \"uptime\": " + String(millis() / 1000UL) + "}");
+      }
+   }
+   else if (webSocketClient.connected())
+   {
+      // Closed by either side.
+      webSocketClient.stop();
+   }
+}
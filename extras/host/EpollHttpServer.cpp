@@ -0,0 +1,272 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Reference epoll based TCP server loop driving the library's request and reply classes.
+
+#include "EpollHttpServer.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+   const int MAX_EVENTS = 256;
+   const int LISTEN_BACKLOG = 1024;
+   const unsigned long IDLE_CHECK_INTERVAL_MS = 1000UL;
+
+   bool setNonBlocking(int socket)
+   {
+      const int flags(fcntl(socket, F_GETFL, 0));
+      return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+   }
+}
+
+ArduinoHttpServer::EpollHttpServer::EpollHttpServer(uint16_t port, const Handler& handler) :
+   m_port(port),
+   m_handler(handler),
+   m_listenSocket(-1),
+   m_epoll(-1),
+   m_running(false),
+   m_connections(),
+   m_connectionCount(0),
+   m_lastIdleCheckMs(0)
+{
+}
+
+ArduinoHttpServer::EpollHttpServer::~EpollHttpServer()
+{
+   for (size_t socket=0; socket < m_connections.size(); ++socket)
+   {
+      if (m_connections[socket])
+      {
+         closeConnection(static_cast<int>(socket));
+      }
+   }
+   if (m_listenSocket >= 0) { ::close(m_listenSocket); }
+   if (m_epoll >= 0) { ::close(m_epoll); }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Start listening on all interfaces.
+//! \param reusePort Set SO_REUSEPORT so several servers (threads) can share the port.
+//! \returns False when the socket could not be set up.
+bool ArduinoHttpServer::EpollHttpServer::begin(bool reusePort)
+{
+   m_listenSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+   if (m_listenSocket < 0)
+   {
+      return false;
+   }
+
+   const int enable(1);
+   ::setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+   if (reusePort)
+   {
+      ::setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+   }
+
+   sockaddr_in address;
+   memset(&address, 0, sizeof(address));
+   address.sin_family = AF_INET;
+   address.sin_addr.s_addr = htonl(INADDR_ANY);
+   address.sin_port = htons(m_port);
+
+   if (::bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+       ::listen(m_listenSocket, LISTEN_BACKLOG) != 0 ||
+       !setNonBlocking(m_listenSocket))
+   {
+      return false;
+   }
+
+   // Retrieve the actual port when an ephemeral one (0) was requested.
+   socklen_t addressLength(sizeof(address));
+   ::getsockname(m_listenSocket, reinterpret_cast<sockaddr*>(&address), &addressLength);
+   m_port = ntohs(address.sin_port);
+
+   m_epoll = ::epoll_create1(0);
+   epoll_event event;
+   event.events = EPOLLIN;
+   event.data.fd = m_listenSocket;
+   return m_epoll >= 0 && ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listenSocket, &event) == 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Serve until stop() is called, e.g. from the handler or a signal handler.
+void ArduinoHttpServer::EpollHttpServer::run()
+{
+   m_running = true;
+   while (m_running)
+   {
+      poll(100);
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Wait at most _timeoutMs_ for socket events and process them.
+void ArduinoHttpServer::EpollHttpServer::poll(int timeoutMs)
+{
+   epoll_event events[MAX_EVENTS];
+   const int eventCount(::epoll_wait(m_epoll, events, MAX_EVENTS, timeoutMs));
+
+   for (int i=0; i < eventCount; ++i)
+   {
+      if (events[i].data.fd == m_listenSocket)
+      {
+         acceptConnections();
+      }
+      else
+      {
+         serviceConnection(events[i].data.fd, events[i].events);
+      }
+   }
+
+   if (millis() - m_lastIdleCheckMs >= IDLE_CHECK_INTERVAL_MS)
+   {
+      closeIdleConnections();
+      m_lastIdleCheckMs = millis();
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Check whether _data_ holds a complete header plus Content-Length body.
+bool ArduinoHttpServer::EpollHttpServer::isRequestComplete(const char* data, size_t length)
+{
+   static const char CONTENT_LENGTH[] = "content-length:";
+   static const size_t CONTENT_LENGTH_SIZE = sizeof(CONTENT_LENGTH) - 1;
+
+   size_t lineStart(0);
+   unsigned long contentLength(0);
+
+   for (size_t i=0; i < length; ++i)
+   {
+      if (data[i] != '\n')
+      {
+         continue;
+      }
+
+      // Line without its terminator, may still end in '\r'.
+      size_t lineLength(i - lineStart);
+      if (lineLength > 0 && data[i-1] == '\r')
+      {
+         --lineLength;
+      }
+
+      if (lineLength == 0)
+      {
+         // Empty line: header complete.
+         return length - (i + 1) >= contentLength;
+      }
+
+      if (lineLength > CONTENT_LENGTH_SIZE && strncasecmp(data + lineStart, CONTENT_LENGTH, CONTENT_LENGTH_SIZE) == 0)
+      {
+         contentLength = strtoul(data + lineStart + CONTENT_LENGTH_SIZE, 0, 10);
+      }
+      lineStart = i + 1;
+   }
+   return false;
+}
+
+void ArduinoHttpServer::EpollHttpServer::acceptConnections()
+{
+   while (true)
+   {
+      const int socket(::accept4(m_listenSocket, 0, 0, SOCK_NONBLOCK));
+      if (socket < 0)
+      {
+         // EAGAIN: all pending connections accepted. Others (EMFILE) are retried on the next event.
+         return;
+      }
+
+      const int enable(1);
+      ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+      if (static_cast<size_t>(socket) >= m_connections.size())
+      {
+         m_connections.resize(socket + 1);
+      }
+      m_connections[socket].reset(new Connection(socket));
+      ++m_connectionCount;
+
+      epoll_event event;
+      event.events = EPOLLIN | EPOLLRDHUP;
+      event.data.fd = socket;
+      ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, socket, &event);
+   }
+}
+
+void ArduinoHttpServer::EpollHttpServer::serviceConnection(int socket, uint32_t events)
+{
+   Connection* pConnection(m_connections[socket].get());
+   if (!pConnection)
+   {
+      return;
+   }
+   PosixSocketStream& stream(pConnection->stream);
+
+   if (pConnection->handled)
+   {
+      // Only waiting for the reply to be sent.
+      if (stream.sendPending() || (events & (EPOLLERR | EPOLLHUP)))
+      {
+         closeConnection(socket);
+      }
+      return;
+   }
+
+   const bool open(stream.receive());
+   pConnection->lastActivityMs = millis();
+
+   const size_t buffered(stream.peekAvailable());
+   if (!isRequestComplete(stream.peekBuffer(), buffered) && buffered < MAX_BUFFERED_REQUEST_SIZE)
+   {
+      if (!open)
+      {
+         closeConnection(socket);
+      }
+      return;
+   }
+
+   m_handler(stream);
+   pConnection->handled = true;
+
+   if (stream.sendPending())
+   {
+      closeConnection(socket);
+   }
+   else
+   {
+      epoll_event event;
+      event.events = EPOLLOUT;
+      event.data.fd = socket;
+      ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, socket, &event);
+   }
+}
+
+void ArduinoHttpServer::EpollHttpServer::closeConnection(int socket)
+{
+   ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, socket, 0);
+   m_connections[socket].reset();
+   --m_connectionCount;
+}
+
+void ArduinoHttpServer::EpollHttpServer::closeIdleConnections()
+{
+   const unsigned long nowMs(millis());
+   for (size_t socket=0; socket < m_connections.size(); ++socket)
+   {
+      if (m_connections[socket] && nowMs - m_connections[socket]->lastActivityMs >= IDLE_TIMEOUT_MS)
+      {
+         closeConnection(static_cast<int>(socket));
+      }
+   }
+}
@@ -0,0 +1,84 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Reference epoll based TCP server loop driving the library's request and reply classes.
+
+#ifndef __ArduinoHttpServer__EpollHttpServer__
+#define __ArduinoHttpServer__EpollHttpServer__
+
+#include "PosixSocketStream.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Single threaded, readiness driven HTTP server for Linux.
+//! \details Receives on all connections without blocking until a connection has
+//!    buffered a complete request (header and Content-Length body), then calls
+//!    the handler. The handler uses StreamHttpRequest and a reply class on the
+//!    Stream it gets, exactly like device code does on a WiFiClient; since the
+//!    request is complete, readRequest() never waits. Replies always close the
+//!    connection, which happens once all output has been sent.
+class EpollHttpServer
+{
+
+public:
+   typedef std::function<void(Stream& client)> Handler;
+
+   static const size_t MAX_BUFFERED_REQUEST_SIZE = 64U*1024U; //!< Larger requests are handed over incomplete.
+   static const unsigned long IDLE_TIMEOUT_MS = 10000UL;       //!< Connections without a complete request are closed after this.
+
+   EpollHttpServer(uint16_t port, const Handler& handler);
+   ~EpollHttpServer();
+
+   EpollHttpServer(const EpollHttpServer& other) = delete;
+   EpollHttpServer& operator=(const EpollHttpServer& other) = delete;
+
+   bool begin(bool reusePort = false);
+   void poll(int timeoutMs);
+   void run();
+   void stop() { m_running = false; };
+
+   uint16_t getPort() const { return m_port; };
+   size_t getConnectionCount() const { return m_connectionCount; };
+
+   static bool isRequestComplete(const char* data, size_t length);
+
+private:
+   struct Connection
+   {
+      explicit Connection(int socket) : stream(socket), lastActivityMs(millis()), handled(false) {};
+      PosixSocketStream stream;
+      unsigned long lastActivityMs;
+      bool handled; //!< Reply written, waiting for output to drain.
+   };
+
+   void acceptConnections();
+   void serviceConnection(int socket, uint32_t events);
+   void closeConnection(int socket);
+   void closeIdleConnections();
+
+   uint16_t m_port;
+   Handler m_handler;
+   int m_listenSocket;
+   int m_epoll;
+   std::atomic<bool> m_running; //!< Cleared by stop(), possibly from another thread.
+   std::vector<std::unique_ptr<Connection>> m_connections; //!< Indexed by socket.
+   size_t m_connectionCount;
+   unsigned long m_lastIdleCheckMs;
+};
+
+}
+
+#endif // __ArduinoHttpServer__EpollHttpServer__
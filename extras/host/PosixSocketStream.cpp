@@ -0,0 +1,216 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Arduino Stream on top of a POSIX TCP socket.
+
+#include "PosixSocketStream.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+   const size_t RECEIVE_CHUNK_SIZE = 4096U;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Constructor. Takes ownership of _socket_, which should be non-blocking.
+ArduinoHttpServer::PosixSocketStream::PosixSocketStream(int socket) :
+   m_socket(socket),
+   m_peerClosed(false),
+   m_receiveBuffer(),
+   m_readOffset(0),
+   m_sendBuffer(),
+   m_sendOffset(0)
+{
+}
+
+ArduinoHttpServer::PosixSocketStream::~PosixSocketStream()
+{
+   stop();
+}
+
+int ArduinoHttpServer::PosixSocketStream::available()
+{
+   if (bufferedLength() == 0)
+   {
+      receiveOnce();
+   }
+   return static_cast<int>(bufferedLength());
+}
+
+int ArduinoHttpServer::PosixSocketStream::read()
+{
+   if (available() <= 0)
+   {
+      return -1;
+   }
+   return static_cast<unsigned char>(m_receiveBuffer[m_readOffset++]);
+}
+
+int ArduinoHttpServer::PosixSocketStream::peek()
+{
+   if (available() <= 0)
+   {
+      return -1;
+   }
+   return static_cast<unsigned char>(m_receiveBuffer[m_readOffset]);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Copy buffered input in one go, falling back to Stream's timed read
+//!    for the bytes which have not arrived yet.
+size_t ArduinoHttpServer::PosixSocketStream::readBytes(char* buffer, size_t length)
+{
+   size_t count(bufferedLength() < length ? bufferedLength() : length);
+   memcpy(buffer, peekBuffer(), count);
+   peekConsume(count);
+
+   if (count < length)
+   {
+      count += Stream::readBytes(buffer + count, length - count);
+   }
+   return count;
+}
+
+size_t ArduinoHttpServer::PosixSocketStream::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+size_t ArduinoHttpServer::PosixSocketStream::write(const uint8_t* buffer, size_t size)
+{
+   if (m_socket < 0)
+   {
+      return 0;
+   }
+
+   m_sendBuffer.insert(m_sendBuffer.end(), buffer, buffer + size);
+   if (m_sendBuffer.size() - m_sendOffset >= SEND_THRESHOLD)
+   {
+      sendPending();
+   }
+   return size;
+}
+
+int ArduinoHttpServer::PosixSocketStream::availableForWrite()
+{
+   const size_t queued(m_sendBuffer.size() - m_sendOffset);
+   return queued < SEND_THRESHOLD ? static_cast<int>(SEND_THRESHOLD - queued) : 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Block until all buffered output has been handed to the kernel.
+void ArduinoHttpServer::PosixSocketStream::flush()
+{
+   while (!sendPending() && m_socket >= 0)
+   {
+      pollfd pfd = { m_socket, POLLOUT, 0 };
+      ::poll(&pfd, 1, static_cast<int>(getTimeout()));
+   }
+}
+
+void ArduinoHttpServer::PosixSocketStream::peekConsume(size_t length)
+{
+   m_readOffset += length;
+   if (m_readOffset >= m_receiveBuffer.size())
+   {
+      m_receiveBuffer.clear();
+      m_readOffset = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Read everything the kernel has buffered for this socket.
+//! \returns False when the peer closed the connection or an error occurred.
+bool ArduinoHttpServer::PosixSocketStream::receive()
+{
+   while (receiveOnce())
+   {
+   }
+   return m_socket >= 0 && !m_peerClosed;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write as much buffered output as possible without blocking.
+//! \returns True when no output is pending anymore.
+bool ArduinoHttpServer::PosixSocketStream::sendPending()
+{
+   while (hasPendingOutput() && m_socket >= 0)
+   {
+      const ssize_t sent(::send(m_socket, m_sendBuffer.data() + m_sendOffset,
+                                m_sendBuffer.size() - m_sendOffset, MSG_NOSIGNAL));
+      if (sent > 0)
+      {
+         m_sendOffset += static_cast<size_t>(sent);
+      }
+      else if (sent < 0 && errno == EINTR)
+      {
+         continue;
+      }
+      else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      {
+         return false;
+      }
+      else
+      {
+         // Peer gone; drop the output.
+         m_peerClosed = true;
+         m_sendBuffer.clear();
+         m_sendOffset = 0;
+         return true;
+      }
+   }
+
+   m_sendBuffer.clear();
+   m_sendOffset = 0;
+   return true;
+}
+
+void ArduinoHttpServer::PosixSocketStream::stop()
+{
+   if (m_socket >= 0)
+   {
+      ::close(m_socket);
+      m_socket = -1;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Append one recv() worth of data to the receive buffer.
+//! \returns True when data was received and more might be pending.
+bool ArduinoHttpServer::PosixSocketStream::receiveOnce()
+{
+   if (m_socket < 0 || m_peerClosed)
+   {
+      return false;
+   }
+
+   // Reclaim space of consumed bytes before growing the buffer.
+   if (m_readOffset > 0)
+   {
+      m_receiveBuffer.erase(m_receiveBuffer.begin(), m_receiveBuffer.begin() + m_readOffset);
+      m_readOffset = 0;
+   }
+
+   const size_t used(m_receiveBuffer.size());
+   m_receiveBuffer.resize(used + RECEIVE_CHUNK_SIZE);
+   const ssize_t received(::recv(m_socket, m_receiveBuffer.data() + used, RECEIVE_CHUNK_SIZE, MSG_DONTWAIT));
+   m_receiveBuffer.resize(used + (received > 0 ? static_cast<size_t>(received) : 0U));
+
+   if (received > 0)
+   {
+      return true;
+   }
+   if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+   {
+      m_peerClosed = true;
+   }
+   return false;
+}
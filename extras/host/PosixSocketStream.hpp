@@ -0,0 +1,83 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Arduino Stream on top of a POSIX TCP socket.
+
+#ifndef __ArduinoHttpServer__PosixSocketStream__
+#define __ArduinoHttpServer__PosixSocketStream__
+
+#include <Arduino.h>
+
+#include <vector>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Buffered Stream over a connected, non-blocking socket.
+//! \details Input is read into a receive buffer either explicitly by receive()
+//!    (event loops) or on demand by available()/read() when the buffer is empty.
+//!    Output is collected in a send buffer and written by sendPending() (event
+//!    loops) or flush() (blocking).
+class PosixSocketStream: public Stream
+{
+
+public:
+   static const size_t SEND_THRESHOLD = 4U*1460U; //!< Send buffered output once this much is queued.
+
+   explicit PosixSocketStream(int socket);
+   virtual ~PosixSocketStream();
+
+   PosixSocketStream(const PosixSocketStream& other) = delete;
+   PosixSocketStream& operator=(const PosixSocketStream& other) = delete;
+
+   // Stream interface.
+   virtual int available();
+   virtual int read();
+   virtual int peek();
+   virtual size_t readBytes(char* buffer, size_t length);
+   using Stream::readBytes;
+
+   // Print interface.
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   using Print::write;
+   virtual int availableForWrite();
+   virtual void flush();
+
+   // Bulk peek interface: receive buffer access without copying.
+   virtual bool hasPeekBufferAPI() const { return true; };
+   virtual size_t peekAvailable() { return static_cast<size_t>(available()); };
+   virtual const char* peekBuffer() { return m_receiveBuffer.data() + m_readOffset; };
+   virtual void peekConsume(size_t length);
+
+   // Event loop support.
+   bool receive();
+   bool sendPending();
+   bool hasPendingOutput() const { return m_sendOffset < m_sendBuffer.size(); };
+
+   int getSocket() const { return m_socket; };
+   bool connected() const { return m_socket >= 0 && (!m_peerClosed || bufferedLength() > 0); };
+   void stop();
+
+private:
+   size_t bufferedLength() const { return m_receiveBuffer.size() - m_readOffset; };
+   bool receiveOnce();
+
+   int m_socket;
+   bool m_peerClosed;
+   std::vector<char> m_receiveBuffer;
+   size_t m_readOffset;
+   std::vector<uint8_t> m_sendBuffer;
+   size_t m_sendOffset;
+};
+
+}
+
+#endif // __ArduinoHttpServer__PosixSocketStream__
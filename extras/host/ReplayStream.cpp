@@ -0,0 +1,98 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Stream feeding back a connection captured by RecordingStream.
+
+#include "ReplayStream.hpp"
+
+#include <ArduinoHttpServer.h>
+
+#include <fstream>
+#include <iterator>
+
+//------------------------------------------------------------------------------
+//! \brief Constructor. The first record arrives its delay after _startUs_.
+ArduinoHttpServer::ReplayStream::ReplayStream(const Connection& connection, unsigned long startUs)
+{
+   unsigned long arrivalUs(startUs);
+   for (const Record& record : connection.records)
+   {
+      arrivalUs += record.delayUs;
+      addPacket(record.data.data(), record.data.size(), arrivalUs);
+   }
+}
+
+std::string ArduinoHttpServer::ReplayStream::Connection::getData() const
+{
+   std::string data;
+   for (const Record& record : records)
+   {
+      data += record.data;
+   }
+   return data;
+}
+
+bool ArduinoHttpServer::ReplayStream::readCapture(const char* pFileName, std::string& capture)
+{
+   std::ifstream file(pFileName, std::ios::binary);
+   if (!file)
+   {
+      return false;
+   }
+   capture.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Split a capture into connections.
+//! \details Parsing stops at the first malformed or truncated record, in which
+//!    case _complete_ is false and the connections before it are returned.
+std::vector<ArduinoHttpServer::ReplayStream::Connection> ArduinoHttpServer::ReplayStream::parseCapture(const std::string& capture, bool& complete)
+{
+   std::vector<Connection> connections;
+   const uint8_t* pData(reinterpret_cast<const uint8_t*>(capture.data()));
+   const size_t size(capture.size());
+   size_t offset(0);
+   complete = false;
+
+   while (offset < size)
+   {
+      const uint8_t tag(pData[offset++]);
+      unsigned long value(0);
+      const size_t used(decodeRecordingVarint(pData + offset, size - offset, value));
+      if (used == 0)
+      {
+         return connections;
+      }
+      offset += used;
+
+      if (tag == RECORDING_TAG_CONNECTION)
+      {
+         connections.push_back(Connection{value, {}});
+      }
+      else if (tag == RECORDING_TAG_DATA && !connections.empty())
+      {
+         unsigned long length(0);
+         const size_t lengthUsed(decodeRecordingVarint(pData + offset, size - offset, length));
+         if (lengthUsed == 0 || length > size - offset - lengthUsed)
+         {
+            return connections;
+         }
+         offset += lengthUsed;
+
+         connections.back().records.push_back(Record{value, capture.substr(offset, length)});
+         offset += length;
+      }
+      else
+      {
+         return connections;
+      }
+   }
+
+   complete = true;
+   return connections;
+}
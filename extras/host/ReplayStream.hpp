@@ -0,0 +1,52 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Stream feeding back a connection captured by RecordingStream.
+
+#ifndef __ArduinoHttpServer__ReplayStream__
+#define __ArduinoHttpServer__ReplayStream__
+
+#include "SimulatedStream.hpp"
+
+#include <string>
+#include <vector>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! SimulatedStream delivering the records of one captured connection with
+//! their original spacing.
+class ReplayStream: public SimulatedStream
+{
+
+public:
+   struct Record
+   {
+      unsigned long delayUs;  //!< Since the previous record or the start of the connection.
+      std::string data;
+   };
+
+   struct Connection
+   {
+      unsigned long startMs;  //!< millis() on the device when the connection was accepted.
+      std::vector<Record> records;
+
+      std::string getData() const;
+   };
+
+   static bool readCapture(const char* pFileName, std::string& capture);
+   static std::vector<Connection> parseCapture(const std::string& capture, bool& complete);
+
+   ReplayStream(const Connection& connection, unsigned long startUs);
+};
+
+}
+
+#endif // __ArduinoHttpServer__ReplayStream__
@@ -0,0 +1,140 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Stream test double delivering data in timed fragments, like a real network does.
+
+#include "SimulatedStream.hpp"
+
+#include <random>
+
+//------------------------------------------------------------------------------
+//! \brief Constructor. Splits _input_ into packets, the first arriving at _firstPacketUs_.
+ArduinoHttpServer::SimulatedStream::SimulatedStream(const std::string& input, const NetworkConditions& conditions, unsigned long firstPacketUs) :
+   m_input(input),
+   m_packetEnd(),
+   m_arrivalUs(),
+   m_arrivedPackets(0),
+   m_readOffset(0),
+   m_output(),
+   m_peekBufferAPI(false)
+{
+   std::mt19937 random(static_cast<std::mt19937::result_type>(conditions.seed));
+   const size_t minFragmentSize(conditions.minFragmentSize > 0 ? conditions.minFragmentSize : 1);
+   const size_t maxFragmentSize(conditions.maxFragmentSize > minFragmentSize ? conditions.maxFragmentSize : minFragmentSize);
+   std::uniform_int_distribution<size_t> fragmentSize(minFragmentSize, maxFragmentSize);
+   std::uniform_int_distribution<long> jitter(-static_cast<long>(conditions.jitterUs), static_cast<long>(conditions.jitterUs));
+
+   size_t offset(0);
+   unsigned long arrivalUs(firstPacketUs);
+   while (offset < m_input.size())
+   {
+      offset += fragmentSize(random);
+      if (offset > m_input.size()) { offset = m_input.size(); }
+
+      m_packetEnd.push_back(offset);
+      m_arrivalUs.push_back(arrivalUs);
+
+      const long delayUs(static_cast<long>(conditions.interPacketDelayUs) + jitter(random));
+      arrivalUs += delayUs > 0 ? static_cast<unsigned long>(delayUs) : 0UL;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Constructor for derived classes adding their own packets.
+ArduinoHttpServer::SimulatedStream::SimulatedStream() :
+   m_input(),
+   m_packetEnd(),
+   m_arrivalUs(),
+   m_arrivedPackets(0),
+   m_readOffset(0),
+   m_output(),
+   m_peekBufferAPI(false)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//! \brief Append a packet. Arrival times must not decrease.
+void ArduinoHttpServer::SimulatedStream::addPacket(const char* data, size_t length, unsigned long arrivalUs)
+{
+   m_input.append(data, length);
+   m_packetEnd.push_back(m_input.size());
+   m_arrivalUs.push_back(arrivalUs);
+}
+
+int ArduinoHttpServer::SimulatedStream::available()
+{
+   return static_cast<int>(arrivedBytes() - m_readOffset);
+}
+
+int ArduinoHttpServer::SimulatedStream::read()
+{
+   if (available() <= 0)
+   {
+      return -1;
+   }
+   return static_cast<unsigned char>(m_input[m_readOffset++]);
+}
+
+int ArduinoHttpServer::SimulatedStream::peek()
+{
+   if (available() <= 0)
+   {
+      return -1;
+   }
+   return static_cast<unsigned char>(m_input[m_readOffset]);
+}
+
+size_t ArduinoHttpServer::SimulatedStream::readBytes(char* buffer, size_t length)
+{
+   const size_t availableBytes(static_cast<size_t>(available()));
+   size_t count(availableBytes < length ? availableBytes : length);
+   memcpy(buffer, m_input.data() + m_readOffset, count);
+   m_readOffset += count;
+
+   if (count < length)
+   {
+      count += Stream::readBytes(buffer + count, length - count);
+   }
+   return count;
+}
+
+size_t ArduinoHttpServer::SimulatedStream::peekAvailable()
+{
+   return static_cast<size_t>(available());
+}
+
+void ArduinoHttpServer::SimulatedStream::peekConsume(size_t length)
+{
+   const size_t availableBytes(peekAvailable());
+   m_readOffset += availableBytes < length ? availableBytes : length;
+}
+
+size_t ArduinoHttpServer::SimulatedStream::write(uint8_t byte)
+{
+   m_output += static_cast<char>(byte);
+   return 1;
+}
+
+size_t ArduinoHttpServer::SimulatedStream::write(const uint8_t* buffer, size_t size)
+{
+   m_output.append(reinterpret_cast<const char*>(buffer), size);
+   return size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Input offset up to which packets have arrived at the current micros().
+//! \details Time only moves forward, so arrived packets are remembered.
+size_t ArduinoHttpServer::SimulatedStream::arrivedBytes()
+{
+   const unsigned long nowUs(micros());
+   while (m_arrivedPackets < m_arrivalUs.size() && m_arrivalUs[m_arrivedPackets] <= nowUs)
+   {
+      ++m_arrivedPackets;
+   }
+   return m_arrivedPackets > 0 ? m_packetEnd[m_arrivedPackets - 1] : 0;
+}
@@ -0,0 +1,88 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Stream test double delivering data in timed fragments, like a real network does.
+
+#ifndef __ArduinoHttpServer__SimulatedStream__
+#define __ArduinoHttpServer__SimulatedStream__
+
+#include <Arduino.h>
+
+#include <string>
+#include <vector>
+
+namespace ArduinoHttpServer
+{
+
+//! How input arrives at a SimulatedStream.
+struct NetworkConditions
+{
+   size_t minFragmentSize = 1460U;          //!< Bytes per packet, drawn uniformly from [min, max].
+   size_t maxFragmentSize = 1460U;
+   unsigned long interPacketDelayUs = 0UL;  //!< Mean time between packets.
+   unsigned long jitterUs = 0UL;            //!< Delay varies uniformly by +/- this amount.
+   unsigned long seed = 1UL;                //!< Makes runs reproducible.
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Stream whose input becomes available packet by packet according to
+//! NetworkConditions, measured against micros().
+//! \details Optionally offers the bulk peek interface, like the ESP8266
+//!    WiFiClient does. Intended to be used with ArduinoHost::useVirtualClock(), so that
+//!    parser waits (delay(), yield()) advance time deterministically and runs
+//!    do not take real time. Output is collected and can be inspected.
+class SimulatedStream: public Stream
+{
+
+public:
+   SimulatedStream(const std::string& input, const NetworkConditions& conditions, unsigned long firstPacketUs);
+
+   // Stream interface.
+   virtual int available();
+   virtual int read();
+   virtual int peek();
+   virtual size_t readBytes(char* buffer, size_t length);
+   using Stream::readBytes;
+
+   // Print interface.
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   using Print::write;
+   virtual int availableForWrite() { return 1460; };
+
+   // Bulk peek interface, only offered after setPeekBufferAPI(true).
+   virtual bool hasPeekBufferAPI() const { return m_peekBufferAPI; };
+   virtual size_t peekAvailable();
+   virtual const char* peekBuffer() { return m_input.data() + m_readOffset; };
+   virtual void peekConsume(size_t length);
+   void setPeekBufferAPI(bool enable) { m_peekBufferAPI = enable; };
+
+   unsigned long getLastArrivalUs() const { return m_arrivalUs.empty() ? 0UL : m_arrivalUs.back(); };
+   size_t getPacketCount() const { return m_arrivalUs.size(); };
+   const std::string& getOutput() const { return m_output; };
+
+protected:
+   SimulatedStream();
+   void addPacket(const char* data, size_t length, unsigned long arrivalUs);
+
+private:
+   size_t arrivedBytes();
+
+   std::string m_input;
+   std::vector<size_t> m_packetEnd;         //!< Input offset one past each packet.
+   std::vector<unsigned long> m_arrivalUs;  //!< micros() at which each packet arrives.
+   size_t m_arrivedPackets;
+   size_t m_readOffset;
+   std::string m_output;
+   bool m_peekBufferAPI;
+};
+
+}
+
+#endif // __ArduinoHttpServer__SimulatedStream__
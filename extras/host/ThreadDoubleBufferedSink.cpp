@@ -0,0 +1,66 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Double buffered sink draining in a std::thread.
+
+#include "ThreadDoubleBufferedSink.hpp"
+
+ArduinoHttpServer::ThreadDoubleBufferedSink::ThreadDoubleBufferedSink(Print& out, char* pBuffers, size_t bufferSize) :
+   AbstractDoubleBufferedSink(out, pBuffers, bufferSize),
+   m_mutex(),
+   m_changed(),
+   m_draining(false),
+   m_stopping(false),
+   m_thread(&ThreadDoubleBufferedSink::run, this)
+{
+}
+
+ArduinoHttpServer::ThreadDoubleBufferedSink::~ThreadDoubleBufferedSink()
+{
+   waitDrained();
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+   }
+   m_changed.notify_all();
+   m_thread.join();
+}
+
+void ArduinoHttpServer::ThreadDoubleBufferedSink::startDrain()
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_draining = true;
+   }
+   m_changed.notify_all();
+}
+
+void ArduinoHttpServer::ThreadDoubleBufferedSink::waitDrained()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_changed.wait(lock, [this] { return !m_draining; });
+}
+
+void ArduinoHttpServer::ThreadDoubleBufferedSink::run()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   for (;;)
+   {
+      m_changed.wait(lock, [this] { return m_draining || m_stopping; });
+      if (!m_draining)
+      {
+         return;
+      }
+
+      lock.unlock();
+      drain();
+      lock.lock();
+
+      m_draining = false;
+      m_changed.notify_all();
+   }
+}
@@ -0,0 +1,51 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Double buffered sink draining in a std::thread.
+
+#ifndef __ArduinoHttpServer__ThreadDoubleBufferedSink__
+#define __ArduinoHttpServer__ThreadDoubleBufferedSink__
+
+#include "internals/DoubleBufferedSink.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Host counterpart of TaskDoubleBufferedSink: drains in a thread of its own.
+//! Use as DoubleBufferedSink<SIZE, ThreadDoubleBufferedSink>.
+class ThreadDoubleBufferedSink: public AbstractDoubleBufferedSink
+{
+
+public:
+   virtual ~ThreadDoubleBufferedSink();
+
+protected:
+   ThreadDoubleBufferedSink(Print& out, char* pBuffers, size_t bufferSize);
+
+   virtual void startDrain();
+   virtual void waitDrained();
+
+private:
+   void run();
+
+   std::mutex m_mutex;
+   std::condition_variable m_changed;
+   bool m_draining;
+   bool m_stopping;
+   std::thread m_thread;
+};
+
+}
+
+#endif // __ArduinoHttpServer__ThreadDoubleBufferedSink__
@@ -0,0 +1,66 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Worker pool of independent epoll server loops sharing one port.
+
+#include "ThreadedHttpServer.hpp"
+
+ArduinoHttpServer::ThreadedHttpServer::ThreadedHttpServer(uint16_t port, const EpollHttpServer::Handler& handler, unsigned int threadCount) :
+   m_port(port),
+   m_handler(handler),
+   m_threadCount(threadCount > 0 ? threadCount : 1),
+   m_servers(),
+   m_threads()
+{
+}
+
+ArduinoHttpServer::ThreadedHttpServer::~ThreadedHttpServer()
+{
+   stop();
+}
+
+//------------------------------------------------------------------------------
+//! \brief Bind all listening sockets and start the threads.
+//! \details When port 0 is given, the first server picks an ephemeral port
+//!    which the others then share.
+bool ArduinoHttpServer::ThreadedHttpServer::begin()
+{
+   for (unsigned int i=0; i < m_threadCount; ++i)
+   {
+      std::unique_ptr<EpollHttpServer> server(new EpollHttpServer(m_port, m_handler));
+      if (!server->begin(true))
+      {
+         stop();
+         return false;
+      }
+      m_port = server->getPort();
+      m_servers.push_back(std::move(server));
+   }
+
+   for (auto& server : m_servers)
+   {
+      EpollHttpServer* pServer(server.get());
+      m_threads.emplace_back([pServer]() { pServer->run(); });
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Stop and join all threads.
+void ArduinoHttpServer::ThreadedHttpServer::stop()
+{
+   for (auto& server : m_servers)
+   {
+      server->stop();
+   }
+   for (auto& thread : m_threads)
+   {
+      thread.join();
+   }
+   m_threads.clear();
+   m_servers.clear();
+}
@@ -0,0 +1,54 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Worker pool of independent epoll server loops sharing one port.
+
+#ifndef __ArduinoHttpServer__ThreadedHttpServer__
+#define __ArduinoHttpServer__ThreadedHttpServer__
+
+#include "EpollHttpServer.hpp"
+
+#include <thread>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! N threads, each running its own EpollHttpServer on a SO_REUSEPORT socket.
+//! \details The kernel spreads incoming connections over the threads. Every
+//!    thread owns its connections, streams, requests and replies; the handler
+//!    must only share state which is safe to use concurrently, such as
+//!    HttpMetrics. HttpTrace is not thread safe.
+class ThreadedHttpServer
+{
+
+public:
+   ThreadedHttpServer(uint16_t port, const EpollHttpServer::Handler& handler, unsigned int threadCount);
+   ~ThreadedHttpServer();
+
+   ThreadedHttpServer(const ThreadedHttpServer& other) = delete;
+   ThreadedHttpServer& operator=(const ThreadedHttpServer& other) = delete;
+
+   bool begin();
+   void stop();
+
+   uint16_t getPort() const { return m_port; };
+   unsigned int getThreadCount() const { return m_threadCount; };
+
+private:
+   uint16_t m_port;
+   EpollHttpServer::Handler m_handler;
+   unsigned int m_threadCount;
+   std::vector<std::unique_ptr<EpollHttpServer>> m_servers;
+   std::vector<std::thread> m_threads;
+};
+
+}
+
+#endif // __ArduinoHttpServer__ThreadedHttpServer__
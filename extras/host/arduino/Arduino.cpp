@@ -0,0 +1,74 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Host implementation of timing functions and the Serial port.
+
+#include "Arduino.h"
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+
+namespace
+{
+   const auto s_start = std::chrono::steady_clock::now();
+
+   bool s_virtualClock = false;
+   unsigned long s_virtualMicros = 0UL;
+   unsigned long s_yieldCostUs = 1UL;
+}
+
+void ArduinoHost::useVirtualClock(bool enable, unsigned long yieldCostUs)
+{
+   s_virtualClock = enable;
+   s_virtualMicros = 0UL;
+   s_yieldCostUs = yieldCostUs;
+}
+
+bool ArduinoHost::isVirtualClock()
+{
+   return s_virtualClock;
+}
+
+void ArduinoHost::advanceClock(unsigned long us)
+{
+   s_virtualMicros += us;
+}
+
+unsigned long millis()
+{
+   return micros() / 1000UL;
+}
+
+unsigned long micros()
+{
+   if (s_virtualClock)
+   {
+      return s_virtualMicros;
+   }
+   return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_start).count());
+}
+
+void delay(unsigned long ms)
+{
+   if (s_virtualClock)
+   {
+      s_virtualMicros += ms * 1000UL;
+      return;
+   }
+   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield()
+{
+   if (s_virtualClock)
+   {
+      s_virtualMicros += s_yieldCostUs;
+      return;
+   }
+   std::this_thread::yield();
+}
@@ -0,0 +1,64 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Minimal host implementation of the Arduino core API used by the library.
+
+#ifndef __ArduinoHttpServer__HostArduino__
+#define __ArduinoHttpServer__HostArduino__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define A0 14
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline int analogRead(uint8_t) { return 512; }
+
+//! Host only: deterministic time for simulations.
+//! \details While enabled, millis() and micros() return a virtual time which
+//!    only advances by delay(), yield() (by the yield cost) and advanceClock().
+//!    Not thread safe; enable in single threaded simulations only.
+namespace ArduinoHost
+{
+   void useVirtualClock(bool enable, unsigned long yieldCostUs = 1UL);
+   bool isVirtualClock();
+   void advanceClock(unsigned long us);
+}
+
+class HardwareSerial : public Stream
+{
+public:
+   void begin(unsigned long) {}
+   int available() override { return 0; }
+   int read() override { return -1; }
+   int peek() override { return -1; }
+   size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+   size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+   using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
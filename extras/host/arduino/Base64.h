@@ -0,0 +1,35 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Host stand-in for the encoder part of the agdl/Base64 library.
+
+#ifndef __ArduinoHttpServer__HostBase64__
+#define __ArduinoHttpServer__HostBase64__
+class Base64Class
+{
+public:
+   int encodedLength(int plainLength) { return (plainLength + 2 - ((plainLength + 2) % 3)) / 3 * 4; }
+   int encode(char *output, char *input, int inputLength)
+   {
+      static const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+      int o = 0;
+      for (int i = 0; i < inputLength; i += 3)
+      {
+         unsigned long v = (unsigned char)input[i] << 16;
+         if (i + 1 < inputLength) v |= (unsigned char)input[i + 1] << 8;
+         if (i + 2 < inputLength) v |= (unsigned char)input[i + 2];
+         output[o++] = alphabet[(v >> 18) & 63];
+         output[o++] = alphabet[(v >> 12) & 63];
+         output[o++] = i + 1 < inputLength ? alphabet[(v >> 6) & 63] : '=';
+         output[o++] = i + 2 < inputLength ? alphabet[v & 63] : '=';
+      }
+      output[o] = 0;
+      return o;
+   }
+};
+static Base64Class Base64;
+#endif
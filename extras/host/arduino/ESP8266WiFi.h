@@ -0,0 +1,10 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! ESP8266 WiFi library stand-in.
+
+#include "WiFi.h"
@@ -0,0 +1,75 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Minimal host implementation of the Arduino Print class.
+
+#ifndef __ArduinoHttpServer__HostPrint__
+#define __ArduinoHttpServer__HostPrint__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+
+class Print
+{
+public:
+   virtual ~Print() {}
+
+   virtual size_t write(uint8_t c) = 0;
+   virtual size_t write(const uint8_t *buffer, size_t size)
+   {
+      size_t n = 0;
+      while (size--)
+      {
+         if (write(*buffer++)) { n++; }
+         else { break; }
+      }
+      return n;
+   }
+   size_t write(const char *str) { return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0; }
+   size_t write(const char *buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+   virtual int availableForWrite() { return 0; }
+   virtual void flush() {}
+
+   size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+   size_t print(const String &s) { return write(s.c_str(), s.length()); }
+   size_t print(const char *s) { return write(s); }
+   size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+   size_t print(unsigned char v, int base = DEC) { return print(static_cast<unsigned long>(v), base); }
+   size_t print(int v, int base = DEC) { return print(static_cast<long>(v), base); }
+   size_t print(unsigned int v, int base = DEC) { return print(static_cast<unsigned long>(v), base); }
+   size_t print(long v, int base = DEC)
+   {
+      char buf[24];
+      snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", v);
+      return write(buf);
+   }
+   size_t print(unsigned long v, int base = DEC)
+   {
+      char buf[24];
+      snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", v);
+      return write(buf);
+   }
+   size_t print(double v, int digits = 2)
+   {
+      char buf[40];
+      snprintf(buf, sizeof(buf), "%.*f", digits, v);
+      return write(buf);
+   }
+
+   size_t println() { return write("\r\n"); }
+   template <typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+   template <typename T> size_t println(const T &v, int base) { size_t n = print(v, base); return n + println(); }
+};
+
+#endif
@@ -0,0 +1,82 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Minimal host implementation of the Arduino Stream class.
+
+#ifndef __ArduinoHttpServer__HostStream__
+#define __ArduinoHttpServer__HostStream__
+
+#include "Print.h"
+
+unsigned long millis();
+void yield();
+
+//! Bulk peek interface of the ESP8266 core, which announces it with this define.
+#define STREAMSEND_API 1
+
+class Stream : public Print
+{
+public:
+   Stream() : _timeout(1000) {}
+
+   virtual int available() = 0;
+   virtual int read() = 0;
+   virtual int peek() = 0;
+
+   void setTimeout(unsigned long timeout) { _timeout = timeout; }
+   unsigned long getTimeout() const { return _timeout; }
+
+   virtual size_t readBytes(char *buffer, size_t length)
+   {
+      size_t count = 0;
+      while (count < length)
+      {
+         int c = timedRead();
+         if (c < 0) { break; }
+         *buffer++ = static_cast<char>(c);
+         count++;
+      }
+      return count;
+   }
+   size_t readBytes(uint8_t *buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+
+   // Bulk peek interface: direct access to buffered input, when supported.
+   virtual bool hasPeekBufferAPI() const { return false; }
+   virtual size_t peekAvailable() { return 0; }
+   virtual const char* peekBuffer() { return nullptr; }
+   virtual void peekConsume(size_t consume) { (void)consume; }
+
+   size_t readBytesUntil(char terminator, char *buffer, size_t length)
+   {
+      size_t index = 0;
+      while (index < length)
+      {
+         int c = timedRead();
+         if (c < 0 || c == terminator) { break; }
+         *buffer++ = static_cast<char>(c);
+         index++;
+      }
+      return index;
+   }
+
+protected:
+   int timedRead()
+   {
+      unsigned long start = millis();
+      do
+      {
+         int c = read();
+         if (c >= 0) { return c; }
+         yield(); // As the ESP8266 core does.
+      } while (millis() - start < _timeout);
+      return -1;
+   }
+
+   unsigned long _timeout;
+};
+
+#endif
@@ -0,0 +1,136 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Minimal host implementation of the Arduino String class.
+
+#ifndef __ArduinoHttpServer__HostWString__
+#define __ArduinoHttpServer__HostWString__
+
+#include <string>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+
+class String
+{
+public:
+   String(const char *cstr = "") : m_str(cstr ? cstr : "") {}
+   String(const char *cstr, unsigned int len) : m_str(cstr, len) {}
+   String(const __FlashStringHelper *str) : m_str(reinterpret_cast<const char *>(str)) {}
+   explicit String(char c) : m_str(1, c) {}
+   explicit String(unsigned char v, unsigned char base = 10) : m_str(fromLong(v, base)) {}
+   explicit String(int v, unsigned char base = 10) : m_str(fromLong(v, base)) {}
+   explicit String(unsigned int v, unsigned char base = 10) : m_str(fromLong(v, base)) {}
+   explicit String(long v, unsigned char base = 10) : m_str(fromLong(v, base)) {}
+   explicit String(unsigned long v, unsigned char base = 10) : m_str(fromLong(v, base)) {}
+
+   unsigned int length() const { return static_cast<unsigned int>(m_str.size()); }
+   const char *c_str() const { return m_str.c_str(); }
+   char charAt(unsigned int index) const { return index < m_str.size() ? m_str[index] : 0; }
+   char operator[](unsigned int index) const { return charAt(index); }
+   bool reserve(unsigned int size) { m_str.reserve(size); return true; }
+
+   String &operator+=(const String &rhs) { m_str += rhs.m_str; return *this; }
+   String &operator+=(const char *rhs) { m_str += rhs; return *this; }
+   String &operator+=(const __FlashStringHelper *rhs) { m_str += reinterpret_cast<const char *>(rhs); return *this; }
+   String &operator+=(char c) { m_str += c; return *this; }
+   String &operator+=(int v) { m_str += fromLong(v, 10); return *this; }
+   String &operator+=(unsigned int v) { m_str += fromLong(v, 10); return *this; }
+   String &operator+=(long v) { m_str += fromLong(v, 10); return *this; }
+   String &operator+=(unsigned long v) { m_str += fromLong(v, 10); return *this; }
+   String &operator+=(unsigned char v) { m_str += fromLong(v, 10); return *this; }
+   bool concat(const char *cstr, unsigned int len) { m_str.append(cstr, len); return true; }
+   bool concat(const String &s) { m_str += s.m_str; return true; }
+   bool concat(char c) { m_str += c; return true; }
+
+   friend String operator+(const String &lhs, const String &rhs) { String s(lhs); s += rhs; return s; }
+   friend String operator+(const String &lhs, const char *rhs) { String s(lhs); s += rhs; return s; }
+
+   bool operator==(const String &rhs) const { return m_str == rhs.m_str; }
+   bool operator==(const char *rhs) const { return m_str == (rhs ? rhs : ""); }
+   bool operator!=(const String &rhs) const { return !(*this == rhs); }
+   bool operator!=(const char *rhs) const { return !(*this == rhs); }
+   bool equals(const String &rhs) const { return *this == rhs; }
+   bool equalsIgnoreCase(const String &rhs) const
+   {
+      return m_str.size() == rhs.m_str.size() && strcasecmp(m_str.c_str(), rhs.m_str.c_str()) == 0;
+   }
+   bool startsWith(const String &prefix) const { return m_str.compare(0, prefix.m_str.size(), prefix.m_str) == 0; }
+   bool endsWith(const String &suffix) const
+   {
+      return m_str.size() >= suffix.m_str.size() &&
+             m_str.compare(m_str.size() - suffix.m_str.size(), suffix.m_str.size(), suffix.m_str) == 0;
+   }
+
+   int indexOf(char ch, unsigned int from = 0) const { return toIndex(m_str.find(ch, from)); }
+   int indexOf(const String &str, unsigned int from = 0) const { return toIndex(m_str.find(str.m_str, from)); }
+   int indexOf(const char *str, unsigned int from = 0) const { return toIndex(m_str.find(str, from)); }
+   int lastIndexOf(char ch) const { return toIndex(m_str.rfind(ch)); }
+
+   String substring(unsigned int from) const { return from < m_str.size() ? String(m_str.substr(from).c_str()) : String(); }
+   String substring(unsigned int from, unsigned int to) const
+   {
+      if (from > to) { unsigned int t = from; from = to; to = t; }
+      if (from >= m_str.size()) { return String(); }
+      return String(m_str.substr(from, to - from).c_str());
+   }
+
+   void replace(const String &find, const String &replacement)
+   {
+      if (find.m_str.empty()) { return; }
+      std::string::size_type pos = 0;
+      while ((pos = m_str.find(find.m_str, pos)) != std::string::npos)
+      {
+         m_str.replace(pos, find.m_str.size(), replacement.m_str);
+         pos += replacement.m_str.size();
+      }
+   }
+   void toLowerCase() { for (auto &c : m_str) { c = static_cast<char>(tolower(c)); } }
+   void trim()
+   {
+      const char *ws = " \t\r\n";
+      m_str.erase(0, m_str.find_first_not_of(ws));
+      m_str.erase(m_str.find_last_not_of(ws) + 1);
+   }
+   long toInt() const { return atol(m_str.c_str()); }
+
+private:
+   static int toIndex(std::string::size_type pos) { return pos == std::string::npos ? -1 : static_cast<int>(pos); }
+   static std::string fromLong(long v, unsigned char base)
+   {
+      char buf[34];
+      if (base == 16) { snprintf(buf, sizeof(buf), "%lx", v); }
+      else { snprintf(buf, sizeof(buf), "%ld", v); }
+      return buf;
+   }
+   static std::string fromLong(unsigned long v, unsigned char base)
+   {
+      char buf[34];
+      if (base == 16) { snprintf(buf, sizeof(buf), "%lx", v); }
+      else { snprintf(buf, sizeof(buf), "%lu", v); }
+      return buf;
+   }
+   static std::string fromLong(int v, unsigned char base) { return fromLong(static_cast<long>(v), base); }
+   static std::string fromLong(unsigned int v, unsigned char base) { return fromLong(static_cast<unsigned long>(v), base); }
+   static std::string fromLong(unsigned char v, unsigned char base) { return fromLong(static_cast<unsigned long>(v), base); }
+
+   std::string m_str;
+};
+
+#endif
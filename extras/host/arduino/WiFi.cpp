@@ -0,0 +1,152 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! WiFi library stand-in on top of POSIX sockets.
+
+#include "WiFi.h"
+#include "PosixSocketStream.hpp"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+WiFiClient::WiFiClient() :
+   m_socketStream()
+{
+}
+
+WiFiClient::WiFiClient(const std::shared_ptr<ArduinoHttpServer::PosixSocketStream>& socketStream) :
+   m_socketStream(socketStream)
+{
+}
+
+int WiFiClient::available() { return m_socketStream ? m_socketStream->available() : 0; }
+int WiFiClient::read() { return m_socketStream ? m_socketStream->read() : -1; }
+int WiFiClient::peek() { return m_socketStream ? m_socketStream->peek() : -1; }
+size_t WiFiClient::peekAvailable() { return m_socketStream ? m_socketStream->peekAvailable() : 0; }
+const char* WiFiClient::peekBuffer() { return m_socketStream ? m_socketStream->peekBuffer() : nullptr; }
+void WiFiClient::peekConsume(size_t consume) { if (m_socketStream) { m_socketStream->peekConsume(consume); } }
+
+size_t WiFiClient::readBytes(char* buffer, size_t length)
+{
+   if (!m_socketStream)
+   {
+      return 0;
+   }
+   m_socketStream->setTimeout(getTimeout());
+   return m_socketStream->readBytes(buffer, length);
+}
+
+size_t WiFiClient::write(uint8_t byte) { return write(&byte, 1); }
+
+//------------------------------------------------------------------------------
+//! \brief Hand the data to the kernel right away, as the ESP8266 WiFiClient does.
+size_t WiFiClient::write(const uint8_t* buffer, size_t size)
+{
+   if (!m_socketStream)
+   {
+      return 0;
+   }
+   const size_t written(m_socketStream->write(buffer, size));
+   m_socketStream->sendPending();
+   return written;
+}
+int WiFiClient::availableForWrite() { return m_socketStream ? m_socketStream->availableForWrite() : 0; }
+void WiFiClient::flush() { if (m_socketStream) { m_socketStream->flush(); } }
+
+//------------------------------------------------------------------------------
+//! \brief Poll the socket, so a peer which closed is noticed without reading,
+//!    as lwIP does on the ESP8266.
+uint8_t WiFiClient::connected()
+{
+   if (!m_socketStream)
+   {
+      return false;
+   }
+   m_socketStream->available();
+   return m_socketStream->connected();
+}
+
+//! \brief Send pending output, then close.
+void WiFiClient::stop()
+{
+   if (m_socketStream)
+   {
+      m_socketStream->flush();
+      m_socketStream->stop();
+      m_socketStream.reset();
+   }
+}
+
+WiFiServer::WiFiServer(uint16_t port) :
+   m_port(port),
+   m_listenSocket(-1)
+{
+   const char* pPort(getenv("AHS_HOST_PORT"));
+   if (pPort)
+   {
+      m_port = static_cast<uint16_t>(atoi(pPort));
+   }
+}
+
+WiFiServer::~WiFiServer()
+{
+   if (m_listenSocket >= 0)
+   {
+      ::close(m_listenSocket);
+   }
+}
+
+void WiFiServer::begin()
+{
+   m_listenSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+   const int enable(1);
+   ::setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+   sockaddr_in address;
+   memset(&address, 0, sizeof(address));
+   address.sin_family = AF_INET;
+   address.sin_addr.s_addr = htonl(INADDR_ANY);
+   address.sin_port = htons(m_port);
+
+   if (::bind(m_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+       ::listen(m_listenSocket, 1024) != 0)
+   {
+      perror("WiFiServer::begin");
+      exit(1);
+   }
+   printf("Listening on port %u\n", m_port);
+   fflush(stdout);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Accept a pending connection, waiting at most a few milliseconds so
+//!    that loop() does not spin.
+WiFiClient WiFiServer::available()
+{
+   pollfd pfd = { m_listenSocket, POLLIN, 0 };
+   if (::poll(&pfd, 1, 10) <= 0)
+   {
+      return WiFiClient();
+   }
+
+   const int socket(::accept4(m_listenSocket, 0, 0, SOCK_NONBLOCK));
+   if (socket < 0)
+   {
+      return WiFiClient();
+   }
+
+   const int enable(1);
+   ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+   return WiFiClient(std::make_shared<ArduinoHttpServer::PosixSocketStream>(socket));
+}
@@ -0,0 +1,77 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! WiFi library stand-in on top of POSIX sockets, so sketches run unmodified on the host.
+//! The listening port can be overridden with the AHS_HOST_PORT environment variable.
+
+#ifndef __ArduinoHttpServer__HostWiFi__
+#define __ArduinoHttpServer__HostWiFi__
+
+#include <Arduino.h>
+
+#include <memory>
+
+namespace ArduinoHttpServer { class PosixSocketStream; }
+
+enum wl_status_t { WL_IDLE_STATUS = 0, WL_CONNECTED = 3 };
+
+class WiFiClass
+{
+public:
+   int begin(const char*, const char* = 0) { return WL_CONNECTED; }
+   int begin(char* ssid, const char* passphrase = 0) { return begin(const_cast<const char*>(ssid), passphrase); }
+   wl_status_t status() { return WL_CONNECTED; }
+};
+
+extern WiFiClass WiFi;
+
+//! Copyable handle to an accepted connection, like the Arduino WiFiClient.
+class WiFiClient: public Stream
+{
+public:
+   WiFiClient();
+   explicit WiFiClient(const std::shared_ptr<ArduinoHttpServer::PosixSocketStream>& socketStream);
+
+   virtual int available();
+   virtual int read();
+   virtual int peek();
+   virtual size_t readBytes(char* buffer, size_t length);
+   using Stream::readBytes;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   using Print::write;
+   virtual int availableForWrite();
+   virtual void flush();
+
+   virtual bool hasPeekBufferAPI() const { return true; }
+   virtual size_t peekAvailable();
+   virtual const char* peekBuffer();
+   virtual void peekConsume(size_t consume);
+
+   uint8_t connected();
+   void stop();
+   operator bool() { return connected(); }
+
+private:
+   std::shared_ptr<ArduinoHttpServer::PosixSocketStream> m_socketStream;
+};
+
+class WiFiServer
+{
+public:
+   explicit WiFiServer(uint16_t port);
+   ~WiFiServer();
+
+   void begin();
+   WiFiClient available();
+
+private:
+   uint16_t m_port;
+   int m_listenSocket;
+};
+
+#endif // __ArduinoHttpServer__HostWiFi__
@@ -0,0 +1,23 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Runs a sketch's setup() and loop() on the host.
+
+#include <Arduino.h>
+
+void setup();
+void loop();
+
+int main()
+{
+   setup();
+   while (true)
+   {
+      loop();
+   }
+   return 0;
+}
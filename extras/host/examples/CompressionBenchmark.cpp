@@ -0,0 +1,137 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Bytes saved by DeflateWriter against the CPU time it costs, for typical
+//! JSON and HTML replies and window sizes.
+//! Usage: ahs_compression_benchmark [repetitions] [device slowdown]
+//! "break-even" is the link speed below which compressing is faster than
+//! sending raw: bytes saved divided by compression time. The compression time
+//! is the host's multiplied by the device slowdown, e.g. 30 to estimate a
+//! 240 MHz ESP32 from a desktop.
+
+#include <ArduinoHttpServer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+
+namespace
+{
+   //! Counts the compressed bytes.
+   class CountingPrint: public Print
+   {
+   public:
+      CountingPrint() : m_count(0) {}
+      virtual size_t write(uint8_t byte) { ++m_count; return 1; }
+      virtual size_t write(const uint8_t* buffer, size_t size) { m_count += size; return size; }
+      size_t getCount() const { return m_count; }
+
+   private:
+      size_t m_count;
+   };
+
+   std::string makeSensorJson(unsigned readings)
+   {
+      std::string json("[");
+      for (unsigned i=0; i < readings; ++i)
+      {
+         char reading[160];
+         snprintf(reading, sizeof(reading), "%s{\"sensor\":\"temperature_%u\",\"value\":%.2f,\"unit\":\"celsius\",\"timestamp\":%lu,\"ok\":true}",
+                  i > 0 ? "," : "", i % 8U, 18.0 + (i * 37U % 100U) / 10.0, 1700000000UL + i * 60UL);
+         json += reading;
+      }
+      return json + "]";
+   }
+
+   std::string makeConfigPage()
+   {
+      std::string html("<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>Device configuration</title>"
+                       "<style>body{font-family:sans-serif;margin:2em}label{display:block;margin-top:1em}"
+                       "input{width:20em}.row{display:flex;gap:1em}</style></head><body><h1>Configuration</h1>"
+                       "<form method=\"post\" action=\"/config\">");
+      static const char* const FIELDS[] = { "ssid", "password", "hostname", "mqtt_server", "mqtt_port", "mqtt_user",
+                                            "mqtt_password", "ntp_server", "timezone", "interval" };
+      for (unsigned repeat=0; repeat < 3U; ++repeat)
+      {
+         for (const char* field : FIELDS)
+         {
+            html += std::string("<div class=\"row\"><label for=\"") + field + "\">" + field + "</label><input type=\"text\" id=\"" +
+                    field + "\" name=\"" + field + "\" value=\"\"></div>";
+         }
+      }
+      return html + "<input type=\"submit\" value=\"Save\"></form></body></html>";
+   }
+
+   struct Result
+   {
+      size_t compressedSize;
+      double nsPerByte;
+   };
+
+   template <size_t WINDOW_SIZE>
+   Result measure(const std::string& payload, unsigned repetitions)
+   {
+      Result result = { 0U, 0.0 };
+      const auto start(std::chrono::steady_clock::now());
+      for (unsigned i=0; i < repetitions; ++i)
+      {
+         CountingPrint out;
+         ArduinoHttpServer::DeflateWriter<WINDOW_SIZE> deflate(out, ArduinoHttpServer::AbstractDeflateWriter::Format::GZIP);
+         // As a JsonWriter<64> would write it.
+         for (size_t offset=0; offset < payload.size(); offset += 64U)
+         {
+            const size_t length(payload.size() - offset < 64U ? payload.size() - offset : 64U);
+            deflate.write(reinterpret_cast<const uint8_t*>(payload.data() + offset), length);
+         }
+         deflate.finish();
+         result.compressedSize = out.getCount();
+      }
+      const double ns(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+      result.nsPerByte = ns / repetitions / payload.size();
+      return result;
+   }
+
+   template <size_t WINDOW_SIZE>
+   void report(const char* name, const std::string& payload, unsigned repetitions, double slowdown)
+   {
+      const Result result(measure<WINDOW_SIZE>(payload, repetitions));
+      const double deviceSeconds(result.nsPerByte * slowdown * payload.size() / 1e9);
+      const double savedBytes(static_cast<double>(payload.size()) - static_cast<double>(result.compressedSize));
+      printf("%-12s %8zu %7zu %9zu %6.1f%% %8.1f %13.0f\n", name, payload.size(), WINDOW_SIZE, result.compressedSize,
+             100.0 * result.compressedSize / payload.size(), result.nsPerByte,
+             savedBytes > 0.0 ? savedBytes / deviceSeconds / 1024.0 : 0.0);
+   }
+
+   template <size_t WINDOW_SIZE>
+   void reportAll(unsigned repetitions, double slowdown)
+   {
+      report<WINDOW_SIZE>("json 10", makeSensorJson(10U), repetitions, slowdown);
+      report<WINDOW_SIZE>("json 200", makeSensorJson(200U), repetitions, slowdown);
+      report<WINDOW_SIZE>("config html", makeConfigPage(), repetitions, slowdown);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned repetitions(argc > 1 ? static_cast<unsigned>(atoi(argv[1])) : 200U);
+   const double slowdown(argc > 2 ? atof(argv[2]) : 1.0);
+   if (repetitions == 0U || slowdown <= 0.0)
+   {
+      fprintf(stderr, "usage: %s [repetitions] [device slowdown]\n", argv[0]);
+      return 1;
+   }
+
+   printf("gzip through DeflateWriter, %u repetitions, device slowdown %.0f\n\n", repetitions, slowdown);
+   printf("%-12s %8s %7s %9s %7s %8s %13s\n", "payload", "bytes", "window", "gzip", "ratio", "ns/byte", "break-even KB/s");
+   reportAll<512>(repetitions, slowdown);
+   reportAll<1024>(repetitions, slowdown);
+   reportAll<4096>(repetitions, slowdown);
+
+   return 0;
+}
@@ -0,0 +1,114 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Device simulator: serves many concurrent connections with device style handler code.
+//! Usage: ahs_epoll_server [port]
+//! The most recent requests can be downloaded from /debug/capture and fed to ahs_replay.
+
+#include <ArduinoHttpServer.h>
+
+#include "EpollHttpServer.hpp"
+
+#include <signal.h>
+#include <stdio.h>
+
+namespace
+{
+   ArduinoHttpServer::HttpMetrics metrics;
+   ArduinoHttpServer::RecordingBuffer<16384> capture;
+   ArduinoHttpServer::EpollHttpServer* pServer(0);
+
+   void writeReading(ArduinoHttpServer::AbstractJsonWriter& json, const String& sensor)
+   {
+      json.beginObject();
+      json.key("sensor");
+      json.value(sensor);
+      json.key("value");
+      json.value(42);
+      json.endObject();
+   }
+
+   //! Refuses requests for unknown resources before their fields and body are read.
+   struct ResourceFilter : ArduinoHttpServer::AbstractRequestFilter<1024>
+   {
+      const char* requestLineRead(const Request& request) override
+      {
+         const String resource(request.getResource().toString());
+         const bool known(resource == "/metrics" || resource == "/debug/capture" || request.getResource()[0] == "api");
+         return known ? 0 : "404";
+      }
+   };
+
+   //! The same code a sketch runs for each WiFiClient.
+   void handle(Stream& connection)
+   {
+      ArduinoHttpServer::RecordingStream client(connection, capture);
+      ArduinoHttpServer::HttpMetricsObserver observer(metrics);
+      ArduinoHttpServer::StreamHttpRequest<1024> httpRequest(client);
+      ResourceFilter filter;
+      httpRequest.setObserver(&observer);
+      httpRequest.setFilter(&filter);
+
+      if (!httpRequest.readRequest())
+      {
+         ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, "text/plain");
+         httpReply.setObserver(&observer);
+         httpReply.send(httpRequest.getError().toString());
+         return;
+      }
+
+      if (httpRequest.getResource().toString() == "/metrics")
+      {
+         metrics.sendReply(client, httpRequest.getMethod());
+      }
+      else if (httpRequest.getResource().toString() == "/debug/capture")
+      {
+         capture.sendReply(client, httpRequest.getMethod());
+      }
+      else
+      {
+         const String sensor(httpRequest.getResource()[1]);
+         ArduinoHttpServer::JsonWriter<> counter;
+         writeReading(counter, sensor);
+
+         ArduinoHttpServer::StreamHttpReply httpReply(httpRequest, "application/json");
+         httpReply.setObserver(&observer);
+         httpReply.sendHeader(counter.getLength());
+         if (httpReply.hasBody())
+         {
+            ArduinoHttpServer::JsonWriter<> json(client);
+            writeReading(json, sensor);
+         }
+      }
+   }
+
+   void onSignal(int)
+   {
+      pServer->stop();
+   }
+}
+
+int main(int argc, char** argv)
+{
+   const uint16_t port(argc > 1 ? static_cast<uint16_t>(atoi(argv[1])) : 8080);
+
+   ArduinoHttpServer::EpollHttpServer server(port, handle);
+   if (!server.begin())
+   {
+      perror("begin");
+      return 1;
+   }
+
+   pServer = &server;
+   signal(SIGINT, onSignal);
+   signal(SIGTERM, onSignal);
+
+   printf("Listening on port %u\n", server.getPort());
+   fflush(stdout);
+   server.run();
+   return 0;
+}
@@ -0,0 +1,170 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Latency StreamHttpRequest adds on top of the network, over a matrix of
+//! fragment sizes, inter-packet delays and jitter.
+//! Usage: ahs_parser_benchmark [requests per cell] [yield cost in us]
+//! Runs on the virtual clock: "added" is the time from the last packet's
+//! arrival until readRequest() returns, as a device would see it. "cpu" is
+//! the real host time spent per request, which includes the simulation. The
+//! same request parsed with HttpRequestParser::feed() from memory is the baseline.
+//! Each cell is run reading the stream ("read") and through the bulk peek
+//! interface ("peek").
+
+#include <ArduinoHttpServer.h>
+
+#include "SimulatedStream.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace
+{
+   const char REQUEST[] =
+      "POST /api/sensors/temperature HTTP/1.1\r\n"
+      "Host: 192.168.1.20\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)\r\n"
+      "Accept: application/json\r\n"
+      "Content-Type: application/json\r\n"
+      "Content-Length: 64\r\n"
+      "Connection: close\r\n"
+      "\r\n"
+      "{\"sensor\": \"temperature\", \"value\": 21.5, \"unit\": \"celsius\"}     ";
+
+   //! Latest moment the first packet arrives, relative to the start of readRequest().
+   const unsigned long MAX_FIRST_PACKET_OFFSET_US = 20000UL;
+
+   struct CellResult
+   {
+      unsigned long addedP50Us;
+      unsigned long addedMaxUs;
+      unsigned long totalP50Us;
+      unsigned long cpuNs;
+      unsigned failures;
+   };
+
+   unsigned long percentile(std::vector<unsigned long>& values, unsigned percent)
+   {
+      std::sort(values.begin(), values.end());
+      return values[(values.size() - 1U) * percent / 100U];
+   }
+
+   //! Real time per request when all input is already in memory.
+   unsigned long measureMemoryParse(unsigned requests)
+   {
+      const auto start(std::chrono::steady_clock::now());
+      for (unsigned i=0; i < requests; ++i)
+      {
+         ArduinoHttpServer::HttpRequestParser<128> parser;
+         parser.feed(REQUEST, sizeof(REQUEST) - 1U);
+         if (parser.getState() != ArduinoHttpServer::HttpRequestParser<128>::State::COMPLETE)
+         {
+            fprintf(stderr, "Parse failed: %s\n", parser.getError().toString().c_str());
+            exit(1);
+         }
+      }
+      const auto elapsed(std::chrono::steady_clock::now() - start);
+      return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / requests);
+   }
+
+   CellResult runCell(const ArduinoHttpServer::NetworkConditions& conditions, bool peekBufferAPI, unsigned requests)
+   {
+      std::mt19937 random(static_cast<std::mt19937::result_type>(conditions.seed));
+      std::uniform_int_distribution<unsigned long> firstPacketOffset(0UL, MAX_FIRST_PACKET_OFFSET_US);
+
+      std::vector<unsigned long> added;
+      std::vector<unsigned long> total;
+      unsigned failures(0);
+      const auto start(std::chrono::steady_clock::now());
+
+      for (unsigned i=0; i < requests; ++i)
+      {
+         ArduinoHttpServer::NetworkConditions requestConditions(conditions);
+         requestConditions.seed = conditions.seed + i;
+
+         const unsigned long startUs(micros());
+         ArduinoHttpServer::SimulatedStream stream(REQUEST, requestConditions, startUs + firstPacketOffset(random));
+         stream.setPeekBufferAPI(peekBufferAPI);
+         ArduinoHttpServer::StreamHttpRequest<128> httpRequest(stream);
+
+         if (!httpRequest.readRequest())
+         {
+            ++failures;
+            continue;
+         }
+         const unsigned long doneUs(micros());
+         added.push_back(doneUs > stream.getLastArrivalUs() ? doneUs - stream.getLastArrivalUs() : 0UL);
+         total.push_back(doneUs - startUs);
+      }
+
+      const auto elapsed(std::chrono::steady_clock::now() - start);
+      CellResult result = { 0UL, 0UL, 0UL, 0UL, failures };
+      if (!added.empty())
+      {
+         result.addedP50Us = percentile(added, 50);
+         result.addedMaxUs = added.back();
+         result.totalP50Us = percentile(total, 50);
+      }
+      result.cpuNs = static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / requests);
+      return result;
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   const unsigned requests(argc > 1 ? static_cast<unsigned>(atoi(argv[1])) : 100U);
+   const unsigned long yieldCostUs(argc > 2 ? static_cast<unsigned long>(atol(argv[2])) : 10UL);
+   if (requests == 0U || yieldCostUs == 0UL)
+   {
+      fprintf(stderr, "usage: %s [requests per cell] [yield cost in us]\n", argv[0]);
+      return 1;
+   }
+
+   ArduinoHost::useVirtualClock(true, yieldCostUs);
+
+   static const size_t FRAGMENT_SIZES[] = { 1U, 16U, 64U, 536U, 1460U };
+   static const unsigned long DELAYS_US[] = { 0UL, 1000UL, 5000UL };
+
+   printf("%zu byte request, %u requests per cell, yield costs %lu us\n\n", sizeof(REQUEST) - 1U, requests, yieldCostUs);
+   printf("%9s %9s %9s %5s | %11s %11s %11s %9s %8s\n",
+          "fragment", "delay us", "jitter us", "api", "added p50", "added max", "total p50", "cpu ns", "failed");
+
+   for (const size_t fragmentSize : FRAGMENT_SIZES)
+   {
+      for (const unsigned long delayUs : DELAYS_US)
+      {
+         // Jitter is only meaningful when packets are spaced out.
+         const unsigned long jitters[] = { 0UL, delayUs / 2UL };
+         for (unsigned j=0; j < (delayUs > 0UL ? 2U : 1U); ++j)
+         {
+            ArduinoHttpServer::NetworkConditions conditions;
+            conditions.minFragmentSize = fragmentSize;
+            conditions.maxFragmentSize = fragmentSize;
+            conditions.interPacketDelayUs = delayUs;
+            conditions.jitterUs = jitters[j];
+            conditions.seed = 1UL + fragmentSize * 1000UL + delayUs + jitters[j];
+
+            for (const bool peekBufferAPI : { false, true })
+            {
+               const CellResult result(runCell(conditions, peekBufferAPI, requests));
+               printf("%9zu %9lu %9lu %5s | %11lu %11lu %11lu %9lu %8u\n",
+                      fragmentSize, delayUs, jitters[j], peekBufferAPI ? "peek" : "read",
+                      result.addedP50Us, result.addedMaxUs, result.totalP50Us, result.cpuNs, result.failures);
+            }
+         }
+      }
+   }
+
+   printf("\nHttpRequestParser::feed() from memory: %lu ns per request\n", measureMemoryParse(requests * 100U));
+
+   return 0;
+}
@@ -0,0 +1,135 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Throughput of ThreadedHttpServer versus the number of server threads.
+//! Usage: ahs_thread_benchmark [max server threads] [client threads] [seconds per run]
+//! Clients run in the same process and compete for the same cores; compare
+//! runs with each other rather than with other servers.
+
+#include <ArduinoHttpServer.h>
+
+#include "ThreadedHttpServer.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+   ArduinoHttpServer::HttpMetrics metrics;
+
+   void handle(Stream& client)
+   {
+      ArduinoHttpServer::HttpMetricsObserver observer(metrics);
+      ArduinoHttpServer::StreamHttpRequest<512> httpRequest(client);
+      httpRequest.setObserver(&observer);
+
+      if (httpRequest.readRequest())
+      {
+         ArduinoHttpServer::StreamHttpReply httpReply(httpRequest, "application/json");
+         httpReply.setObserver(&observer);
+         httpReply.send("{\"sensor\": \"" + httpRequest.getResource()[1] + "\", \"value\": 42}");
+      }
+      else
+      {
+         ArduinoHttpServer::StreamHttpErrorReply httpReply(httpRequest, "text/plain");
+         httpReply.send(httpRequest.getError().toString());
+      }
+   }
+
+   //! One request per connection, as the server always closes.
+   bool doRequest(uint16_t port)
+   {
+      static const char REQUEST[] = "GET /api/temperature HTTP/1.1\r\nHost: localhost\r\nUser-Agent: bench\r\n\r\n";
+
+      const int sock(::socket(AF_INET, SOCK_STREAM, 0));
+      sockaddr_in address;
+      memset(&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_port = htons(port);
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+      bool ok(false);
+      if (::connect(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+          ::send(sock, REQUEST, sizeof(REQUEST) - 1, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(REQUEST) - 1))
+      {
+         char buffer[512];
+         ssize_t received(::recv(sock, buffer, sizeof(buffer), 0));
+         ok = received >= 12 && memcmp(buffer, "HTTP/1.1 200", 12) == 0;
+
+         // Read until the server closes.
+         while (received > 0)
+         {
+            received = ::recv(sock, buffer, sizeof(buffer), 0);
+         }
+      }
+      ::close(sock);
+      return ok;
+   }
+
+   double measure(unsigned int serverThreads, unsigned int clientThreads, double seconds)
+   {
+      ArduinoHttpServer::ThreadedHttpServer server(0, handle, serverThreads);
+      if (!server.begin())
+      {
+         perror("begin");
+         return 0.0;
+      }
+
+      std::atomic<bool> running(true);
+      std::atomic<unsigned long> completed(0);
+      std::atomic<unsigned long> failed(0);
+      std::vector<std::thread> clients;
+
+      for (unsigned int i=0; i < clientThreads; ++i)
+      {
+         clients.emplace_back([&]()
+         {
+            while (running)
+            {
+               if (doRequest(server.getPort())) { ++completed; } else { ++failed; }
+            }
+         });
+      }
+
+      const auto start(std::chrono::steady_clock::now());
+      std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+      running = false;
+      for (auto& client : clients) { client.join(); }
+      const double elapsed(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+      if (failed > 0)
+      {
+         printf("   (%lu failed requests)\n", failed.load());
+      }
+      return completed / elapsed;
+   }
+}
+
+int main(int argc, char** argv)
+{
+   const unsigned int maxServerThreads(argc > 1 ? atoi(argv[1]) : std::thread::hardware_concurrency());
+   const unsigned int clientThreads(argc > 2 ? atoi(argv[2]) : 8);
+   const double seconds(argc > 3 ? atof(argv[3]) : 2.0);
+
+   printf("server threads | requests/s | scaling\n");
+   double baseline(0.0);
+   for (unsigned int threads=1; threads <= maxServerThreads; threads *= 2)
+   {
+      const double rate(measure(threads, clientThreads, seconds));
+      if (baseline <= 0.0) { baseline = rate; }
+      printf("%14u | %10.0f | %6.2fx\n", threads, rate, baseline > 0.0 ? rate / baseline : 0.0);
+      fflush(stdout);
+   }
+   return 0;
+}
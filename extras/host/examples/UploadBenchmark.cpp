@@ -0,0 +1,185 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Upload throughput of StreamHttpRequest::streamBody() into a slow flash,
+//! written to directly, through a synchronous DoubleBufferedSink and through
+//! one draining in a thread.
+//! Usage: ahs_upload_benchmark [body KB] [link KB/s] [flash KB/s] [window bytes]
+//! Runs in real time. The link delivers 1460 byte segments at its rate but,
+//! like TCP, stops while the receiver's window is full. Every flash write
+//! costs a fixed overhead plus its length at the flash rate.
+//! The window keeps receiving while a synchronous sink writes; the more of a
+//! sector write it covers, the less a draining thread adds.
+
+#include <ArduinoHttpServer.h>
+
+#include "ThreadDoubleBufferedSink.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace
+{
+   const size_t SEGMENT_SIZE = 1460U;
+   const size_t DEFAULT_RECEIVE_WINDOW = 5840U; //!< lwIP's default TCP_WND on the ESP8266.
+   const unsigned long FLASH_WRITE_OVERHEAD_US = 100UL;
+   const size_t FLASH_SECTOR_SIZE = 4096U;
+
+   //! Request arriving over a link of limited rate and receive window.
+   class WindowedLink: public Stream
+   {
+   public:
+      WindowedLink(const std::string& input, unsigned long segmentUs, size_t window) :
+         m_input(input),
+         m_arrived(0),
+         m_read(0),
+         m_segmentUs(segmentUs),
+         m_window(window),
+         m_nextArrivalUs(micros() + segmentUs)
+      {
+      }
+
+      virtual int available() { advance(); return static_cast<int>(m_arrived - m_read); }
+      virtual int read() { return available() > 0 ? static_cast<unsigned char>(m_input[m_read++]) : -1; }
+      virtual int peek() { return available() > 0 ? static_cast<unsigned char>(m_input[m_read]) : -1; }
+
+      virtual size_t readBytes(char* buffer, size_t length)
+      {
+         advance();
+         const size_t count(std::min(length, m_arrived - m_read));
+         memcpy(buffer, m_input.data() + m_read, count);
+         m_read += count;
+         return count;
+      }
+
+      virtual size_t write(uint8_t byte) { return 1; }
+      virtual size_t write(const uint8_t* buffer, size_t size) { return size; }
+
+   private:
+      void advance()
+      {
+         const unsigned long nowUs(micros());
+         while (m_arrived < m_input.size() && nowUs >= m_nextArrivalUs)
+         {
+            const size_t segment(std::min(SEGMENT_SIZE, m_input.size() - m_arrived));
+            if (m_arrived + segment - m_read > m_window)
+            {
+               // Window closed: the sender waits, the next segment is a full segment time away.
+               m_nextArrivalUs = nowUs + m_segmentUs;
+               break;
+            }
+            m_arrived += segment;
+            m_nextArrivalUs += m_segmentUs;
+         }
+      }
+
+      const std::string m_input;
+      size_t m_arrived;
+      size_t m_read;
+      const unsigned long m_segmentUs;
+      const size_t m_window;
+      unsigned long m_nextArrivalUs;
+   };
+
+   //! Flash blocking its writer for the duration of each write.
+   class SlowFlash: public Print
+   {
+   public:
+      SlowFlash(unsigned long bytesPerSecond) : m_bytesPerSecond(bytesPerSecond), m_written(0) {}
+
+      virtual size_t write(uint8_t byte) { return write(&byte, 1); }
+      virtual size_t write(const uint8_t* buffer, size_t size)
+      {
+         std::this_thread::sleep_for(std::chrono::microseconds(FLASH_WRITE_OVERHEAD_US + size * 1000000ULL / m_bytesPerSecond));
+         m_written += size;
+         return size;
+      }
+
+      size_t getWritten() const { return m_written; }
+
+   private:
+      const unsigned long m_bytesPerSecond;
+      size_t m_written;
+   };
+
+   std::string makeRequest(size_t bodySize)
+   {
+      return "POST /update HTTP/1.1\r\nContent-Type: application/octet-stream\r\nContent-Length: " +
+             std::to_string(bodySize) + "\r\n\r\n" + std::string(bodySize, 'x');
+   }
+
+   enum class Mode { DIRECT, BUFFERED, THREADED };
+
+   //! \returns Body KB/s, or 0 on failure.
+   double runUpload(Mode mode, size_t bodySize, unsigned long linkRate, unsigned long flashRate, size_t window)
+   {
+      WindowedLink link(makeRequest(bodySize), SEGMENT_SIZE * 1000000UL / linkRate, window);
+      ArduinoHttpServer::StreamHttpRequest<1> httpRequest(link);
+      SlowFlash flash(flashRate);
+
+      const auto start(std::chrono::steady_clock::now());
+      if (!httpRequest.readRequest())
+      {
+         return 0.0;
+      }
+
+      bool ok(false);
+      switch (mode)
+      {
+         case Mode::DIRECT:
+            ok = httpRequest.streamBody(flash);
+            break;
+
+         case Mode::BUFFERED:
+         {
+            ArduinoHttpServer::DoubleBufferedSink<FLASH_SECTOR_SIZE> sink(flash);
+            ok = httpRequest.streamBody(sink) && sink.finish();
+            break;
+         }
+
+         case Mode::THREADED:
+         {
+            ArduinoHttpServer::DoubleBufferedSink<FLASH_SECTOR_SIZE, ArduinoHttpServer::ThreadDoubleBufferedSink> sink(flash);
+            ok = httpRequest.streamBody(sink) && sink.finish();
+            break;
+         }
+      }
+
+      const double seconds(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      return ok && flash.getWritten() == bodySize ? bodySize / 1024.0 / seconds : 0.0;
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   const size_t bodyKB(argc > 1 ? static_cast<size_t>(atoi(argv[1])) : 128U);
+   const unsigned long linkKBps(argc > 2 ? static_cast<unsigned long>(atol(argv[2])) : 400UL);
+   const unsigned long flashKBps(argc > 3 ? static_cast<unsigned long>(atol(argv[3])) : 300UL);
+   const size_t window(argc > 4 ? static_cast<size_t>(atoi(argv[4])) : DEFAULT_RECEIVE_WINDOW);
+   if (bodyKB == 0U || linkKBps == 0UL || flashKBps == 0UL || window < SEGMENT_SIZE)
+   {
+      fprintf(stderr, "usage: %s [body KB] [link KB/s] [flash KB/s] [window bytes >= %zu]\n", argv[0], SEGMENT_SIZE);
+      return 1;
+   }
+
+   printf("%zu KB body, link %lu KB/s, %zu bytes window, flash %lu KB/s + %lu us per write\n\n",
+          bodyKB, linkKBps, window, flashKBps, FLASH_WRITE_OVERHEAD_US);
+   printf("%-10s %10s\n", "sink", "KB/s");
+
+   static const struct { Mode mode; const char* name; } MODES[] = {
+      { Mode::DIRECT, "direct" }, { Mode::BUFFERED, "buffered" }, { Mode::THREADED, "threaded" } };
+   for (const auto& mode : MODES)
+   {
+      printf("%-10s %10.0f\n", mode.name, runUpload(mode.mode, bodyKB * 1024U, linkKBps * 1024UL, flashKBps * 1024UL, window));
+   }
+
+   return 0;
+}
@@ -0,0 +1,507 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! HTTP load generator reporting throughput and latency percentiles.
+//!
+//! Usage: ahs_load [options] [host:]port
+//!   -c <n>     Concurrent connections (default 16).
+//!   -t <n>     Threads, connections are divided over them (default 1).
+//!   -d <s>     Duration in seconds (default 5).
+//!   -P <n>     Pipelining depth: requests sent ahead per connection (default 1).
+//!   -k         Keep connections alive when the server allows it.
+//!   -f <file>  Request corpus, requests separated by a line containing only "%%".
+//!              Bare "\n" line endings are sent as "\r\n". Default: "GET / HTTP/1.1".
+//!
+//! Latency is measured from handing a request to the kernel until its reply is
+//! complete. Pipelined requests a server does not answer before closing are
+//! counted as "unanswered".
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+struct Options
+{
+   sockaddr_in address;
+   unsigned int connections = 16;
+   unsigned int threads = 1;
+   double durationS = 5.0;
+   unsigned int pipelineDepth = 1;
+   bool keepAlive = false;
+   std::vector<std::string> corpus;
+};
+
+struct Statistics
+{
+   std::vector<uint32_t> latenciesUs;
+   std::map<int, unsigned long> statusCounts;
+   unsigned long connectErrors = 0;
+   unsigned long readErrors = 0;
+   unsigned long parseErrors = 0;
+   unsigned long unanswered = 0;
+   unsigned long connectionsOpened = 0;
+   unsigned long bytesReceived = 0;
+
+   void merge(const Statistics& other)
+   {
+      latenciesUs.insert(latenciesUs.end(), other.latenciesUs.begin(), other.latenciesUs.end());
+      for (const auto& entry : other.statusCounts) { statusCounts[entry.first] += entry.second; }
+      connectErrors += other.connectErrors;
+      readErrors += other.readErrors;
+      parseErrors += other.parseErrors;
+      unanswered += other.unanswered;
+      connectionsOpened += other.connectionsOpened;
+      bytesReceived += other.bytesReceived;
+   }
+};
+
+//! One client connection with its in flight requests.
+struct Connection
+{
+   int socket = -1;
+   size_t nextRequest = 0;                //!< Corpus index of the next request to send.
+   std::deque<Clock::time_point> inFlight; //!< Send times of unanswered requests.
+   std::string output;                    //!< Not yet sent bytes.
+   std::string input;                     //!< Received, not yet parsed bytes.
+   bool serverCloses = false;             //!< Server announced "Connection: close".
+};
+
+//------------------------------------------------------------------------------
+//! \brief Parse one reply at the start of _input_.
+//! \returns Bytes making up the reply, 0 when incomplete, -1 on a parse error.
+//! \param closed Connection closed: a reply without Content-Length is complete.
+long parseReply(const std::string& input, bool closed, int& status, bool& connectionClose)
+{
+   // Skip stray line endings, e.g. trailing "\r\n" after a body.
+   size_t start(input.find_first_not_of("\r\n"));
+   if (start == std::string::npos)
+   {
+      return 0;
+   }
+
+   const size_t headerEnd(input.find("\r\n\r\n", start));
+   if (headerEnd == std::string::npos)
+   {
+      return 0;
+   }
+   if (input.compare(start, 5, "HTTP/") != 0)
+   {
+      return -1;
+   }
+
+   status = atoi(input.c_str() + input.find(' ', start) + 1);
+   connectionClose = false;
+   long contentLength(-1);
+
+   size_t lineStart(input.find("\r\n", start) + 2);
+   while (lineStart < headerEnd)
+   {
+      const size_t lineEnd(input.find("\r\n", lineStart));
+      const std::string line(input, lineStart, lineEnd - lineStart);
+      if (strncasecmp(line.c_str(), "content-length:", 15) == 0)
+      {
+         contentLength = atol(line.c_str() + 15);
+      }
+      else if (strncasecmp(line.c_str(), "connection:", 11) == 0 && strcasestr(line.c_str(), "close"))
+      {
+         connectionClose = true;
+      }
+      lineStart = lineEnd + 2;
+   }
+
+   const size_t bodyStart(headerEnd + 4);
+   if (contentLength < 0)
+   {
+      // Body ends when the connection closes.
+      return closed ? static_cast<long>(input.size()) : 0;
+   }
+   if (input.size() < bodyStart + static_cast<size_t>(contentLength))
+   {
+      return 0;
+   }
+   return static_cast<long>(bodyStart + contentLength);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Runs a share of the connections on its own epoll instance.
+class Worker
+{
+public:
+   Worker(const Options& options, unsigned int connectionCount) :
+      m_options(options),
+      m_connections(connectionCount),
+      m_epoll(epoll_create1(0)),
+      m_statistics()
+   {
+   }
+
+   ~Worker()
+   {
+      for (auto& connection : m_connections) { closeConnection(connection); }
+      ::close(m_epoll);
+   }
+
+   void run(Clock::time_point endTime)
+   {
+      for (size_t i=0; i < m_connections.size(); ++i)
+      {
+         m_connections[i].nextRequest = i % m_options.corpus.size();
+         openConnection(i);
+      }
+
+      epoll_event events[256];
+      while (Clock::now() < endTime)
+      {
+         const int eventCount(epoll_wait(m_epoll, events, 256, 10));
+         for (int i=0; i < eventCount; ++i)
+         {
+            service(events[i].data.u32, events[i].events);
+         }
+      }
+   }
+
+   const Statistics& getStatistics() const { return m_statistics; }
+
+private:
+   void openConnection(size_t index)
+   {
+      Connection& connection(m_connections[index]);
+      closeConnection(connection);
+
+      connection.socket = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+      const int enable(1);
+      ::setsockopt(connection.socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+      if (::connect(connection.socket, reinterpret_cast<const sockaddr*>(&m_options.address), sizeof(m_options.address)) != 0 &&
+          errno != EINPROGRESS)
+      {
+         ++m_statistics.connectErrors;
+         closeConnection(connection);
+         return;
+      }
+      ++m_statistics.connectionsOpened;
+      connection.serverCloses = false;
+
+      epoll_event event;
+      event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+      event.data.u32 = static_cast<uint32_t>(index);
+      ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, connection.socket, &event);
+
+      fillPipeline(connection);
+      // Usually fails with EAGAIN until connected, which is signalled by EPOLLOUT.
+      sendOutput(index);
+   }
+
+   void closeConnection(Connection& connection)
+   {
+      if (connection.socket >= 0)
+      {
+         ::close(connection.socket);
+         connection.socket = -1;
+      }
+      connection.inFlight.clear();
+      connection.output.clear();
+      connection.input.clear();
+   }
+
+   //! Queue requests until the pipelining depth is reached.
+   void fillPipeline(Connection& connection)
+   {
+      while (connection.inFlight.size() < m_options.pipelineDepth && !connection.serverCloses)
+      {
+         connection.output += m_options.corpus[connection.nextRequest];
+         connection.nextRequest = (connection.nextRequest + 1) % m_options.corpus.size();
+         connection.inFlight.push_back(Clock::now());
+
+         if (!m_options.keepAlive)
+         {
+            break;
+         }
+      }
+   }
+
+   void service(size_t index, uint32_t events)
+   {
+      Connection& connection(m_connections[index]);
+      if (connection.socket < 0)
+      {
+         return;
+      }
+
+      if ((events & EPOLLOUT) && !sendOutput(index))
+      {
+         return;
+      }
+
+      bool closed(false);
+      if (events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+      {
+         char buffer[16384];
+         while (true)
+         {
+            const ssize_t received(::recv(connection.socket, buffer, sizeof(buffer), 0));
+            if (received > 0)
+            {
+               connection.input.append(buffer, static_cast<size_t>(received));
+               m_statistics.bytesReceived += static_cast<size_t>(received);
+            }
+            else if (received == 0)
+            {
+               closed = true;
+               break;
+            }
+            else if (errno == EAGAIN)
+            {
+               break;
+            }
+            else
+            {
+               if (connection.inFlight.empty()) { closed = true; }
+               else { failConnection(index, m_statistics.readErrors); return; }
+               break;
+            }
+         }
+      }
+
+      // Complete as many replies as possible.
+      while (!connection.inFlight.empty())
+      {
+         int status(0);
+         bool connectionClose(false);
+         const long replySize(parseReply(connection.input, closed, status, connectionClose));
+         if (replySize < 0)
+         {
+            failConnection(index, m_statistics.parseErrors);
+            return;
+         }
+         if (replySize == 0)
+         {
+            break;
+         }
+
+         const auto latency(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - connection.inFlight.front()));
+         m_statistics.latenciesUs.push_back(static_cast<uint32_t>(latency.count()));
+         ++m_statistics.statusCounts[status];
+         connection.inFlight.pop_front();
+         connection.input.erase(0, static_cast<size_t>(replySize));
+         connection.serverCloses = connection.serverCloses || connectionClose || !m_options.keepAlive;
+      }
+
+      if (closed || (connection.serverCloses && connection.inFlight.empty()))
+      {
+         if (closed && !connection.inFlight.empty())
+         {
+            m_statistics.unanswered += connection.inFlight.size();
+         }
+         openConnection(index);
+         return;
+      }
+
+      if (!connection.serverCloses)
+      {
+         fillPipeline(connection);
+         sendOutput(index);
+      }
+   }
+
+   //! Send queued requests without blocking.
+   //! \returns False when the connection failed and was reopened.
+   bool sendOutput(size_t index)
+   {
+      Connection& connection(m_connections[index]);
+      while (!connection.output.empty() && connection.socket >= 0)
+      {
+         const ssize_t sent(::send(connection.socket, connection.output.data(), connection.output.size(), MSG_NOSIGNAL));
+         if (sent > 0)
+         {
+            connection.output.erase(0, static_cast<size_t>(sent));
+         }
+         else if (sent < 0 && (errno == EAGAIN || errno == ENOTCONN))
+         {
+            break;
+         }
+         else
+         {
+            failConnection(index, m_statistics.connectErrors);
+            return false;
+         }
+      }
+      return true;
+   }
+
+   void failConnection(size_t index, unsigned long& counter)
+   {
+      ++counter;
+      openConnection(index);
+   }
+
+   const Options& m_options;
+   std::vector<Connection> m_connections;
+   int m_epoll;
+   Statistics m_statistics;
+};
+
+std::vector<std::string> loadCorpus(const char* pFileName)
+{
+   std::ifstream file(pFileName);
+   if (!file)
+   {
+      fprintf(stderr, "Cannot open corpus %s\n", pFileName);
+      exit(1);
+   }
+
+   std::vector<std::string> corpus;
+   std::string request;
+   std::string line;
+   while (std::getline(file, line))
+   {
+      if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+      if (line == "%%")
+      {
+         if (!request.empty()) { corpus.push_back(request); }
+         request.clear();
+         continue;
+      }
+      request += line + "\r\n";
+   }
+   if (!request.empty()) { corpus.push_back(request); }
+
+   // The empty line ending a header without body is easily lost at the end of a block.
+   for (auto& entry : corpus)
+   {
+      if (entry.find("\r\n\r\n") == std::string::npos) { entry += "\r\n"; }
+   }
+   return corpus;
+}
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, double fraction)
+{
+   if (sorted.empty()) { return 0; }
+   size_t index(static_cast<size_t>(fraction * sorted.size()));
+   return sorted[index < sorted.size() ? index : sorted.size() - 1];
+}
+
+void usage()
+{
+   fprintf(stderr, "Usage: ahs_load [-c connections] [-t threads] [-d seconds] [-P pipeline depth] [-k] [-f corpus] [host:]port\n");
+   exit(1);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+   Options options;
+   int opt;
+   while ((opt = getopt(argc, argv, "c:t:d:P:kf:")) != -1)
+   {
+      switch (opt)
+      {
+         case 'c': options.connections = static_cast<unsigned int>(atoi(optarg)); break;
+         case 't': options.threads = static_cast<unsigned int>(atoi(optarg)); break;
+         case 'd': options.durationS = atof(optarg); break;
+         case 'P': options.pipelineDepth = static_cast<unsigned int>(atoi(optarg)); break;
+         case 'k': options.keepAlive = true; break;
+         case 'f': options.corpus = loadCorpus(optarg); break;
+         default: usage();
+      }
+   }
+   if (optind >= argc || options.connections == 0 || options.threads == 0 || options.pipelineDepth == 0)
+   {
+      usage();
+   }
+
+   std::string target(argv[optind]);
+   std::string host("127.0.0.1");
+   const size_t colon(target.rfind(':'));
+   if (colon != std::string::npos)
+   {
+      host = target.substr(0, colon);
+      target = target.substr(colon + 1);
+   }
+
+   addrinfo hints;
+   memset(&hints, 0, sizeof(hints));
+   hints.ai_family = AF_INET;
+   hints.ai_socktype = SOCK_STREAM;
+   addrinfo* pResult(0);
+   if (getaddrinfo(host.c_str(), target.c_str(), &hints, &pResult) != 0)
+   {
+      fprintf(stderr, "Cannot resolve %s\n", argv[optind]);
+      return 1;
+   }
+   memcpy(&options.address, pResult->ai_addr, sizeof(options.address));
+   freeaddrinfo(pResult);
+
+   if (options.corpus.empty())
+   {
+      options.corpus.push_back("GET / HTTP/1.1\r\nHost: " + host + "\r\n\r\n");
+   }
+   if (options.threads > options.connections)
+   {
+      options.threads = options.connections;
+   }
+
+   std::vector<std::unique_ptr<Worker>> workers;
+   for (unsigned int i=0; i < options.threads; ++i)
+   {
+      const unsigned int share(options.connections / options.threads + (i < options.connections % options.threads ? 1 : 0));
+      workers.emplace_back(new Worker(options, share));
+   }
+
+   const auto start(Clock::now());
+   const auto endTime(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.durationS)));
+   std::vector<std::thread> threads;
+   for (auto& worker : workers)
+   {
+      Worker* pWorker(worker.get());
+      threads.emplace_back([pWorker, endTime]() { pWorker->run(endTime); });
+   }
+   for (auto& thread : threads) { thread.join(); }
+   const double elapsed(std::chrono::duration<double>(Clock::now() - start).count());
+
+   Statistics total;
+   for (auto& worker : workers) { total.merge(worker->getStatistics()); }
+   std::sort(total.latenciesUs.begin(), total.latenciesUs.end());
+
+   printf("%zu requests in %.2fs, %lu connections opened, %.1f KiB received\n",
+          total.latenciesUs.size(), elapsed, total.connectionsOpened, total.bytesReceived / 1024.0);
+   printf("Requests/s: %.1f\n", total.latenciesUs.size() / elapsed);
+   printf("Latency [us]: p50 %u  p90 %u  p99 %u  p999 %u  max %u\n",
+          percentile(total.latenciesUs, 0.50), percentile(total.latenciesUs, 0.90),
+          percentile(total.latenciesUs, 0.99), percentile(total.latenciesUs, 0.999),
+          total.latenciesUs.empty() ? 0 : total.latenciesUs.back());
+   printf("Status:");
+   for (const auto& entry : total.statusCounts) { printf("  %d: %lu", entry.first, entry.second); }
+   printf("\nErrors: connect %lu  read %lu  parse %lu  unanswered %lu\n",
+          total.connectErrors, total.readErrors, total.parseErrors, total.unanswered);
+
+   return (total.connectErrors + total.readErrors + total.parseErrors) > 0 ? 2 : 0;
+}
@@ -0,0 +1,120 @@
+//
+//! \file
+//  ArduinoHttpServer host build
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! ahs_replay: feeds connections captured by RecordingStream back into StreamHttpRequest.
+//! Usage: ahs_replay [-o corpus] capture
+//!   -o <file>  Also write the requests as an ahs_load corpus.
+//!
+//! Runs on the virtual clock, so slow clients replay instantly while the
+//! reported times are those the device would see. "added" is the time from the
+//! last record until readRequest() returned.
+
+#include <ArduinoHttpServer.h>
+
+#include "ReplayStream.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+   void usage()
+   {
+      fprintf(stderr, "Usage: ahs_replay [-o corpus] capture\n");
+      exit(1);
+   }
+}
+
+int main(int argc, char** argv)
+{
+   const char* pCorpusFileName(0);
+   int opt;
+   while ((opt = getopt(argc, argv, "o:")) != -1)
+   {
+      switch (opt)
+      {
+         case 'o': pCorpusFileName = optarg; break;
+         default: usage();
+      }
+   }
+   if (optind >= argc)
+   {
+      usage();
+   }
+
+   std::string capture;
+   if (!ArduinoHttpServer::ReplayStream::readCapture(argv[optind], capture))
+   {
+      fprintf(stderr, "Cannot read capture %s\n", argv[optind]);
+      return 1;
+   }
+
+   bool complete(false);
+   const std::vector<ArduinoHttpServer::ReplayStream::Connection> connections(ArduinoHttpServer::ReplayStream::parseCapture(capture, complete));
+   if (!complete)
+   {
+      fprintf(stderr, "Capture is truncated or malformed, replaying the first %zu connections\n", connections.size());
+   }
+
+   std::ofstream corpus;
+   if (pCorpusFileName != 0)
+   {
+      corpus.open(pCorpusFileName, std::ios::binary);
+      if (!corpus)
+      {
+         fprintf(stderr, "Cannot write corpus %s\n", pCorpusFileName);
+         return 1;
+      }
+   }
+
+   ArduinoHost::useVirtualClock(true, 10UL);
+
+   printf("%5s %10s %7s %8s %10s %10s  %s\n", "conn", "start ms", "records", "bytes", "span us", "added us", "request");
+   for (size_t i=0; i < connections.size(); ++i)
+   {
+      const ArduinoHttpServer::ReplayStream::Connection& connection(connections[i]);
+      const std::string data(connection.getData());
+
+      const unsigned long startUs(micros());
+      ArduinoHttpServer::ReplayStream stream(connection, startUs);
+      ArduinoHttpServer::StreamHttpRequest<1024> httpRequest(stream);
+      const bool ok(httpRequest.readRequest());
+      const unsigned long doneUs(micros());
+      const unsigned long spanUs(stream.getLastArrivalUs() - startUs);
+
+      String description;
+      if (ok)
+      {
+         description = httpRequest.getResource().toString();
+      }
+      else
+      {
+         description = httpRequest.getErrorStatusCode();
+         description += " ";
+         description += httpRequest.getError().toString();
+      }
+
+      printf("%5zu %10lu %7zu %8zu %10lu %10lu  %s\n", i, connection.startMs, connection.records.size(), data.size(),
+             spanUs, doneUs > stream.getLastArrivalUs() ? doneUs - stream.getLastArrivalUs() : 0UL, description.c_str());
+
+      if (corpus.is_open() && !data.empty())
+      {
+         corpus << (i > 0 ? "%%\n" : "") << data;
+         if (data.back() != '\n')
+         {
+            corpus << "\n";
+         }
+      }
+   }
+
+   return 0;
+}
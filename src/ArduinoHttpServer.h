@@ -9,3 +9,15 @@
 
 #include "internals/StreamHttpRequest.hpp"
 #include "internals/StreamHttpReply.hpp"
+#include "internals/HttpMetrics.hpp"
+#include "internals/HttpTrace.hpp"
+#include "internals/RecordingStream.hpp"
+#include "internals/StreamWebSocket.hpp"
+#include "internals/StreamHttpEventReply.hpp"
+#include "internals/JsonTokenizer.hpp"
+#include "internals/JsonWriter.hpp"
+#include "internals/MultipartParser.hpp"
+#include "internals/DoubleBufferedSink.hpp"
+#include "internals/UrlEncodedForm.hpp"
+#include "internals/TemplateRenderer.hpp"
+#include "internals/DeflateWriter.hpp"
@@ -8,6 +8,7 @@
 //! Debug support
 
 #ifdef ARDUINO_HTTP_SERVER_DEBUG
+   #include <Arduino.h> // Serial; not all sources include Arduino.h themselves.
    #define DEBUG_ARDUINO_HTTP_SERVER_PRINT(...) Serial.print(__VA_ARGS__)
    #define DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(...) Serial.println(__VA_ARGS__)
 #else
@@ -15,6 +16,14 @@
    #define DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(...)
 #endif
 
+//! Record an event in the RAM trace buffer. Cheap enough to leave enabled in production.
+#ifdef ARDUINO_HTTP_SERVER_TRACE
+   #include "HttpTrace.hpp"
+   #define AHS_TRACE(event, arg) ArduinoHttpServer::HttpTrace::record(ArduinoHttpServer::HttpTrace::Event::event, static_cast<long>(arg))
+#else
+   #define AHS_TRACE(event, arg)
+#endif
+
 
 #ifdef ARDUINO_HTTP_SERVER_NO_FLASH
    #define AHS_F(x) (x)
@@ -0,0 +1,465 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming deflate compression (RFC 1951) in gzip or zlib format.
+
+#include "DeflateWriter.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+#include <stdlib.h>
+#include <strings.h>
+
+namespace
+{
+   const size_t MIN_MATCH = 3U;
+   const size_t MAX_MATCH = 258U;
+   const uint16_t END_OF_BLOCK = 256U;
+
+   //! Shortest length (RFC 1951 3.2.5) per length code 257..285, and its extra bits.
+   const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+   const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+   const uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                        8193, 12289, 16385, 24577 };
+   const uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+   //! CRC-32 of each nibble value, polynomial 0xEDB88320.
+   const uint32_t CRC_TABLE[16] = { 0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+                                    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+                                    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+                                    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C };
+
+   uint32_t updateCrc(uint32_t crc, const uint8_t* data, size_t length)
+   {
+      crc = ~crc;
+      for (size_t i=0; i < length; ++i)
+      {
+         crc ^= data[i];
+         crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+         crc = (crc >> 4) ^ CRC_TABLE[crc & 0x0F];
+      }
+      return ~crc;
+   }
+
+   uint32_t updateAdler(uint32_t adler, const uint8_t* data, size_t length)
+   {
+      static const uint32_t MODULUS = 65521UL;
+      static const size_t MAX_RUN = 5552U; //!< Sums cannot overflow 32 bits within this many bytes.
+
+      uint32_t a(adler & 0xFFFFUL);
+      uint32_t b(adler >> 16);
+      while (length > 0)
+      {
+         const size_t run(length < MAX_RUN ? length : MAX_RUN);
+         for (size_t i=0; i < run; ++i)
+         {
+            a += data[i];
+            b += a;
+         }
+         a %= MODULUS;
+         b %= MODULUS;
+         data += run;
+         length -= run;
+      }
+      return (b << 16) | a;
+   }
+
+   //! Huffman codes are sent most significant bit first, everything else least significant bit first.
+   uint16_t reverseBits(uint16_t code, uint8_t length)
+   {
+      uint16_t reversed(0);
+      for (uint8_t i=0; i < length; ++i)
+      {
+         reversed = static_cast<uint16_t>((reversed << 1) | (code & 1U));
+         code >>= 1;
+      }
+      return reversed;
+   }
+
+   //! \returns Whether coding _name_ is accepted, listed by name or as "*"
+   //!    without a zero q-value.
+   bool accepts(const char* acceptEncoding, const char* name)
+   {
+      const size_t nameLength(strlen(name));
+      const char* p(acceptEncoding);
+      while (*p)
+      {
+         while (*p == ' ' || *p == ',') { ++p; }
+
+         const char* const pCoding(p);
+         while (*p && *p != ',' && *p != ';' && *p != ' ') { ++p; }
+         const size_t codingLength(p - pCoding);
+         const bool match((codingLength == nameLength && strncasecmp(pCoding, name, nameLength) == 0) ||
+                          (codingLength == 1U && *pCoding == '*'));
+
+         bool rejected(false);
+         for (; *p && *p != ','; ++p)
+         {
+            if ((*p == 'q' || *p == 'Q') && p[1] == '=')
+            {
+               rejected = strtod(p + 2, 0) <= 0.0;
+            }
+         }
+
+         if (match)
+         {
+            return !rejected;
+         }
+      }
+      return false;
+   }
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::AbstractDeflateWriter::AbstractDeflateWriter(Print& out, Format format, uint8_t* pWindow, size_t windowSize, uint16_t* pHead, uint16_t* pPrev) :
+   m_out(out),
+   m_format(format),
+   m_pWindow(pWindow),
+   m_windowSize(windowSize),
+   m_windowLength(0),
+   m_position(0),
+   m_pHead(pHead),
+   m_pPrev(pPrev),
+   m_bitBuffer(0),
+   m_bitCount(0),
+   m_output{0},
+   m_outputLength(0),
+   m_checksum(format == Format::DEFLATE ? 1UL : 0UL),
+   m_inputLength(0),
+   m_outputTotal(0),
+   m_started(false),
+   m_failed(false)
+{
+   memset(m_pHead, 0, HASH_SIZE * sizeof(uint16_t));
+   memset(m_pPrev, 0, m_windowSize * sizeof(uint16_t));
+}
+
+//------------------------------------------------------------------------------
+//! \brief Pick the format for a request's Accept-Encoding field: gzip, else
+//!    deflate, else none.
+ArduinoHttpServer::AbstractDeflateWriter::Format ArduinoHttpServer::AbstractDeflateWriter::selectFormat(const String& acceptEncoding)
+{
+   if (accepts(acceptEncoding.c_str(), "gzip"))
+   {
+      return Format::GZIP;
+   }
+   if (accepts(acceptEncoding.c_str(), "deflate"))
+   {
+      return Format::DEFLATE;
+   }
+   return Format::IDENTITY;
+}
+
+const char* ArduinoHttpServer::AbstractDeflateWriter::getContentEncoding() const
+{
+   switch (m_format)
+   {
+      case Format::GZIP: return "gzip";
+      case Format::DEFLATE: return "deflate";
+      default: return 0;
+   }
+}
+
+size_t ArduinoHttpServer::AbstractDeflateWriter::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Add _buffer_ to the lookahead, compressing whenever the window is full.
+//! \returns _size_, or 0 once the output failed.
+size_t ArduinoHttpServer::AbstractDeflateWriter::write(const uint8_t* buffer, size_t size)
+{
+   if (m_format == Format::IDENTITY)
+   {
+      m_inputLength += size;
+      const size_t written(m_out.write(buffer, size));
+      m_outputTotal += written;
+      return written;
+   }
+   if (m_failed)
+   {
+      return 0;
+   }
+
+   start();
+   m_checksum = m_format == Format::GZIP ? updateCrc(m_checksum, buffer, size) : updateAdler(m_checksum, buffer, size);
+   m_inputLength += size;
+
+   size_t remaining(size);
+   while (remaining > 0)
+   {
+      const size_t space(2U * m_windowSize - m_windowLength);
+      const size_t part(remaining < space ? remaining : space);
+      memcpy(m_pWindow + m_windowLength, buffer, part);
+      m_windowLength += part;
+      buffer += part;
+      remaining -= part;
+
+      if (m_windowLength == 2U * m_windowSize)
+      {
+         compress(false);
+         slide();
+      }
+   }
+   return m_failed ? 0U : size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compress the rest, end the block and write the trailer.
+//! \details Call once, after the last write. Does not end the reply.
+//! \returns False when the output did not accept everything.
+bool ArduinoHttpServer::AbstractDeflateWriter::finish()
+{
+   if (m_format == Format::IDENTITY)
+   {
+      return m_outputTotal == m_inputLength;
+   }
+
+   start();
+   compress(true);
+   writeCode(reverseBits(END_OF_BLOCK - 256U, 7), 7);
+   if (m_bitCount > 0)
+   {
+      writeBits(0, static_cast<uint8_t>(8U - m_bitCount));
+   }
+
+   if (m_format == Format::GZIP)
+   {
+      for (uint8_t shift=0; shift < 32; shift += 8) { writeByte(static_cast<uint8_t>(m_checksum >> shift)); }
+      for (uint8_t shift=0; shift < 32; shift += 8) { writeByte(static_cast<uint8_t>(m_inputLength >> shift)); }
+   }
+   else
+   {
+      for (int shift=24; shift >= 0; shift -= 8) { writeByte(static_cast<uint8_t>(m_checksum >> shift)); }
+   }
+
+   flushOutput();
+   return !m_failed;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write the gzip or zlib header and the header of the only block.
+void ArduinoHttpServer::AbstractDeflateWriter::start()
+{
+   if (m_started)
+   {
+      return;
+   }
+   m_started = true;
+
+   if (m_format == Format::GZIP)
+   {
+      // Magic, deflate, no flags, no time, no extra flags, unknown OS.
+      static const uint8_t GZIP_HEADER[10] = { 0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF };
+      for (const uint8_t value : GZIP_HEADER) { writeByte(value); }
+   }
+   else
+   {
+      // Deflate with the window size as log2 - 8, check bits making the pair a multiple of 31.
+      uint8_t windowBits(8);
+      while ((1UL << windowBits) < m_windowSize) { ++windowBits; }
+      const uint8_t cmf(static_cast<uint8_t>(((windowBits - 8U) << 4) | 8U));
+      writeByte(cmf);
+      writeByte(static_cast<uint8_t>(31U - (cmf * 256U) % 31U));
+   }
+
+   // Final block, fixed Huffman codes.
+   writeBits(1, 1);
+   writeBits(1, 2);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Encode the window from m_position on, keeping MAX_MATCH bytes of
+//!    lookahead unless _all_.
+void ArduinoHttpServer::AbstractDeflateWriter::compress(bool all)
+{
+   const size_t end(all ? m_windowLength : (m_windowLength > MAX_MATCH ? m_windowLength - MAX_MATCH : 0U));
+   while (m_position < end)
+   {
+      const size_t available(m_windowLength - m_position);
+      size_t distance(0);
+      const size_t length(available >= MIN_MATCH ? findMatch(available < MAX_MATCH ? available : MAX_MATCH, distance) : 0U);
+
+      if (length >= MIN_MATCH)
+      {
+         writeMatch(length, distance);
+         for (size_t i=0; i < length; ++i)
+         {
+            insertHash(m_position++);
+         }
+      }
+      else
+      {
+         writeLiteral(m_pWindow[m_position]);
+         insertHash(m_position++);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Drop the older half of the window.
+void ArduinoHttpServer::AbstractDeflateWriter::slide()
+{
+   memmove(m_pWindow, m_pWindow + m_windowSize, m_windowSize);
+   m_windowLength -= m_windowSize;
+   m_position -= m_windowSize;
+
+   const uint16_t shift(static_cast<uint16_t>(m_windowSize));
+   for (size_t i=0; i < HASH_SIZE; ++i)
+   {
+      m_pHead[i] = m_pHead[i] > shift ? m_pHead[i] - shift : 0U;
+   }
+   for (size_t i=0; i < m_windowSize; ++i)
+   {
+      m_pPrev[i] = m_pPrev[i] > shift ? m_pPrev[i] - shift : 0U;
+   }
+}
+
+void ArduinoHttpServer::AbstractDeflateWriter::insertHash(size_t position)
+{
+   if (position + MIN_MATCH > m_windowLength)
+   {
+      return;
+   }
+
+   const uint8_t* const p(m_pWindow + position);
+   const size_t hash(((p[0] << 6) ^ (p[1] << 3) ^ p[2]) & (HASH_SIZE - 1U));
+   m_pPrev[position & (m_windowSize - 1U)] = m_pHead[hash];
+   m_pHead[hash] = static_cast<uint16_t>(position + 1U);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Longest earlier occurrence of the bytes at m_position, at most
+//!    a window back.
+//! \returns Its length, below MIN_MATCH for none.
+size_t ArduinoHttpServer::AbstractDeflateWriter::findMatch(size_t maxLength, size_t& distance) const
+{
+   const uint8_t* const pCurrent(m_pWindow + m_position);
+   const size_t hash(((pCurrent[0] << 6) ^ (pCurrent[1] << 3) ^ pCurrent[2]) & (HASH_SIZE - 1U));
+
+   size_t bestLength(0);
+   size_t candidate(m_pHead[hash]);
+   for (uint8_t chain=0; chain < MAX_CHAIN && candidate > 0; ++chain)
+   {
+      const size_t position(candidate - 1U);
+      if (position >= m_position || m_position - position > m_windowSize)
+      {
+         break;
+      }
+
+      const uint8_t* const pCandidate(m_pWindow + position);
+      if (pCandidate[bestLength] == pCurrent[bestLength])
+      {
+         size_t length(0);
+         while (length < maxLength && pCandidate[length] == pCurrent[length])
+         {
+            ++length;
+         }
+         if (length > bestLength)
+         {
+            bestLength = length;
+            distance = m_position - position;
+            if (length == maxLength)
+            {
+               break;
+            }
+         }
+      }
+
+      const size_t previous(m_pPrev[position & (m_windowSize - 1U)]);
+      if (previous >= candidate)
+      {
+         break; // Overwritten by a newer position.
+      }
+      candidate = previous;
+   }
+   return bestLength;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Fixed literal codes: 0..143 in 8 bits from 0x30, 144..255 in 9 bits from 0x190.
+void ArduinoHttpServer::AbstractDeflateWriter::writeLiteral(uint8_t value)
+{
+   if (value < 144U)
+   {
+      writeCode(static_cast<uint16_t>(0x30U + value), 8);
+   }
+   else
+   {
+      writeCode(static_cast<uint16_t>(0x190U + value - 144U), 9);
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Fixed length codes: 256..279 in 7 bits from 0, 280..287 in 8 bits
+//!    from 0xC0; then 5 bit distance codes.
+void ArduinoHttpServer::AbstractDeflateWriter::writeMatch(size_t length, size_t distance)
+{
+   uint8_t lengthIndex(28);
+   while (LENGTH_BASE[lengthIndex] > length) { --lengthIndex; }
+   const uint16_t symbol(static_cast<uint16_t>(257U + lengthIndex));
+   if (symbol < 280U)
+   {
+      writeCode(static_cast<uint16_t>(symbol - 256U), 7);
+   }
+   else
+   {
+      writeCode(static_cast<uint16_t>(0xC0U + symbol - 280U), 8);
+   }
+   writeBits(length - LENGTH_BASE[lengthIndex], LENGTH_EXTRA[lengthIndex]);
+
+   uint8_t distanceIndex(29);
+   while (DISTANCE_BASE[distanceIndex] > distance) { --distanceIndex; }
+   writeCode(distanceIndex, 5);
+   writeBits(distance - DISTANCE_BASE[distanceIndex], DISTANCE_EXTRA[distanceIndex]);
+}
+
+void ArduinoHttpServer::AbstractDeflateWriter::writeCode(uint16_t code, uint8_t length)
+{
+   writeBits(reverseBits(code, length), length);
+}
+
+void ArduinoHttpServer::AbstractDeflateWriter::writeBits(uint32_t value, uint8_t count)
+{
+   m_bitBuffer |= value << m_bitCount;
+   m_bitCount = static_cast<uint8_t>(m_bitCount + count);
+   while (m_bitCount >= 8U)
+   {
+      writeByte(static_cast<uint8_t>(m_bitBuffer));
+      m_bitBuffer >>= 8;
+      m_bitCount = static_cast<uint8_t>(m_bitCount - 8U);
+   }
+}
+
+void ArduinoHttpServer::AbstractDeflateWriter::writeByte(uint8_t value)
+{
+   m_output[m_outputLength++] = value;
+   if (m_outputLength == OUTPUT_BUFFER_SIZE)
+   {
+      flushOutput();
+   }
+}
+
+void ArduinoHttpServer::AbstractDeflateWriter::flushOutput()
+{
+   if (m_outputLength > 0 && !m_failed)
+   {
+      if (m_out.write(m_output, m_outputLength) != m_outputLength)
+      {
+         DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("Compressed output failed.");
+         m_failed = true;
+      }
+      m_outputTotal += m_outputLength;
+   }
+   m_outputLength = 0;
+}
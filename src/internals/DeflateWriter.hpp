@@ -0,0 +1,127 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming deflate compression (RFC 1951) in gzip or zlib format.
+
+#ifndef __ArduinoHttpServer__DeflateWriter__
+#define __ArduinoHttpServer__DeflateWriter__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Compresses what is written to it and writes the result to a Print,
+//! typically a StreamHttpChunkedReply.
+//! \details LZ77 over a window of a few KB with hash chains, encoded with the
+//!    fixed Huffman codes of deflate: no trees to build or store, which keeps
+//!    both RAM and CPU use low while still removing most of the repetition in
+//!    JSON and HTML. The output is a single deflate block wrapped in gzip
+//!    (Content-Encoding: gzip) or zlib (Content-Encoding: deflate) format.
+//!    With Format::IDENTITY everything is passed on as it is, so handlers can
+//!    write through the writer whatever the client accepts.
+class AbstractDeflateWriter: public Print
+{
+
+public:
+   enum class Format : char
+   {
+      IDENTITY,
+      DEFLATE,
+      GZIP
+   };
+
+   static const size_t OUTPUT_BUFFER_SIZE = 128U; //!< Compressed bytes collected per write to the output.
+   static const uint8_t MAX_CHAIN = 8U; //!< Match candidates tried per position.
+
+   static Format selectFormat(const String& acceptEncoding);
+
+   // Print interface.
+   using Print::write;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+
+   bool finish();
+
+   inline Format getFormat() const { return m_format; };
+   //! Value for the Content-Encoding field, 0 for Format::IDENTITY.
+   const char* getContentEncoding() const;
+   inline uint32_t getInputLength() const { return m_inputLength; };
+   inline uint32_t getOutputLength() const { return m_outputTotal; };
+
+protected:
+   //! _pWindow_ holds 2 * _windowSize_ bytes, _pPrev_ _windowSize_ and
+   //! _pHead_ HASH_SIZE entries. _windowSize_ is a power of 2 from 512 to 16384.
+   AbstractDeflateWriter(Print& out, Format format, uint8_t* pWindow, size_t windowSize, uint16_t* pHead, uint16_t* pPrev);
+
+   static const size_t HASH_SIZE = 512U;
+
+private:
+   void start();
+   void compress(bool all);
+   void slide();
+   void insertHash(size_t position);
+   size_t findMatch(size_t maxLength, size_t& distance) const;
+   void writeLiteral(uint8_t value);
+   void writeMatch(size_t length, size_t distance);
+   void writeCode(uint16_t code, uint8_t length);
+   void writeBits(uint32_t value, uint8_t count);
+   void writeByte(uint8_t value);
+   void flushOutput();
+
+   Print& m_out;
+   const Format m_format;
+
+   uint8_t* const m_pWindow;
+   const size_t m_windowSize;
+   size_t m_windowLength; //!< Bytes in the window: history and lookahead.
+   size_t m_position; //!< Next byte to encode.
+   uint16_t* const m_pHead; //!< Latest position + 1 per hash, 0 for none.
+   uint16_t* const m_pPrev; //!< Previous position + 1 with the same hash.
+
+   uint32_t m_bitBuffer;
+   uint8_t m_bitCount;
+   uint8_t m_output[OUTPUT_BUFFER_SIZE];
+   size_t m_outputLength;
+
+   uint32_t m_checksum; //!< CRC-32 for gzip, Adler-32 for zlib.
+   uint32_t m_inputLength;
+   uint32_t m_outputTotal;
+   bool m_started;
+   bool m_failed;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Deflate writer with a WINDOW_SIZE bytes window; RAM use is about
+//! 4 * WINDOW_SIZE + 1200 bytes.
+template <size_t WINDOW_SIZE = 1024>
+class DeflateWriter: public AbstractDeflateWriter
+{
+   static_assert(WINDOW_SIZE >= 512U && WINDOW_SIZE <= 16384U && (WINDOW_SIZE & (WINDOW_SIZE - 1U)) == 0U,
+                 "WINDOW_SIZE must be a power of 2 from 512 to 16384");
+
+public:
+   DeflateWriter(Print& out, Format format) :
+      AbstractDeflateWriter(out, format, m_window, WINDOW_SIZE, m_head, m_prev) {};
+   //! Compress as the client's Accept-Encoding field allows.
+   DeflateWriter(Print& out, const String& acceptEncoding) :
+      AbstractDeflateWriter(out, selectFormat(acceptEncoding), m_window, WINDOW_SIZE, m_head, m_prev) {};
+
+private:
+   uint8_t m_window[2 * WINDOW_SIZE];
+   uint16_t m_head[HASH_SIZE];
+   uint16_t m_prev[WINDOW_SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__DeflateWriter__
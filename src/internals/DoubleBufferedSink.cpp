@@ -0,0 +1,175 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Double buffered Print, draining one buffer while the other fills.
+
+#include "DoubleBufferedSink.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::AbstractDoubleBufferedSink::AbstractDoubleBufferedSink(Print& out, char* pBuffers, size_t bufferSize) :
+   m_out(out),
+   m_pBuffers(pBuffers),
+   m_bufferSize(bufferSize),
+   m_pFill(pBuffers),
+   m_fillLength(0),
+   m_pDrain(0),
+   m_drainLength(0),
+   m_drainFailed(false),
+   m_failed(false),
+   m_waitUs(0)
+{
+}
+
+size_t ArduinoHttpServer::AbstractDoubleBufferedSink::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Copy _buffer_ into the fill buffer, handing it over when full.
+//! \returns _size_, or 0 once the output failed so writers stop early.
+size_t ArduinoHttpServer::AbstractDoubleBufferedSink::write(const uint8_t* buffer, size_t size)
+{
+   size_t remaining(size);
+   while (remaining > 0 && !m_failed)
+   {
+      const size_t space(m_bufferSize - m_fillLength);
+      const size_t part(remaining < space ? remaining : space);
+      memcpy(m_pFill + m_fillLength, buffer, part);
+      m_fillLength += part;
+      buffer += part;
+      remaining -= part;
+
+      if (m_fillLength == m_bufferSize)
+      {
+         handOver();
+      }
+   }
+   return m_failed ? 0U : size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write everything collected to the output and wait for it.
+//! \details Does not flush the output itself.
+void ArduinoHttpServer::AbstractDoubleBufferedSink::flush()
+{
+   if (m_fillLength > 0 && !m_failed)
+   {
+      handOver();
+   }
+   waitDrained();
+   m_failed = m_failed || m_drainFailed;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Flush at the end of the body.
+//! \returns True when the output accepted everything written.
+bool ArduinoHttpServer::AbstractDoubleBufferedSink::finish()
+{
+   flush();
+   return !m_failed;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write the buffer handed over to the output; runs in the drain's context.
+void ArduinoHttpServer::AbstractDoubleBufferedSink::drain()
+{
+   if (m_out.write(reinterpret_cast<const uint8_t*>(m_pDrain), m_drainLength) != m_drainLength)
+   {
+      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("Sink output failed.");
+      m_drainFailed = true;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Once the previous drain completed, drain the fill buffer and fill
+//!    the other one.
+void ArduinoHttpServer::AbstractDoubleBufferedSink::handOver()
+{
+   const unsigned long startUs(micros());
+   waitDrained();
+   m_waitUs += micros() - startUs;
+
+   if (m_drainFailed)
+   {
+      m_failed = true;
+      return;
+   }
+
+   m_pDrain = m_pFill;
+   m_drainLength = m_fillLength;
+   m_pFill = (m_pFill == m_pBuffers) ? m_pBuffers + m_bufferSize : m_pBuffers;
+   m_fillLength = 0;
+   startDrain();
+}
+
+#if defined(ESP32)
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::TaskDoubleBufferedSink::TaskDoubleBufferedSink(Print& out, char* pBuffers, size_t bufferSize) :
+   AbstractDoubleBufferedSink(out, pBuffers, bufferSize),
+   m_full(xSemaphoreCreateBinary()),
+   m_idle(xSemaphoreCreateBinary()),
+   m_task(0),
+   m_stopping(false)
+{
+   xSemaphoreGive(m_idle);
+
+   #if portNUM_PROCESSORS > 1
+   const BaseType_t core(xPortGetCoreID() == 0 ? 1 : 0);
+   #else
+   const BaseType_t core(tskNO_AFFINITY);
+   #endif
+   xTaskCreatePinnedToCore(drainTask, "ahsDrain", DRAIN_TASK_STACK_SIZE, this, uxTaskPriorityGet(NULL), &m_task, core);
+}
+
+ArduinoHttpServer::TaskDoubleBufferedSink::~TaskDoubleBufferedSink()
+{
+   // The task gives m_idle back once more on its way out.
+   xSemaphoreTake(m_idle, portMAX_DELAY);
+   m_stopping = true;
+   xSemaphoreGive(m_full);
+   xSemaphoreTake(m_idle, portMAX_DELAY);
+
+   vSemaphoreDelete(m_full);
+   vSemaphoreDelete(m_idle);
+}
+
+void ArduinoHttpServer::TaskDoubleBufferedSink::startDrain()
+{
+   xSemaphoreTake(m_idle, portMAX_DELAY);
+   xSemaphoreGive(m_full);
+}
+
+void ArduinoHttpServer::TaskDoubleBufferedSink::waitDrained()
+{
+   xSemaphoreTake(m_idle, portMAX_DELAY);
+   xSemaphoreGive(m_idle);
+}
+
+void ArduinoHttpServer::TaskDoubleBufferedSink::drainTask(void* pSink)
+{
+   TaskDoubleBufferedSink* const pThis(static_cast<TaskDoubleBufferedSink*>(pSink));
+   for (;;)
+   {
+      xSemaphoreTake(pThis->m_full, portMAX_DELAY);
+      if (pThis->m_stopping)
+      {
+         break;
+      }
+      pThis->drain();
+      xSemaphoreGive(pThis->m_idle);
+   }
+
+   xSemaphoreGive(pThis->m_idle);
+   vTaskDelete(NULL);
+}
+#endif
@@ -0,0 +1,130 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Double buffered Print, draining one buffer while the other fills.
+
+#ifndef __ArduinoHttpServer__DoubleBufferedSink__
+#define __ArduinoHttpServer__DoubleBufferedSink__
+
+#include <Arduino.h>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Collects what is written to it in one of two buffers and writes full
+//! buffers to an output Print, e.g. a flash or OTA writer.
+//! \details Meant as the sink of StreamHttpRequest::streamBody(). Subclasses
+//!    drain a full buffer concurrently (startDrain(), waitDrained()), so the
+//!    next one fills from the network during the flash erase and write; an
+//!    upload then runs at the speed of the slower side instead of alternating
+//!    between both. This base class drains synchronously, which still turns
+//!    small network chunks into buffer sized writes.
+class AbstractDoubleBufferedSink: public Print
+{
+
+public:
+   virtual ~AbstractDoubleBufferedSink() {};
+
+   // Print interface.
+   using Print::write;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   virtual void flush();
+
+   bool finish();
+
+   inline bool hasFailed() const { return m_failed; }; //!< Valid after flush().
+   inline unsigned long getWaitUs() const { return m_waitUs; }; //!< Time writers waited for a drain to complete.
+
+protected:
+   //! _pBuffers_ holds two buffers of _bufferSize_ bytes.
+   AbstractDoubleBufferedSink(Print& out, char* pBuffers, size_t bufferSize);
+
+   //! Write the buffer handed over to the output, now or concurrently.
+   virtual void startDrain() { drain(); };
+   //! Wait until the buffer handed over has been written.
+   virtual void waitDrained() {};
+
+   void drain();
+
+private:
+   void handOver();
+
+   Print& m_out;
+   char* const m_pBuffers;
+   const size_t m_bufferSize;
+
+   char* m_pFill;
+   size_t m_fillLength;
+   const char* m_pDrain; //!< Owned by the drain while it runs.
+   size_t m_drainLength;
+   bool m_drainFailed; //!< Written by the drain.
+
+   bool m_failed;
+   unsigned long m_waitUs;
+};
+
+#if defined(ESP32)
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Drains in a FreeRTOS task, pinned to the other core than the one creating
+//! the sink where there are two.
+class TaskDoubleBufferedSink: public AbstractDoubleBufferedSink
+{
+
+public:
+   static const uint32_t DRAIN_TASK_STACK_SIZE = 4096U; //!< [bytes] Has to cover the output's write().
+
+   virtual ~TaskDoubleBufferedSink();
+
+protected:
+   TaskDoubleBufferedSink(Print& out, char* pBuffers, size_t bufferSize);
+
+   virtual void startDrain();
+   virtual void waitDrained();
+
+private:
+   static void drainTask(void* pSink);
+
+   SemaphoreHandle_t m_full; //!< Given when a buffer is handed over.
+   SemaphoreHandle_t m_idle; //!< Held while draining.
+   TaskHandle_t m_task;
+   volatile bool m_stopping;
+};
+#endif
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Double buffered sink with two BUFFER_SIZE bytes buffers; use the flash
+//! sector size (4096 on ESP8266 and ESP32). BASE selects how buffers are
+//! drained, e.g. TaskDoubleBufferedSink on the ESP32.
+template <size_t BUFFER_SIZE, class BASE = AbstractDoubleBufferedSink>
+class DoubleBufferedSink: public BASE
+{
+
+public:
+   DoubleBufferedSink(Print& out) : BASE(out, m_buffers, BUFFER_SIZE) {};
+   ~DoubleBufferedSink() { this->flush(); };
+
+private:
+   char m_buffers[2 * BUFFER_SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__DoubleBufferedSink__
@@ -10,12 +10,20 @@
 #include "HttpField.hpp"
 #include "ArduinoHttpServerDebug.h"
 
-const char* ArduinoHttpServer::HttpField::SEPERATOR = ": ";
-const char* ArduinoHttpServer::HttpField::SUB_VALUE_SEPERATOR = " ";
-const char* ArduinoHttpServer::HttpField::CONTENT_TYPE_STR = "Content-Type";
-const char* ArduinoHttpServer::HttpField::CONTENT_LENGTH_TYPE_STR = "Content-Length";
-const char* ArduinoHttpServer::HttpField::USER_AGENT_TYPE_STR = "User-Agent";
-const char* ArduinoHttpServer::HttpField::AUTHORIZATION_TYPE_STR = "Authorization";
+#include <string.h>
+
+const char* const ArduinoHttpServer::HttpField::SEPERATOR = ": ";
+const char* const ArduinoHttpServer::HttpField::SUB_VALUE_SEPERATOR = " ";
+const char* const ArduinoHttpServer::HttpField::CONTENT_TYPE_STR = "Content-Type";
+const char* const ArduinoHttpServer::HttpField::CONTENT_LENGTH_TYPE_STR = "Content-Length";
+const char* const ArduinoHttpServer::HttpField::USER_AGENT_TYPE_STR = "User-Agent";
+const char* const ArduinoHttpServer::HttpField::AUTHORIZATION_TYPE_STR = "Authorization";
+const char* const ArduinoHttpServer::HttpField::UPGRADE_TYPE_STR = "Upgrade";
+const char* const ArduinoHttpServer::HttpField::SEC_WEBSOCKET_KEY_TYPE_STR = "Sec-WebSocket-Key";
+const char* const ArduinoHttpServer::HttpField::ACCEPT_ENCODING_TYPE_STR = "Accept-Encoding";
+const char* const ArduinoHttpServer::HttpField::EXPECT_TYPE_STR = "Expect";
+const char* const ArduinoHttpServer::HttpField::CONNECTION_TYPE_STR = "Connection";
+const char* const ArduinoHttpServer::HttpField::SEC_WEBSOCKET_VERSION_TYPE_STR = "Sec-WebSocket-Version";
 
 
 ArduinoHttpServer::HttpField::HttpField(const char* fieldLine) :
@@ -23,9 +31,6 @@ ArduinoHttpServer::HttpField::HttpField(const char* fieldLine) :
    m_value()
 {
 
-   DEBUG_ARDUINO_HTTP_SERVER_PRINT("Parsing HTTP field: ");
-   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(fieldLine);
-
    //! \todo FixString
    String fieldStr(fieldLine);
    int fieldSepIndex( fieldStr.indexOf(SEPERATOR) );
@@ -56,22 +61,54 @@ ArduinoHttpServer::HttpField::~HttpField()
 
 void ArduinoHttpServer::HttpField::determineType(const String& typeStr)
 {
-   if (typeStr.equalsIgnoreCase(CONTENT_TYPE_STR))
+   m_type = typeOf(typeStr.c_str(), typeStr.length());
+}
+
+//! \brief Type of a field named by the _length_ characters at _name_, compared case insensitive.
+//! \details Allows skipping fields which are not of interest without constructing them.
+ArduinoHttpServer::HttpField::Type ArduinoHttpServer::HttpField::typeOf(const char* name, size_t length)
+{
+   if (length == strlen(CONTENT_TYPE_STR) && strncasecmp(name, CONTENT_TYPE_STR, length) == 0)
+   {
+      return Type::CONTENT_TYPE;
+   }
+   else if (length == strlen(CONTENT_LENGTH_TYPE_STR) && strncasecmp(name, CONTENT_LENGTH_TYPE_STR, length) == 0)
+   {
+      return Type::CONTENT_LENGTH;
+   }
+   else if (length == strlen(USER_AGENT_TYPE_STR) && strncasecmp(name, USER_AGENT_TYPE_STR, length) == 0)
+   {
+      return Type::USER_AGENT;
+   }
+   else if (length == strlen(AUTHORIZATION_TYPE_STR) && strncasecmp(name, AUTHORIZATION_TYPE_STR, length) == 0)
+   {
+      return Type::AUTHORIZATION;
+   }
+   else if (length == strlen(UPGRADE_TYPE_STR) && strncasecmp(name, UPGRADE_TYPE_STR, length) == 0)
+   {
+      return Type::UPGRADE;
+   }
+   else if (length == strlen(SEC_WEBSOCKET_KEY_TYPE_STR) && strncasecmp(name, SEC_WEBSOCKET_KEY_TYPE_STR, length) == 0)
+   {
+      return Type::SEC_WEBSOCKET_KEY;
+   }
+   else if (length == strlen(ACCEPT_ENCODING_TYPE_STR) && strncasecmp(name, ACCEPT_ENCODING_TYPE_STR, length) == 0)
    {
-      m_type = Type::CONTENT_TYPE;
+      return Type::ACCEPT_ENCODING;
    }
-   else if (typeStr.equalsIgnoreCase(CONTENT_LENGTH_TYPE_STR))
+   else if (length == strlen(EXPECT_TYPE_STR) && strncasecmp(name, EXPECT_TYPE_STR, length) == 0)
    {
-      m_type = Type::CONTENT_LENGTH;
+      return Type::EXPECT;
    }
-   else if (typeStr.equalsIgnoreCase(USER_AGENT_TYPE_STR))
+   else if (length == strlen(CONNECTION_TYPE_STR) && strncasecmp(name, CONNECTION_TYPE_STR, length) == 0)
    {
-      m_type = Type::USER_AGENT;
+      return Type::CONNECTION;
    }
-   else if (typeStr.equalsIgnoreCase(AUTHORIZATION_TYPE_STR))
+   else if (length == strlen(SEC_WEBSOCKET_VERSION_TYPE_STR) && strncasecmp(name, SEC_WEBSOCKET_VERSION_TYPE_STR, length) == 0)
    {
-      m_type = Type::AUTHORIZATION;
+      return Type::SEC_WEBSOCKET_VERSION;
    }
+   return Type::NOT_SUPPORTED;
 }
 
 
@@ -31,7 +31,13 @@ public:
       CONTENT_TYPE,
       CONTENT_LENGTH,
       USER_AGENT,
-      AUTHORIZATION
+      AUTHORIZATION,
+      UPGRADE,
+      SEC_WEBSOCKET_KEY,
+      ACCEPT_ENCODING,
+      EXPECT,
+      CONNECTION,
+      SEC_WEBSOCKET_VERSION
    };
 
    constexpr static const char* BASIC_AUTH_TYPE_STR = "Basic";
@@ -45,6 +51,7 @@ public:
    HttpField(const HttpField& other) = delete;
 
    const Type getType() const;
+   static Type typeOf(const char* name, size_t length);
 
    inline const String& getValueAsString() const {return m_value; };
    const SubValueStringT getSubValueString(size_t subValueIndex) const;
@@ -53,12 +60,18 @@ public:
 private:
    void determineType(const String& typeStr);
 
-   static const char* SEPERATOR;
-   static const char* SUB_VALUE_SEPERATOR;
-   static const char* CONTENT_TYPE_STR;
-   static const char* CONTENT_LENGTH_TYPE_STR;
-   static const char* USER_AGENT_TYPE_STR;
-   static const char* AUTHORIZATION_TYPE_STR;
+   static const char* const SEPERATOR;
+   static const char* const SUB_VALUE_SEPERATOR;
+   static const char* const CONTENT_TYPE_STR;
+   static const char* const CONTENT_LENGTH_TYPE_STR;
+   static const char* const USER_AGENT_TYPE_STR;
+   static const char* const AUTHORIZATION_TYPE_STR;
+   static const char* const UPGRADE_TYPE_STR;
+   static const char* const SEC_WEBSOCKET_KEY_TYPE_STR;
+   static const char* const ACCEPT_ENCODING_TYPE_STR;
+   static const char* const EXPECT_TYPE_STR;
+   static const char* const CONNECTION_TYPE_STR;
+   static const char* const SEC_WEBSOCKET_VERSION_TYPE_STR;
 
    Type m_type;
    String m_value;
@@ -0,0 +1,258 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Server side request counters and latency histograms.
+
+#include "HttpMetrics.hpp"
+#include "StreamHttpReply.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+
+const uint32_t ArduinoHttpServer::HttpLatencyHistogram::BUCKET_BOUNDS_US[BUCKET_COUNT] =
+   { 1000UL, 5000UL, 10000UL, 25000UL, 50000UL, 100000UL, 250000UL, 500000UL, 1000000UL };
+
+ArduinoHttpServer::HttpLatencyHistogram::HttpLatencyHistogram()
+{
+   for (size_t i=0; i < BUCKET_COUNT+1; ++i)
+   {
+      m_buckets[i] = 0;
+   }
+   m_sumUs = 0;
+}
+
+//! \brief Count a single observation of _durationUs_.
+void ArduinoHttpServer::HttpLatencyHistogram::record(unsigned long durationUs)
+{
+   size_t bucket(0);
+   while (bucket < BUCKET_COUNT && durationUs > BUCKET_BOUNDS_US[bucket])
+   {
+      ++bucket;
+   }
+
+   m_buckets[bucket] += 1;
+   m_sumUs += static_cast<uint64_t>(durationUs);
+}
+
+void ArduinoHttpServer::HttpLatencyHistogram::printTo(Print& print, const __FlashStringHelper* pName) const
+{
+   printNamedTo(print, pName);
+}
+
+void ArduinoHttpServer::HttpLatencyHistogram::printTo(Print& print, const char* pName) const
+{
+   printNamedTo(print, pName);
+}
+
+//! \brief Print the cumulative buckets, sum and count of histogram _pName_.
+template <typename NameT>
+void ArduinoHttpServer::HttpLatencyHistogram::printNamedTo(Print& print, NameT pName) const
+{
+   print.print(AHS_F("# TYPE ")); print.print(pName); print.print(AHS_F(" histogram\n"));
+
+   uint32_t cumulative(0);
+   for (size_t i=0; i < BUCKET_COUNT+1; ++i)
+   {
+      cumulative += m_buckets[i];
+
+      print.print(pName);
+      print.print(AHS_F("_bucket{le=\""));
+      if (i < BUCKET_COUNT)
+      {
+         // Bounds are whole milliseconds, print as seconds.
+         const uint32_t boundMs(BUCKET_BOUNDS_US[i] / 1000UL);
+         print.print(static_cast<unsigned long>(boundMs / 1000UL));
+         print.print('.');
+         if (boundMs % 1000UL < 100UL) { print.print('0'); }
+         if (boundMs % 1000UL < 10UL) { print.print('0'); }
+         print.print(static_cast<unsigned long>(boundMs % 1000UL));
+      }
+      else
+      {
+         print.print(AHS_F("+Inf"));
+      }
+      print.print(AHS_F("\"} "));
+      print.print(static_cast<unsigned long>(cumulative));
+      print.print('\n');
+   }
+
+   // Seconds with 6 decimals; Print has no 64 bit overloads on all cores.
+   const uint64_t sumUs(m_sumUs);
+   const unsigned long fractionUs(static_cast<unsigned long>(sumUs % 1000000ULL));
+   print.print(pName); print.print(AHS_F("_sum "));
+   print.print(static_cast<unsigned long>(sumUs / 1000000ULL));
+   print.print('.');
+   for (unsigned long digit=100000UL; digit > 1UL && fractionUs < digit; digit /= 10UL)
+   {
+      print.print('0');
+   }
+   print.print(fractionUs);
+   print.print('\n');
+
+   print.print(pName); print.print(AHS_F("_count "));
+   print.print(static_cast<unsigned long>(cumulative));
+   print.print('\n');
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+
+ArduinoHttpServer::HttpMetrics::HttpMetrics() :
+   m_parseDuration(),
+   m_totalDuration()
+{
+   for (size_t i=0; i < METHOD_COUNT; ++i)
+   {
+      m_requests[i] = 0;
+   }
+   for (size_t i=0; i < ERROR_COUNT; ++i)
+   {
+      m_errors[i] = 0;
+   }
+   m_bytesReceived = 0;
+   m_bytesSent = 0;
+}
+
+void ArduinoHttpServer::HttpMetrics::recordRequest(Method method, RequestError error, size_t bytesRead, unsigned long parseDurationUs)
+{
+   m_requests[static_cast<size_t>(method)] += 1;
+   if (error != RequestError::OK)
+   {
+      m_errors[static_cast<size_t>(error)] += 1;
+   }
+   m_bytesReceived += static_cast<uint32_t>(bytesRead);
+   m_parseDuration.record(parseDurationUs);
+}
+
+void ArduinoHttpServer::HttpMetrics::recordReply(size_t bytesWritten, unsigned long totalDurationUs)
+{
+   m_bytesSent += static_cast<uint32_t>(bytesWritten);
+   m_totalDuration.record(totalDurationUs);
+}
+
+//! \brief Print all metrics in Prometheus text exposition format.
+void ArduinoHttpServer::HttpMetrics::printTo(Print& print) const
+{
+   print.print(AHS_F("# TYPE http_requests_total counter\n"));
+   for (size_t i=0; i < METHOD_COUNT; ++i)
+   {
+      print.print(AHS_F("http_requests_total{method=\""));
+      printMethodLabel(print, static_cast<Method>(i));
+      print.print(AHS_F("\"} "));
+      print.print(static_cast<unsigned long>(m_requests[i]));
+      print.print('\n');
+   }
+
+   print.print(AHS_F("# TYPE http_request_errors_total counter\n"));
+   for (size_t i=1; i < ERROR_COUNT; ++i) // Skip RequestError::OK.
+   {
+      print.print(AHS_F("http_request_errors_total{error=\""));
+      printErrorLabel(print, static_cast<RequestError>(i));
+      print.print(AHS_F("\"} "));
+      print.print(static_cast<unsigned long>(m_errors[i]));
+      print.print('\n');
+   }
+
+   print.print(AHS_F("# TYPE http_received_bytes_total counter\nhttp_received_bytes_total "));
+   print.print(static_cast<unsigned long>(m_bytesReceived));
+   print.print(AHS_F("\n# TYPE http_sent_bytes_total counter\nhttp_sent_bytes_total "));
+   print.print(static_cast<unsigned long>(m_bytesSent));
+   print.print('\n');
+
+   m_parseDuration.printTo(print, AHS_F("http_request_parse_duration_seconds"));
+   m_totalDuration.printTo(print, AHS_F("http_request_duration_seconds"));
+}
+
+//! \brief Reply with all metrics, e.g. when "/metrics" is requested.
+void ArduinoHttpServer::HttpMetrics::sendReply(Stream& stream, Method method) const
+{
+   StreamHttpReply httpReply(stream, "text/plain; version=0.0.4", method);
+   // No Content-Length; the body ends when the connection is closed.
+   httpReply.sendHeader(0);
+   if (httpReply.hasBody())
+   {
+      printTo(stream);
+   }
+}
+
+void ArduinoHttpServer::HttpMetrics::printMethodLabel(Print& print, Method method)
+{
+   switch (method)
+   {
+      case Method::Get: print.print(AHS_F("GET")); break;
+      case Method::Put: print.print(AHS_F("PUT")); break;
+      case Method::Post: print.print(AHS_F("POST")); break;
+      case Method::Head: print.print(AHS_F("HEAD")); break;
+      case Method::Delete: print.print(AHS_F("DELETE")); break;
+      case Method::Invalid:
+      default: print.print(AHS_F("INVALID")); break;
+   }
+}
+
+void ArduinoHttpServer::HttpMetrics::printErrorLabel(Print& print, RequestError error)
+{
+   switch (error)
+   {
+      case RequestError::TIMEOUT: print.print(AHS_F("timeout")); break;
+      case RequestError::CANNOT_HANDLE_HTTP_METHOD: print.print(AHS_F("cannot_handle_http_method")); break;
+      case RequestError::PARSE_ERROR_INVALID_HTTP_VERSION: print.print(AHS_F("invalid_http_version")); break;
+      case RequestError::PARSE_ERROR_NO_RESOURCE: print.print(AHS_F("no_resource")); break;
+      case RequestError::HEADER_TIMEOUT: print.print(AHS_F("header_timeout")); break;
+      case RequestError::BODY_TIMEOUT: print.print(AHS_F("body_timeout")); break;
+      case RequestError::TOO_MANY_HEADER_FIELDS: print.print(AHS_F("too_many_header_fields")); break;
+      case RequestError::HEADER_TOO_LARGE: print.print(AHS_F("header_too_large")); break;
+      case RequestError::REJECTED: print.print(AHS_F("rejected")); break;
+      case RequestError::OK:
+      default: print.print(AHS_F("ok")); break;
+   }
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+
+ArduinoHttpServer::HttpMetricsObserver::HttpMetricsObserver(HttpMetrics& metrics) :
+   m_metrics(metrics),
+   m_startUs(0),
+   m_parseStartUs(0),
+   m_lastPhaseEndUs(0)
+{
+}
+
+void ArduinoHttpServer::HttpMetricsObserver::requestStarted(unsigned long timestampUs)
+{
+   m_startUs = timestampUs;
+   m_parseStartUs = timestampUs;
+   m_lastPhaseEndUs = timestampUs;
+}
+
+void ArduinoHttpServer::HttpMetricsObserver::phaseEnded(Phase phase, unsigned long timestampUs)
+{
+   if (phase == Phase::WAIT_FOR_DATA)
+   {
+      m_parseStartUs = timestampUs;
+   }
+
+   // Phase::REPLY ends right before replySent() is called.
+   m_lastPhaseEndUs = timestampUs;
+}
+
+//! \brief Record the request, timed until now: a request failing with a
+//!    timeout never reports the end of the phase it timed out in.
+void ArduinoHttpServer::HttpMetricsObserver::requestRead(Method method, RequestError error, size_t bytesRead, unsigned int headerCount)
+{
+   m_lastPhaseEndUs = micros();
+   m_metrics.recordRequest(method, error, bytesRead, m_lastPhaseEndUs - m_parseStartUs);
+}
+
+void ArduinoHttpServer::HttpMetricsObserver::replySent(size_t bytesWritten)
+{
+   m_metrics.recordReply(bytesWritten, m_lastPhaseEndUs - m_startUs);
+}
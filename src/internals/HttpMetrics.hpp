@@ -0,0 +1,126 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Server side request counters and latency histograms.
+
+#ifndef __ArduinoHttpServer__HttpMetrics__
+#define __ArduinoHttpServer__HttpMetrics__
+
+#include <Arduino.h>
+
+#include "HttpTypes.hpp"
+#include "HttpObserver.hpp"
+
+#if defined(__has_include)
+   #if __has_include(<atomic>)
+      #include <atomic>
+      #define ARDUINO_HTTP_SERVER_HAS_ATOMIC
+   #endif
+#endif
+
+namespace ArduinoHttpServer
+{
+
+#ifdef ARDUINO_HTTP_SERVER_HAS_ATOMIC
+   typedef std::atomic<uint32_t> MetricsCounter;
+#else
+   typedef uint32_t MetricsCounter; //!< Single threaded platforms (AVR).
+#endif
+
+#if defined(ARDUINO_HTTP_SERVER_HAS_ATOMIC) && ATOMIC_LLONG_LOCK_FREE == 2
+   typedef std::atomic<uint64_t> MetricsSum;
+#else
+   //! 32 bit cores (ESP8266, ESP32) have no lock-free 64 bit atomics, only
+   //! libatomic helpers; record from one thread there.
+   typedef uint64_t MetricsSum;
+#endif
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Fixed bucket latency histogram.
+class HttpLatencyHistogram
+{
+
+public:
+   static const size_t BUCKET_COUNT = 9;
+   static const uint32_t BUCKET_BOUNDS_US[BUCKET_COUNT]; //!< Upper bounds, excluding +Inf.
+
+   HttpLatencyHistogram();
+
+   void record(unsigned long durationUs);
+   void printTo(Print& print, const __FlashStringHelper* pName) const;
+   void printTo(Print& print, const char* pName) const;
+
+private:
+   template <typename NameT> void printNamedTo(Print& print, NameT pName) const;
+
+   MetricsCounter m_buckets[BUCKET_COUNT+1]; //!< Non cumulative, last one is +Inf.
+   MetricsSum m_sumUs; //!< 64 bits, so it does not wrap for half a million years.
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Request counters and latency histograms, rendered in Prometheus text format.
+//! \details Holds no per request state, so one (global) instance can be shared
+//!    by several HttpMetricsObserver objects, also across threads where
+//!    std::atomic is available and lock-free for 64 bits.
+class HttpMetrics
+{
+
+public:
+   static const size_t METHOD_COUNT = static_cast<size_t>(Method::Delete) + 1;
+   static const size_t ERROR_COUNT = static_cast<size_t>(RequestError::REJECTED) + 1;
+
+   HttpMetrics();
+
+   void recordRequest(Method method, RequestError error, size_t bytesRead, unsigned long parseDurationUs);
+   void recordReply(size_t bytesWritten, unsigned long totalDurationUs);
+
+   void printTo(Print& print) const;
+   void sendReply(Stream& stream, Method method = Method::Get) const;
+
+private:
+   static void printMethodLabel(Print& print, Method method);
+   static void printErrorLabel(Print& print, RequestError error);
+
+   MetricsCounter m_requests[METHOD_COUNT];
+   MetricsCounter m_errors[ERROR_COUNT];
+   MetricsCounter m_bytesReceived;
+   MetricsCounter m_bytesSent;
+   HttpLatencyHistogram m_parseDuration;
+   HttpLatencyHistogram m_totalDuration;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Observer feeding a HttpMetrics instance.
+//! \details Keeps the timestamps of the request being handled; use one per
+//!    connection handling context.
+class HttpMetricsObserver: public AbstractHttpObserver
+{
+
+public:
+   explicit HttpMetricsObserver(HttpMetrics& metrics);
+
+   virtual void requestStarted(unsigned long timestampUs);
+   virtual void phaseEnded(Phase phase, unsigned long timestampUs);
+   virtual void requestRead(Method method, RequestError error, size_t bytesRead, unsigned int headerCount);
+   virtual void replySent(size_t bytesWritten);
+
+private:
+   HttpMetrics& m_metrics;
+   unsigned long m_startUs;
+   unsigned long m_parseStartUs;
+   unsigned long m_lastPhaseEndUs;
+};
+
+}
+
+#endif // __ArduinoHttpServer__HttpMetrics__
@@ -0,0 +1,64 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Per request timing and byte count instrumentation hooks.
+
+#ifndef __ArduinoHttpServer__HttpObserver__
+#define __ArduinoHttpServer__HttpObserver__
+
+#include "HttpTypes.hpp"
+
+#include <stddef.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Receives timing and byte count information of a single request/reply cycle.
+//! \details Attach an instance to a StreamHttpRequest and to the reply sent in
+//!    response to it via their setObserver() methods. Nothing is measured while
+//!    no observer is attached. All timestamps are micros() values.
+//!    Callbacks are invoked synchronously; keep them short.
+class AbstractHttpObserver
+{
+
+public:
+   //! Phases of a request/reply cycle, reported in this order.
+   enum class Phase : char
+   {
+      WAIT_FOR_DATA, //!< Waiting for the first byte of the request.
+      REQUEST_LINE,  //!< Reading and parsing "GET /resource HTTP/1.1".
+      HEADERS,       //!< Reading and parsing the header fields.
+      BODY,          //!< Reading the body.
+      HANDLER,       //!< Application code between readRequest() and the reply.
+      REPLY          //!< Writing the reply.
+   };
+
+   virtual ~AbstractHttpObserver() {};
+
+   //! Called when StreamHttpRequest::readRequest() starts.
+   virtual void requestStarted(unsigned long timestampUs) {};
+
+   //! Called when _phase_ has ended.
+   virtual void phaseEnded(Phase phase, unsigned long timestampUs) {};
+
+   //! Called when StreamHttpRequest::readRequest() is done, also on failure.
+   virtual void requestRead(Method method, RequestError error, size_t bytesRead, unsigned int headerCount) {};
+
+   //! Called when a reply has been written.
+   virtual void replySent(size_t bytesWritten) {};
+
+protected:
+   AbstractHttpObserver() {};
+
+};
+
+}
+
+#endif // __ArduinoHttpServer__HttpObserver__
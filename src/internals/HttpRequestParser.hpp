@@ -0,0 +1,738 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Incremental HTTP request parser, independent of I/O.
+
+#ifndef __ArduinoHttpServer__HttpRequestParser__
+#define __ArduinoHttpServer__HttpRequestParser__
+
+#include "FixString.hpp"
+#include "HttpResource.hpp"
+#include "HttpField.hpp"
+#include "HttpVersion.hpp"
+#include "HttpTypes.hpp"
+#include "HttpObserver.hpp"
+#include "RequestFilter.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+#include <Arduino.h>
+#ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
+   #include <Base64.h>
+#endif
+
+#include <string.h>
+
+namespace ArduinoHttpServer
+{
+
+typedef FixString<32> ErrorMessageString;
+typedef FixString<128> ErrorString;
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! HTTP request parsed from memory, in as many pieces as the data arrives in.
+//! \details feed() consumes bytes up to the end of the request, so data of a
+//!    pipelined next request is left to the caller. Body bytes beyond the body
+//!    buffer are not consumed either; see getUnreadBodyLength(). Deadlines are
+//!    up to the caller, StreamHttpRequest adds them for Stream input.
+template <size_t MAX_BODY_SIZE>
+class HttpRequestParser
+{
+
+public:
+   using Error = ArduinoHttpServer::RequestError;
+
+   enum class State : char
+   {
+      REQUEST_LINE,
+      FIELDS,
+      BODY,
+      COMPLETE,
+      FAILED
+   };
+
+   HttpRequestParser();
+
+   size_t feed(const char* data, size_t length);
+   inline State getState() const { return m_state; };
+   inline bool isDone() const { return m_state == State::COMPLETE || m_state == State::FAILED; };
+
+   // Header retrieval methods.
+   inline const ArduinoHttpServer::HttpResource& getResource() const { return m_resource; };
+   inline const ArduinoHttpServer::HttpVersion& getVersion() const { return m_version; };
+   inline const ArduinoHttpServer::Method getMethod() const { return m_method; };
+
+   // Field retrieval methods.
+   inline const String& getContentType() const { return m_contentTypeField.getValueAsString(); };
+   inline const int getContentLength() const { return m_contentLengthField.getValueAsInt(); };
+   inline const String& getUpgrade() const { return m_upgradeField.getValueAsString(); };
+   inline const String& getWebSocketKey() const { return m_webSocketKeyField.getValueAsString(); };
+   inline const String& getWebSocketVersion() const { return m_webSocketVersionField.getValueAsString(); };
+   inline const String& getConnection() const { return m_connectionField.getValueAsString(); };
+   inline const String& getAcceptEncoding() const { return m_acceptEncodingField.getValueAsString(); };
+   bool expectsContinue() const;
+
+   // Body retrieval methods.
+   //! Retrieve zero terminated body content.
+   inline const char* const getBody() const { return m_body; };
+   //! Writable body, e.g. to decode a form in place with UrlEncodedForm.
+   inline char* getBody() { return m_body; };
+   //! Body bytes in the body buffer.
+   inline size_t getBodyLength() const { return m_bodyLength; };
+   //! Body bytes announced by Content-Length but not read into the body buffer.
+   inline size_t getUnreadBodyLength() const { return m_unreadBodyLength; };
+
+   // State retrieval
+   const ErrorString getError() const;
+   inline Error getErrorCode() const { return m_error; };
+   const char* getErrorStatusCode() const;
+
+   // Header size limits; the deadlines are used by StreamHttpRequest.
+   void setLimits(const RequestLimits& limits) { m_limits = limits; };
+   inline const RequestLimits& getLimits() const { return m_limits; };
+
+   // Instrumentation. Pass 0 to detach.
+   void setObserver(AbstractHttpObserver* pObserver) { m_observer = pObserver; };
+
+   // Early acceptance or rejection. Pass 0 to detach.
+   void setFilter(AbstractRequestFilter<MAX_BODY_SIZE>* pFilter) { m_pFilter = pFilter; };
+
+   // Validate if client provided credentials match _username_ and _password_.
+   #ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
+   bool authenticate(const char * username, const char * password) const;
+   #endif
+
+protected:
+   static const int MAX_LINE_SIZE = 255+1;
+   static const int MAX_BODY_LENGTH = MAX_BODY_SIZE-1; //!< Byte size of array. Leaves space for terminating \0.
+
+   // Direct body access for readers which can fill the buffer in place.
+   inline char* getBodyEnd() { return m_body + m_bodyLength; };
+   inline size_t getBodySpace() const { return m_bodyExpected - m_bodyLength; };
+   void bodyReceived(size_t length);
+
+   void fail(const Error error, const ErrorMessageString& errorMessage = ErrorMessageString());
+   void reject(const char* statusCode);
+   void notifyPhaseEnded(AbstractHttpObserver::Phase phase);
+
+   AbstractHttpObserver* m_observer;
+   AbstractRequestFilter<MAX_BODY_SIZE>* m_pFilter;
+   size_t m_bytesRead;
+   size_t m_unreadBodyLength;
+   unsigned int m_headerCount;
+
+private:
+   void appendToLine(const char* data, size_t length);
+   char* copyLine(const char* pLine, size_t length);
+   void parseLine(const char* pLine, size_t length);
+   void parseRequest(char* pLine);
+   void parseMethod(const char* pToken);
+   void parseResource(const char* pToken);
+   void parseVersion(const char* pToken);
+   void parseField(const char* pLine, size_t length);
+   void headersComplete();
+   bool accept(const char* rejectStatusCode);
+   void complete();
+
+   static const char* nextToken(char*& pCursor);
+
+   State m_state;
+   char m_line[MAX_LINE_SIZE];
+   size_t m_lineLength;
+   size_t m_headerBytes;
+
+   char m_body[MAX_BODY_SIZE];
+   size_t m_bodyLength;
+   size_t m_bodyExpected; //!< Body bytes which fit the buffer.
+
+   Method m_method;
+   ArduinoHttpServer::HttpResource m_resource;
+   ArduinoHttpServer::HttpVersion m_version;
+   ArduinoHttpServer::HttpField m_contentTypeField;
+   ArduinoHttpServer::HttpField m_contentLengthField;
+   ArduinoHttpServer::HttpField m_authorizationField;
+   ArduinoHttpServer::HttpField m_upgradeField;
+   ArduinoHttpServer::HttpField m_webSocketKeyField;
+   ArduinoHttpServer::HttpField m_webSocketVersionField;
+   ArduinoHttpServer::HttpField m_connectionField;
+   ArduinoHttpServer::HttpField m_acceptEncodingField;
+   ArduinoHttpServer::HttpField m_expectField;
+
+   Error m_error;
+   const char* m_rejectStatusCode; //!< Set with Error::REJECTED.
+   ErrorMessageString m_errorDetail;
+
+   RequestLimits m_limits;
+};
+
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::HttpRequestParser() :
+   m_observer(0),
+   m_pFilter(0),
+   m_bytesRead(0),
+   m_unreadBodyLength(0),
+   m_headerCount(0),
+   m_state(State::REQUEST_LINE),
+   m_line{0},
+   m_lineLength(0),
+   m_headerBytes(0),
+   m_body{0},
+   m_bodyLength(0),
+   m_bodyExpected(0),
+   m_method(Method::Invalid),
+   m_resource(),
+   m_version(),
+   m_contentTypeField(),
+   m_contentLengthField(),
+   m_authorizationField(),
+   m_upgradeField(),
+   m_webSocketKeyField(),
+   m_webSocketVersionField(),
+   m_connectionField(),
+   m_acceptEncodingField(),
+   m_expectField(),
+   m_error(Error::OK),
+   m_rejectStatusCode(0),
+   m_errorDetail(),
+   m_limits()
+{
+   static_assert(MAX_BODY_SIZE >= 1, "HTTP body buffer needs space for the terminating zero.");
+}
+
+//------------------------------------------------------------------------------
+//! \brief Parse the next _length_ bytes of the request.
+//! \details Lines are located with memchr() and parsed where they are when
+//!    _data_ holds them completely; only lines split over several calls and
+//!    the fields which are kept are copied. The body is copied with memcpy().
+//! \returns Bytes consumed. Less than _length_ once the request is complete
+//!    or parsing failed.
+template <size_t MAX_BODY_SIZE>
+size_t ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::feed(const char* data, size_t length)
+{
+   size_t consumed(0);
+
+   while (consumed < length && (m_state == State::REQUEST_LINE || m_state == State::FIELDS))
+   {
+      const char* pStart(data + consumed);
+      const char* pNewLine(static_cast<const char*>(memchr(pStart, '\n', length - consumed)));
+      size_t spanLength(pNewLine != 0 ? static_cast<size_t>(pNewLine - pStart) + 1 : length - consumed);
+
+      if (m_headerBytes + spanLength > m_limits.maxHeaderBytes)
+      {
+         consumed += m_limits.maxHeaderBytes - m_headerBytes;
+         m_bytesRead += consumed;
+         fail(Error::HEADER_TOO_LARGE);
+         return consumed;
+      }
+      m_headerBytes += spanLength;
+      consumed += spanLength;
+
+      if (pNewLine != 0 && m_lineLength == 0)
+      {
+         // The whole line is in _data_; parse it where it is.
+         parseLine(pStart, spanLength - 1);
+      }
+      else if (pNewLine != 0)
+      {
+         appendToLine(pStart, spanLength - 1);
+         parseLine(m_line, m_lineLength);
+      }
+      else
+      {
+         appendToLine(pStart, spanLength);
+      }
+   }
+   m_bytesRead += consumed;
+
+   if (m_state == State::BODY && consumed < length)
+   {
+      size_t chunkSize(length - consumed);
+      if (chunkSize > getBodySpace())
+      {
+         chunkSize = getBodySpace();
+      }
+      memcpy(getBodyEnd(), data + consumed, chunkSize);
+      consumed += chunkSize;
+      bodyReceived(chunkSize);
+   }
+
+   return consumed;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Account for _length_ bytes written at getBodyEnd().
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::bodyReceived(size_t length)
+{
+   m_bodyLength += length;
+   m_bytesRead += length;
+   m_unreadBodyLength -= length;
+
+   if (m_bodyLength == m_bodyExpected)
+   {
+      AHS_TRACE(BODY_READ, m_bodyLength);
+      complete();
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Collect part of a line. Characters beyond MAX_LINE_SIZE are discarded.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::appendToLine(const char* data, size_t length)
+{
+   const size_t space(MAX_LINE_SIZE - 1 - m_lineLength);
+   if (length > space)
+   {
+      length = space;
+   }
+   memcpy(m_line + m_lineLength, data, length);
+   m_lineLength += length;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Zero terminated copy of a line in the line buffer, for parsing in place.
+template <size_t MAX_BODY_SIZE>
+char* ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::copyLine(const char* pLine, size_t length)
+{
+   if (pLine != m_line)
+   {
+      memcpy(m_line, pLine, length);
+   }
+   m_line[length] = '\0';
+   return m_line;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Handle a complete line, either in the input or in the line buffer.
+//! \details Accepts both "\r\n" and "\n" line endings. Characters beyond
+//!    MAX_LINE_SIZE are discarded. Only lines which are kept are copied.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::parseLine(const char* pLine, size_t length)
+{
+   if (length > 0 && pLine[length - 1] == '\r')
+   {
+      --length;
+   }
+   if (length > MAX_LINE_SIZE - 1)
+   {
+      length = MAX_LINE_SIZE - 1;
+   }
+   AHS_TRACE(LINE_READ, length);
+   m_lineLength = 0;
+
+   if (m_state == State::REQUEST_LINE)
+   {
+      // Empty lines preceding the request line are ignored (RFC 9112, 2.2).
+      if (length > 0)
+      {
+         parseRequest(copyLine(pLine, length));
+      }
+   }
+   else if (length == 0)
+   {
+      headersComplete();
+   }
+   else
+   {
+      parseField(pLine, length);
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Parse first line of HTTP request.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::parseRequest(char* pLine)
+{
+   char* pCursor(pLine);
+   parseMethod(nextToken(pCursor));
+   parseResource(nextToken(pCursor));
+   parseVersion(nextToken(pCursor));
+
+   if (m_state != State::FAILED)
+   {
+      m_state = State::FIELDS;
+      notifyPhaseEnded(AbstractHttpObserver::Phase::REQUEST_LINE);
+      accept(m_pFilter ? m_pFilter->requestLineRead(*this) : 0);
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Parse method: GET, PUT, HEAD, etc.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::parseMethod(const char* pToken)
+{
+   if(m_state == State::FAILED) { return; }
+
+   // len("DELETE") + 1 for terminating null = 7
+   FixString<7U> token(pToken);
+
+   if(token == "GET")
+   {
+      m_method = Method::Get;
+   }
+   else if (token == "PUT")
+   {
+      m_method = Method::Put;
+   }
+   else if (token == "POST")
+   {
+      m_method = Method::Post;
+   }
+   else if (token == "HEAD")
+   {
+      m_method = Method::Head;
+   }
+   else if (token == "DELETE")
+   {
+      m_method = Method::Delete;
+   }
+   else
+   {
+      m_method = Method::Invalid;
+      fail(Error::CANNOT_HANDLE_HTTP_METHOD, token);
+   }
+   AHS_TRACE(METHOD, m_method);
+}
+
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::parseResource(const char* pToken)
+{
+   if(m_state == State::FAILED) { return; }
+
+   m_resource = ArduinoHttpServer::HttpResource(String(pToken));
+
+   if (!m_resource.isValid())
+   {
+      fail(Error::PARSE_ERROR_NO_RESOURCE);
+   }
+}
+
+//! Parse "HTTP/1.1" (or any other version).
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::parseVersion(const char* pToken)
+{
+   if(m_state == State::FAILED) { return; }
+
+   // HTTP/000.000
+   HttpVersion::FixStringT version(pToken);
+   int slashPosition(version.lastIndexOf('/'));
+
+   // String returns unsigned int for length. The number follows the slash.
+   if (slashPosition > 0 && static_cast<unsigned int>(slashPosition) + 1 < version.length())
+   {
+      m_version = HttpVersion(version.substring(slashPosition + 1));
+   }
+   else
+   {
+      fail(Error::PARSE_ERROR_INVALID_HTTP_VERSION, version);
+   }
+}
+
+//! \brief Next space separated token at _pCursor_, empty string when there is none.
+//! \details Terminates the token in place and advances _pCursor_ past it.
+template <size_t MAX_BODY_SIZE>
+const char* ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::nextToken(char*& pCursor)
+{
+   while (*pCursor == ' ')
+   {
+      ++pCursor;
+   }
+
+   const char* pToken(pCursor);
+   while (*pCursor != ' ' && *pCursor != '\0')
+   {
+      ++pCursor;
+   }
+   if (*pCursor == ' ')
+   {
+      *pCursor++ = '\0';
+   }
+   return pToken;
+}
+
+//! \brief Store the fields of interest; other fields are skipped without copying them.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::parseField(const char* pLine, size_t length)
+{
+   if(++m_headerCount > m_limits.maxHeaderFields)
+   {
+      fail(Error::TOO_MANY_HEADER_FIELDS);
+      return;
+   }
+
+   const char* pColon(static_cast<const char*>(memchr(pLine, ':', length)));
+   const HttpField::Type type(pColon != 0 ? HttpField::typeOf(pLine, pColon - pLine) : HttpField::Type::NOT_SUPPORTED);
+   AHS_TRACE(FIELD, type);
+
+   if(type == ArduinoHttpServer::HttpField::Type::CONTENT_TYPE)
+   {
+      m_contentTypeField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::CONTENT_LENGTH)
+   {
+      m_contentLengthField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::AUTHORIZATION)
+   {
+      m_authorizationField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::UPGRADE)
+   {
+      m_upgradeField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::SEC_WEBSOCKET_KEY)
+   {
+      m_webSocketKeyField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::SEC_WEBSOCKET_VERSION)
+   {
+      m_webSocketVersionField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::CONNECTION)
+   {
+      m_connectionField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::ACCEPT_ENCODING)
+   {
+      m_acceptEncodingField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else if(type == ArduinoHttpServer::HttpField::Type::EXPECT)
+   {
+      m_expectField = ArduinoHttpServer::HttpField(copyLine(pLine, length));
+   }
+   else
+   {
+      // Ignore other fields for now.
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Decide how much body follows the empty line ending the header.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::headersComplete()
+{
+   notifyPhaseEnded(AbstractHttpObserver::Phase::HEADERS);
+
+   if (!accept(m_pFilter ? m_pFilter->headersRead(*this) : 0))
+   {
+      return;
+   }
+
+   int contentLength(getContentLength());
+   if (contentLength < 0)
+   {
+      contentLength = 0;
+   }
+   m_unreadBodyLength = contentLength;
+   AHS_TRACE(HEADER_DONE, contentLength);
+
+   if (contentLength > MAX_BODY_LENGTH)
+   {
+      AHS_TRACE(BODY_TRUNCATED, contentLength);
+      contentLength = MAX_BODY_LENGTH;
+   }
+
+   m_bodyExpected = contentLength;
+   if (m_bodyExpected > 0)
+   {
+      m_state = State::BODY;
+   }
+   else
+   {
+      complete();
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Apply the answer of a filter hook: 0 or the status code to reject with.
+//! \returns False when rejected.
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::accept(const char* rejectStatusCode)
+{
+   if (rejectStatusCode)
+   {
+      AHS_TRACE(REQUEST_REJECTED, atoi(rejectStatusCode));
+      reject(rejectStatusCode);
+      return false;
+   }
+   return true;
+}
+
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::complete()
+{
+   m_state = State::COMPLETE;
+   notifyPhaseEnded(AbstractHttpObserver::Phase::BODY);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Stop parsing with _error_.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::fail(const Error error, const ErrorMessageString& errorMessage)
+{
+   m_state = State::FAILED;
+   m_error = error;
+   m_errorDetail = errorMessage;
+}
+
+//! \brief Stop parsing because the application refused the request; reply
+//!    with _statusCode_, e.g. "413".
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::reject(const char* statusCode)
+{
+   fail(Error::REJECTED);
+   m_rejectStatusCode = statusCode;
+}
+
+//! \brief Report the end of _phase_ to the observer, if any.
+template <size_t MAX_BODY_SIZE>
+void ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::notifyPhaseEnded(AbstractHttpObserver::Phase phase)
+{
+   if(m_observer)
+   {
+      m_observer->phaseEnded(phase, micros());
+   }
+}
+
+template <size_t MAX_BODY_SIZE>
+const ArduinoHttpServer::ErrorString ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::getError() const
+{
+   ErrorString errorString;
+   switch(m_error)
+   {
+      case Error::OK:
+         break;
+
+      case Error::TIMEOUT:
+         errorString = AHS_F("Timeout occurred while waiting for data");
+         break;
+
+      case Error::CANNOT_HANDLE_HTTP_METHOD:
+         errorString = AHS_F("Don't know how to handle HTTP method: \"");
+         errorString += m_errorDetail;
+         errorString += AHS_F("\"");
+         break;
+
+      case Error::PARSE_ERROR_INVALID_HTTP_VERSION:
+         errorString = AHS_F("Invalid HTTP version: \"");
+         errorString += m_errorDetail;
+         errorString += AHS_F("\"");
+         break;
+
+      case Error::PARSE_ERROR_NO_RESOURCE:
+         errorString = AHS_F("No resource specified.");
+         break;
+
+      case Error::HEADER_TIMEOUT:
+         errorString = AHS_F("Timeout occurred while reading the header");
+         break;
+
+      case Error::BODY_TIMEOUT:
+         errorString = AHS_F("Timeout occurred while reading the body");
+         break;
+
+      case Error::TOO_MANY_HEADER_FIELDS:
+         errorString = AHS_F("Too many header fields");
+         break;
+
+      case Error::HEADER_TOO_LARGE:
+         errorString = AHS_F("Header too large");
+         break;
+
+      case Error::REJECTED:
+         errorString = AHS_F("Request rejected");
+         break;
+
+      default:
+         break;
+   }
+
+   return errorString;
+}
+
+//------------------------------------------------------------------------------
+//! \brief HTTP status code to reply with when readRequest() failed.
+//! \details E.g. StreamHttpErrorReply(client, contentType, request.getErrorStatusCode()).
+template <size_t MAX_BODY_SIZE>
+const char* ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::getErrorStatusCode() const
+{
+   switch(m_error)
+   {
+      case Error::OK:
+         return "200";
+
+      case Error::TIMEOUT:
+      case Error::HEADER_TIMEOUT:
+      case Error::BODY_TIMEOUT:
+         return "408"; // Request Timeout
+
+      case Error::TOO_MANY_HEADER_FIELDS:
+      case Error::HEADER_TOO_LARGE:
+         return "431"; // Request Header Fields Too Large
+
+      case Error::REJECTED:
+         return m_rejectStatusCode;
+
+      default:
+         return "400"; // Bad Request
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Whether the client waits for "100 Continue" before sending the body.
+//! \details Only HTTP/1.1 clients may expect it (RFC 9110, 10.1.1).
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::expectsContinue() const
+{
+   const bool http11(m_version.getMajor() > 1 || (m_version.getMajor() == 1 && m_version.getMinor() >= 1));
+   return http11 && m_expectField.getValueAsString().equalsIgnoreCase("100-continue");
+}
+
+#ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::HttpRequestParser<MAX_BODY_SIZE>::authenticate(const char *username, const char *password) const
+{
+   if (m_authorizationField.getType() == HttpField::Type::NOT_SUPPORTED)
+   {
+      return false;
+   }
+
+   // HTTP value: "<Type> <Base 64 encoded credentials>"
+   // Retrieve type and verify wether it is basic authorization.
+   if(!(m_authorizationField.getSubValueString(0) == HttpField::BASIC_AUTH_TYPE_STR))
+   {
+      AHS_TRACE(AUTH_FAILED, 0);
+      return false;
+   }
+
+   FixString<128U> combinedInput(username);
+   combinedInput += AHS_F(":");
+   combinedInput += password;
+
+   const int encodedLength = Base64.encodedLength(combinedInput.length());
+
+   char encodedString[encodedLength+1]; // Base64 makes sure _encodedString_ is zero terminated.
+   Base64.encode(encodedString, const_cast<char*>(combinedInput.cStr()), combinedInput.length());
+
+   if ( m_authorizationField.getSubValueString(1) == encodedString )
+   {
+      return true;
+   }
+
+   AHS_TRACE(AUTH_FAILED, 1);
+   return false;
+}
+#endif
+
+#endif // __ArduinoHttpServer__HttpRequestParser__
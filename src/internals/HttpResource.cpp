@@ -8,6 +8,7 @@
 //! The URL/path provided after the HTTP method.
 
 #include "HttpResource.hpp"
+#include "UrlEncodedForm.hpp"
 
 #include <WString.h>
 
@@ -37,17 +38,23 @@ bool ArduinoHttpServer::HttpResource::isValid()
 
 //! Retrieve resource part at the specified index.
 //! \details E.g. HttpResource("/api/sensors/1/state")[1]
-//!    returns "sensors".
+//!    returns "sensors". The query string is not part of the path.
 //! \returns Empty string when index specified is out of range. 
 String ArduinoHttpServer::HttpResource::operator[](const unsigned int index) const
 {
+   int pathEnd( m_resource.indexOf(QUERY_SEPERATOR) );
+   if(pathEnd == -1)
+   {
+      pathEnd = m_resource.length();
+   }
+
    int fromOffset(0);
 
    // Forward till we reach desired index.
    for (unsigned int currentIndex=0; currentIndex <= index; ++currentIndex)
    {
       fromOffset = m_resource.indexOf(RESOURCE_SEPERATOR, fromOffset);
-      if(fromOffset == -1)
+      if(fromOffset == -1 || fromOffset >= pathEnd)
       {
          return String("");
       }
@@ -57,9 +64,9 @@ String ArduinoHttpServer::HttpResource::operator[](const unsigned int index) con
 
    // Find next possible '/' or end.
    int toOffset( m_resource.indexOf(RESOURCE_SEPERATOR, fromOffset) );
-   if(toOffset == -1)
+   if(toOffset == -1 || toOffset > pathEnd)
    {
-      toOffset = m_resource.length();
+      toOffset = pathEnd;
    }
 
    return m_resource.substring(fromOffset, toOffset);
@@ -71,3 +78,76 @@ const String& ArduinoHttpServer::HttpResource::toString() const
 {
    return m_resource;
 }
+
+//! Whether the query string holds parameter _name_, with or without value.
+bool ArduinoHttpServer::HttpResource::hasQueryParameter(const char* name) const
+{
+   size_t valueStart(0);
+   size_t valueEnd(0);
+   return findQueryParameter(name, valueStart, valueEnd);
+}
+
+//! Retrieve the decoded value of query parameter _name_.
+//! \details E.g. HttpResource("/api/led?color=dark%20red").getQueryParameter("color")
+//!    returns "dark red". Decoded as UrlEncodedForm does.
+//! \returns Empty string when the parameter is absent.
+String ArduinoHttpServer::HttpResource::getQueryParameter(const char* name) const
+{
+   size_t valueStart(0);
+   size_t valueEnd(0);
+   if(!findQueryParameter(name, valueStart, valueEnd))
+   {
+      return String("");
+   }
+
+   // Decode through a small buffer, never splitting an escape.
+   const char* const pResource(m_resource.c_str());
+   String value;
+   value.reserve(valueEnd - valueStart);
+   char chunk[32 + 1];
+   while(valueStart < valueEnd)
+   {
+      size_t length(valueEnd - valueStart < sizeof(chunk) - 1U ? valueEnd - valueStart : sizeof(chunk) - 1U);
+      if(valueStart + length < valueEnd)
+      {
+         if(pResource[valueStart + length - 1U] == '%') { length -= 1U; }
+         else if(pResource[valueStart + length - 2U] == '%') { length -= 2U; }
+      }
+
+      chunk[urlDecode(pResource + valueStart, length, chunk)] = '\0';
+      value += chunk;
+      valueStart += length;
+   }
+   return value;
+}
+
+//! Locate the encoded value of query parameter _name_, comparing names decoded.
+bool ArduinoHttpServer::HttpResource::findQueryParameter(const char* name, size_t& valueStart, size_t& valueEnd) const
+{
+   const int queryStart( m_resource.indexOf(QUERY_SEPERATOR) );
+   if(queryStart == -1)
+   {
+      return false;
+   }
+
+   const char* const pResource(m_resource.c_str());
+   const size_t length(m_resource.length());
+   size_t start(queryStart + 1);
+   while(start < length)
+   {
+      const char* pSeparator(static_cast<const char*>(memchr(pResource + start, '&', length - start)));
+      const size_t end(pSeparator ? static_cast<size_t>(pSeparator - pResource) : length);
+      const char* pEquals(static_cast<const char*>(memchr(pResource + start, '=', end - start)));
+      const size_t keyEnd(pEquals ? static_cast<size_t>(pEquals - pResource) : end);
+
+      if(urlDecodedEquals(pResource + start, keyEnd - start, name))
+      {
+         valueStart = pEquals ? keyEnd + 1U : end;
+         valueEnd = end;
+         return true;
+      }
+
+      start = end + 1U;
+   }
+   return false;
+}
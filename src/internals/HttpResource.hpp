@@ -28,8 +28,14 @@ public:
     String operator[](const unsigned int index) const;
     const String& toString() const;
 
+    bool hasQueryParameter(const char* name) const;
+    String getQueryParameter(const char* name) const;
+
 private:
    static const char RESOURCE_SEPERATOR = '/';
+   static const char QUERY_SEPERATOR = '?';
+
+   bool findQueryParameter(const char* name, size_t& valueStart, size_t& valueEnd) const;
 
    String m_resource;
 
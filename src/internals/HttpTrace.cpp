@@ -0,0 +1,107 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Binary ring buffer trace log.
+
+#include "ArduinoHttpServerDebug.h"
+
+#ifdef ARDUINO_HTTP_SERVER_TRACE
+
+#include "HttpTrace.hpp"
+#include "StreamHttpReply.hpp"
+
+ArduinoHttpServer::HttpTrace::Entry ArduinoHttpServer::HttpTrace::s_entries[ARDUINO_HTTP_SERVER_TRACE_SIZE];
+uint16_t ArduinoHttpServer::HttpTrace::s_next = 0;
+uint16_t ArduinoHttpServer::HttpTrace::s_count = 0;
+
+//------------------------------------------------------------------------------
+//! \brief Store _event_, overwriting the oldest one when the buffer is full.
+void ArduinoHttpServer::HttpTrace::record(Event event, long arg)
+{
+   Entry& entry(s_entries[s_next]);
+   entry.timestampUs = micros();
+   entry.arg = static_cast<int32_t>(arg);
+   entry.event = event;
+
+   s_next = (s_next + 1) % ARDUINO_HTTP_SERVER_TRACE_SIZE;
+   if (s_count < ARDUINO_HTTP_SERVER_TRACE_SIZE)
+   {
+      ++s_count;
+   }
+}
+
+void ArduinoHttpServer::HttpTrace::clear()
+{
+   s_next = 0;
+   s_count = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Print all recorded events, oldest first, one per line:
+//!    "<us since previous event> <event> <arg>".
+void ArduinoHttpServer::HttpTrace::dump(Print& print)
+{
+   // Copy the indices first; events recorded while printing end up in the next dump.
+   const uint16_t count(s_count);
+   uint16_t index((s_next + ARDUINO_HTTP_SERVER_TRACE_SIZE - count) % ARDUINO_HTTP_SERVER_TRACE_SIZE);
+   uint32_t previousUs(s_entries[index].timestampUs);
+
+   for (uint16_t i=0; i < count; ++i)
+   {
+      const Entry entry(s_entries[index]);
+
+      print.print(AHS_F("+"));
+      print.print(static_cast<unsigned long>(entry.timestampUs - previousUs));
+      print.print(AHS_F("us "));
+      printEventName(print, entry.event);
+      print.print(' ');
+      print.print(static_cast<long>(entry.arg));
+      print.print(AHS_F("\r\n"));
+
+      previousUs = entry.timestampUs;
+      index = (index + 1) % ARDUINO_HTTP_SERVER_TRACE_SIZE;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Reply with the dump, e.g. when "/debug/trace" is requested.
+void ArduinoHttpServer::HttpTrace::sendReply(Stream& stream, Method method)
+{
+   StreamHttpReply httpReply(stream, "text/plain", method);
+   // No Content-Length; the body ends when the connection is closed.
+   httpReply.sendHeader(0);
+   if (httpReply.hasBody())
+   {
+      dump(stream);
+   }
+}
+
+void ArduinoHttpServer::HttpTrace::printEventName(Print& print, Event event)
+{
+   switch (event)
+   {
+      case Event::REQUEST_START: print.print(AHS_F("request_start")); break;
+      case Event::DATA_AVAILABLE: print.print(AHS_F("data_available")); break;
+      case Event::LINE_READ: print.print(AHS_F("line_read")); break;
+      case Event::METHOD: print.print(AHS_F("method")); break;
+      case Event::FIELD: print.print(AHS_F("field")); break;
+      case Event::BODY_TRUNCATED: print.print(AHS_F("body_truncated")); break;
+      case Event::BODY_READ: print.print(AHS_F("body_read")); break;
+      case Event::REQUEST_DONE: print.print(AHS_F("request_done")); break;
+      case Event::REPLY_START: print.print(AHS_F("reply_start")); break;
+      case Event::REPLY_DONE: print.print(AHS_F("reply_done")); break;
+      case Event::INPUT_DISCARDED: print.print(AHS_F("input_discarded")); break;
+      case Event::HEADER_DONE: print.print(AHS_F("header_done")); break;
+      case Event::REQUEST_REJECTED: print.print(AHS_F("request_rejected")); break;
+      case Event::AUTH_FAILED: print.print(AHS_F("auth_failed")); break;
+      case Event::DISCARD_REFUSED: print.print(AHS_F("discard_refused")); break;
+      case Event::EVENT_DROPPED: print.print(AHS_F("event_dropped")); break;
+      default: print.print(static_cast<int>(event)); break;
+   }
+}
+
+#endif // ARDUINO_HTTP_SERVER_TRACE
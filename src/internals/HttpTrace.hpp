@@ -0,0 +1,80 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Binary ring buffer trace log.
+
+#ifndef __ArduinoHttpServer__HttpTrace__
+#define __ArduinoHttpServer__HttpTrace__
+
+#include <Arduino.h>
+
+#include "HttpTypes.hpp"
+
+#ifndef ARDUINO_HTTP_SERVER_TRACE_SIZE
+   #define ARDUINO_HTTP_SERVER_TRACE_SIZE 64 //!< Number of events kept.
+#endif
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Fixed size RAM log of parse and reply events.
+//! \details Recording an event stores a timestamp, an event id and one integer
+//!    argument; no formatting takes place until dump() or sendReply() is
+//!    called. Only compiled in when ARDUINO_HTTP_SERVER_TRACE is defined, use
+//!    the AHS_TRACE() macro to record events. Recording is not synchronized;
+//!    trace from a single thread only.
+class HttpTrace
+{
+
+public:
+   enum class Event : uint8_t
+   {
+      REQUEST_START,    //!< Arg: 0.
+      DATA_AVAILABLE,   //!< Arg: [ms] waited for the first byte.
+      LINE_READ,        //!< Arg: line length.
+      METHOD,           //!< Arg: ArduinoHttpServer::Method.
+      FIELD,            //!< Arg: HttpField::Type.
+      BODY_TRUNCATED,   //!< Arg: Content-Length received.
+      BODY_READ,        //!< Arg: bytes read.
+      REQUEST_DONE,     //!< Arg: RequestError.
+      REPLY_START,      //!< Arg: 0.
+      REPLY_DONE,       //!< Arg: bytes written.
+      INPUT_DISCARDED,  //!< Arg: bytes discarded.
+      HEADER_DONE,      //!< Arg: Content-Length, 0 without.
+      REQUEST_REJECTED, //!< Arg: status code returned by the request filter.
+      AUTH_FAILED,      //!< Arg: 0 not basic authentication, 1 wrong credentials.
+      DISCARD_REFUSED,  //!< Arg: unread bytes, more than may be discarded.
+      EVENT_DROPPED     //!< Arg: length of the server-sent event not sent.
+   };
+
+   static void record(Event event, long arg);
+   static void clear();
+
+   static void dump(Print& print);
+   static void sendReply(Stream& stream, Method method = Method::Get);
+
+private:
+   struct Entry
+   {
+      uint32_t timestampUs;
+      int32_t arg;
+      Event event;
+   };
+
+   static void printEventName(Print& print, Event event);
+
+   static Entry s_entries[ARDUINO_HTTP_SERVER_TRACE_SIZE];
+   static uint16_t s_next;  //!< Index the next event is written to.
+   static uint16_t s_count; //!< Number of valid entries.
+};
+
+}
+
+#endif // __ArduinoHttpServer__HttpTrace__
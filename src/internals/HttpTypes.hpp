@@ -0,0 +1,56 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Types shared between requests, replies and observers.
+
+#ifndef __ArduinoHttpServer__HttpTypes__
+#define __ArduinoHttpServer__HttpTypes__
+
+#include <stddef.h>
+
+namespace ArduinoHttpServer
+{
+
+enum class Method : char
+{
+   Invalid, Get, Put, Post, Head, Delete
+};
+
+//! Reason why reading a request failed.
+enum class RequestError : char
+{
+   OK,
+   TIMEOUT,
+   CANNOT_HANDLE_HTTP_METHOD,
+   PARSE_ERROR_INVALID_HTTP_VERSION,
+   PARSE_ERROR_NO_RESOURCE,
+   HEADER_TIMEOUT,
+   BODY_TIMEOUT,
+   TOO_MANY_HEADER_FIELDS,
+   HEADER_TOO_LARGE,
+   REJECTED
+};
+
+//! Bounds on the time and memory a single request may consume.
+//! \details Timeouts are absolute per phase, not per received byte or line,
+//!    so a client trickling data cannot keep readRequest() busy indefinitely.
+struct RequestLimits
+{
+   unsigned long firstByteTimeoutMs = 2550UL; //!< [ms] Until the first byte arrives.
+   unsigned long headerTimeoutMs = 10000UL;   //!< [ms] From the first byte until the empty line ending the header.
+   unsigned long bodyTimeoutMs = 10000UL;     //!< [ms] From the end of the header until the last body byte.
+   unsigned long streamBodyTimeoutMs = 60000UL; //!< [ms] From calling streamBody() until the last body byte. Longer, as
+                                                //!< streamed bodies such as firmware uploads are larger.
+   unsigned int maxHeaderFields = 32U;        //!< Header field lines, request line excluded.
+   size_t maxHeaderBytes = 4096U;             //!< Request line plus header fields including line endings.
+   size_t maxDiscardBytes = 8192U;            //!< Larger unread bodies are not discarded, close the connection instead.
+   unsigned long discardTimeoutMs = 1000UL;   //!< [ms] Budget for discarding an unread body.
+};
+
+}
+
+#endif // __ArduinoHttpServer__HttpTypes__
@@ -0,0 +1,601 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Incremental, event driven (SAX style) JSON tokenizer.
+
+#include "JsonTokenizer.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+#include <stdlib.h>
+
+namespace
+{
+   inline bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
+   inline bool isWhitespace(char ch) { return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t'; }
+   inline bool isNumberChar(char ch) { return isDigit(ch) || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E'; }
+   inline bool isLiteralChar(char ch) { return ch >= 'a' && ch <= 'z'; }
+
+   //! -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+   bool isValidNumber(const char* pData, size_t length)
+   {
+      size_t i(0);
+      if (i < length && pData[i] == '-') { ++i; }
+
+      if (i < length && pData[i] == '0') { ++i; }
+      else if (i < length && isDigit(pData[i])) { while (i < length && isDigit(pData[i])) { ++i; } }
+      else { return false; }
+
+      if (i < length && pData[i] == '.')
+      {
+         ++i;
+         if (i == length || !isDigit(pData[i])) { return false; }
+         while (i < length && isDigit(pData[i])) { ++i; }
+      }
+
+      if (i < length && (pData[i] == 'e' || pData[i] == 'E'))
+      {
+         ++i;
+         if (i < length && (pData[i] == '+' || pData[i] == '-')) { ++i; }
+         if (i == length || !isDigit(pData[i])) { return false; }
+         while (i < length && isDigit(pData[i])) { ++i; }
+      }
+
+      return i == length;
+   }
+
+   bool isLiteral(const char* pData, size_t length, const char* literal)
+   {
+      return strlen(literal) == length && memcmp(pData, literal, length) == 0;
+   }
+
+   int hexValue(char ch)
+   {
+      if (ch >= '0' && ch <= '9') { return ch - '0'; }
+      if (ch >= 'a' && ch <= 'f') { return ch - 'a' + 10; }
+      if (ch >= 'A' && ch <= 'F') { return ch - 'A' + 10; }
+      return -1;
+   }
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+bool ArduinoHttpServer::JsonToken::equals(const char* text) const
+{
+   return strlen(text) == m_length && memcmp(m_pData, text, m_length) == 0;
+}
+
+//! \brief Integer part of a number, 0 for other tokens.
+long ArduinoHttpServer::JsonToken::toLong() const
+{
+   if (m_type != Type::NUMBER)
+   {
+      return 0L;
+   }
+
+   size_t i(m_pData[0] == '-' ? 1U : 0U);
+   long result(0);
+   for (; i < m_length && isDigit(m_pData[i]); ++i)
+   {
+      result = result * 10L + (m_pData[i] - '0');
+   }
+   return m_pData[0] == '-' ? -result : result;
+}
+
+double ArduinoHttpServer::JsonToken::toDouble() const
+{
+   char number[32];
+   if (m_type != Type::NUMBER || m_length >= sizeof(number))
+   {
+      return 0.0;
+   }
+   memcpy(number, m_pData, m_length);
+   number[m_length] = '\0';
+   return strtod(number, 0);
+}
+
+String ArduinoHttpServer::JsonToken::toString() const
+{
+   String result;
+   result.reserve(m_length);
+   for (size_t i=0; i < m_length; ++i)
+   {
+      result += m_pData[i];
+   }
+   return result;
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::AbstractJsonTokenizer::AbstractJsonTokenizer(AbstractJsonHandler& handler, char* pTokenBuffer, size_t tokenBufferSize) :
+   m_handler(handler),
+   m_pTokenBuffer(pTokenBuffer),
+   m_tokenBufferSize(tokenBufferSize),
+   m_error(Error::NONE),
+   m_expect(Expect::VALUE),
+   m_lexer(Lexer::NONE),
+   m_depth(0),
+   m_containers(0),
+   m_offset(0),
+   m_tokenIsKey(false),
+   m_tokenInBuffer(false),
+   m_tokenStart(0),
+   m_tokenLength(0),
+   m_unicodeDigits(0),
+   m_codeUnit(0),
+   m_highSurrogate(0)
+{
+}
+
+//------------------------------------------------------------------------------
+//! \brief Start over with a new document.
+void ArduinoHttpServer::AbstractJsonTokenizer::reset()
+{
+   m_error = Error::NONE;
+   m_expect = Expect::VALUE;
+   m_lexer = Lexer::NONE;
+   m_depth = 0;
+   m_containers = 0;
+   m_offset = 0;
+   m_tokenInBuffer = false;
+   m_tokenLength = 0;
+   m_highSurrogate = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Tokenize the next _length_ bytes of the document.
+//! \returns _length_, or the number of bytes accepted before an error.
+size_t ArduinoHttpServer::AbstractJsonTokenizer::feed(const char* data, size_t length)
+{
+   size_t index(0);
+   while (index < length && m_error == Error::NONE)
+   {
+      const char ch(data[index]);
+      switch (m_lexer)
+      {
+         case Lexer::NONE:
+            index = structural(data, length, index);
+            break;
+
+         case Lexer::STRING:
+            index = scanString(data, length, index);
+            break;
+
+         case Lexer::ESCAPE:
+            escaped(ch);
+            index += m_error == Error::NONE ? 1U : 0U;
+            break;
+
+         case Lexer::UNICODE:
+            unicodeDigit(ch);
+            index += m_error == Error::NONE ? 1U : 0U;
+            break;
+
+         case Lexer::NUMBER:
+         case Lexer::LITERAL:
+            if (m_lexer == Lexer::NUMBER ? isNumberChar(ch) : isLiteralChar(ch))
+            {
+               if (m_tokenInBuffer)
+               {
+                  appendToToken(&ch, 1);
+               }
+               ++index;
+            }
+            else
+            {
+               // The delimiter is handled as structural character next.
+               endScalar(data, index);
+            }
+            break;
+      }
+   }
+
+   // The chunk is gone after this call; keep the part of a token it holds.
+   if (m_error == Error::NONE && !m_tokenInBuffer &&
+       (m_lexer == Lexer::STRING || m_lexer == Lexer::NUMBER || m_lexer == Lexer::LITERAL))
+   {
+      moveTokenToBuffer(data, index);
+   }
+
+   m_offset += index;
+   return index;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Signal the end of the document.
+//! \details Needed to end a document which is a bare number or literal;
+//!    also reports a document which ended prematurely as INCOMPLETE.
+//! \returns True when a complete document was read without error.
+bool ArduinoHttpServer::AbstractJsonTokenizer::finish()
+{
+   if (m_error == Error::NONE && m_depth == 0 && (m_lexer == Lexer::NUMBER || m_lexer == Lexer::LITERAL))
+   {
+      // Feed moved the token into the buffer at the end of its last chunk.
+      endScalar(0, 0);
+   }
+
+   if (m_error == Error::NONE && !isComplete())
+   {
+      fail(Error::INCOMPLETE);
+   }
+   return m_error == Error::NONE;
+}
+
+size_t ArduinoHttpServer::AbstractJsonTokenizer::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+//! \returns _size_, or 0 once the document is in error so writers stop early.
+size_t ArduinoHttpServer::AbstractJsonTokenizer::write(const uint8_t* buffer, size_t size)
+{
+   feed(reinterpret_cast<const char*>(buffer), size);
+   return m_error == Error::NONE ? size : 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Handle a character outside of tokens.
+//! \returns Index of the next character to process.
+size_t ArduinoHttpServer::AbstractJsonTokenizer::structural(const char* data, size_t length, size_t index)
+{
+   const char ch(data[index]);
+   if (isWhitespace(ch))
+   {
+      return index + 1;
+   }
+
+   switch (ch)
+   {
+      case '{':
+      case '[':
+         if (!isValueExpected() || !push(ch == '{'))
+         {
+            break;
+         }
+         if (ch == '{')
+         {
+            m_handler.startObject();
+            m_expect = Expect::KEY_OR_END;
+         }
+         else
+         {
+            m_handler.startArray();
+            m_expect = Expect::VALUE_OR_END;
+         }
+         return index + 1;
+
+      case '}':
+         if (m_expect == Expect::KEY_OR_END || (m_expect == Expect::COMMA_OR_END && isInObject()))
+         {
+            --m_depth;
+            m_handler.endObject();
+            valueEnded();
+            return index + 1;
+         }
+         break;
+
+      case ']':
+         if (m_expect == Expect::VALUE_OR_END || (m_expect == Expect::COMMA_OR_END && m_depth > 0 && !isInObject()))
+         {
+            --m_depth;
+            m_handler.endArray();
+            valueEnded();
+            return index + 1;
+         }
+         break;
+
+      case ',':
+         if (m_expect == Expect::COMMA_OR_END)
+         {
+            m_expect = isInObject() ? Expect::KEY : Expect::VALUE;
+            return index + 1;
+         }
+         break;
+
+      case ':':
+         if (m_expect == Expect::COLON)
+         {
+            m_expect = Expect::VALUE;
+            return index + 1;
+         }
+         break;
+
+      case '"':
+         if (m_expect == Expect::KEY || m_expect == Expect::KEY_OR_END || isValueExpected())
+         {
+            m_tokenIsKey = !isValueExpected();
+            startToken(Lexer::STRING, index + 1);
+            return index + 1;
+         }
+         break;
+
+      default:
+         if (isValueExpected() && (isDigit(ch) || ch == '-'))
+         {
+            startToken(Lexer::NUMBER, index);
+            return index + 1;
+         }
+         if (isValueExpected() && isLiteralChar(ch))
+         {
+            startToken(Lexer::LITERAL, index);
+            return index + 1;
+         }
+         break;
+   }
+
+   if (m_error == Error::NONE)
+   {
+      fail(Error::SYNTAX);
+   }
+   return index;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Skip over plain string characters in one go.
+//! \returns Index of the next character to process.
+size_t ArduinoHttpServer::AbstractJsonTokenizer::scanString(const char* data, size_t length, size_t index)
+{
+   size_t end(index);
+   while (end < length && data[end] != '"' && data[end] != '\\' && static_cast<unsigned char>(data[end]) >= 0x20U)
+   {
+      ++end;
+   }
+
+   if (m_tokenInBuffer && end > index)
+   {
+      flushSurrogate();
+      appendToToken(data + index, end - index);
+   }
+
+   if (end == length || m_error != Error::NONE)
+   {
+      return end;
+   }
+
+   if (data[end] == '"')
+   {
+      endString(data, end);
+      return end + 1;
+   }
+   if (data[end] == '\\')
+   {
+      // Unescaped characters differ from the input; continue in the buffer.
+      moveTokenToBuffer(data, end);
+      m_lexer = Lexer::ESCAPE;
+      return end + 1;
+   }
+
+   fail(Error::SYNTAX); // Unescaped control character.
+   return end;
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::escaped(char ch)
+{
+   char decoded(ch);
+   switch (ch)
+   {
+      case '"':
+      case '\\':
+      case '/':
+         break;
+      case 'b': decoded = '\b'; break;
+      case 'f': decoded = '\f'; break;
+      case 'n': decoded = '\n'; break;
+      case 'r': decoded = '\r'; break;
+      case 't': decoded = '\t'; break;
+      case 'u':
+         m_lexer = Lexer::UNICODE;
+         m_unicodeDigits = 0;
+         m_codeUnit = 0;
+         return;
+      default:
+         fail(Error::SYNTAX);
+         return;
+   }
+
+   flushSurrogate();
+   appendToToken(&decoded, 1);
+   m_lexer = Lexer::STRING;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Collect a \\uXXXX escape and append it as UTF-8, combining surrogate pairs.
+void ArduinoHttpServer::AbstractJsonTokenizer::unicodeDigit(char ch)
+{
+   const int value(hexValue(ch));
+   if (value < 0)
+   {
+      fail(Error::SYNTAX);
+      return;
+   }
+
+   m_codeUnit = static_cast<uint16_t>((m_codeUnit << 4) | value);
+   if (++m_unicodeDigits < 4)
+   {
+      return;
+   }
+
+   m_lexer = Lexer::STRING;
+   if (m_codeUnit >= 0xD800U && m_codeUnit <= 0xDBFFU)
+   {
+      flushSurrogate();
+      m_highSurrogate = m_codeUnit;
+   }
+   else if (m_codeUnit >= 0xDC00U && m_codeUnit <= 0xDFFFU && m_highSurrogate != 0)
+   {
+      appendCodePoint(0x10000UL + ((static_cast<uint32_t>(m_highSurrogate) - 0xD800UL) << 10) + (m_codeUnit - 0xDC00UL));
+      m_highSurrogate = 0;
+   }
+   else
+   {
+      flushSurrogate();
+      appendCodePoint(m_codeUnit);
+   }
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::endString(const char* data, size_t index)
+{
+   flushSurrogate();
+   const char* pData(m_tokenInBuffer ? m_pTokenBuffer : data + m_tokenStart);
+   const size_t length(m_tokenInBuffer ? m_tokenLength : index - m_tokenStart);
+   m_lexer = Lexer::NONE;
+   m_tokenInBuffer = false;
+
+   if (m_error != Error::NONE)
+   {
+      return;
+   }
+
+   if (m_tokenIsKey)
+   {
+      m_handler.key(JsonToken(JsonToken::Type::KEY, pData, length));
+      m_expect = Expect::COLON;
+   }
+   else
+   {
+      m_handler.value(JsonToken(JsonToken::Type::STRING, pData, length));
+      valueEnded();
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief End a number or literal, which ends at the first character not
+//!    belonging to it, at _index_.
+void ArduinoHttpServer::AbstractJsonTokenizer::endScalar(const char* data, size_t index)
+{
+   const char* pData(m_tokenInBuffer ? m_pTokenBuffer : data + m_tokenStart);
+   const size_t length(m_tokenInBuffer ? m_tokenLength : index - m_tokenStart);
+   const bool number(m_lexer == Lexer::NUMBER);
+   m_lexer = Lexer::NONE;
+   m_tokenInBuffer = false;
+
+   JsonToken::Type type(JsonToken::Type::NUMBER);
+   if (number)
+   {
+      if (!isValidNumber(pData, length))
+      {
+         fail(Error::SYNTAX);
+         return;
+      }
+   }
+   else if (isLiteral(pData, length, "true") || isLiteral(pData, length, "false"))
+   {
+      type = JsonToken::Type::BOOLEAN;
+   }
+   else if (isLiteral(pData, length, "null"))
+   {
+      type = JsonToken::Type::NULL_VALUE;
+   }
+   else
+   {
+      fail(Error::SYNTAX);
+      return;
+   }
+
+   m_handler.value(JsonToken(type, pData, length));
+   valueEnded();
+}
+
+bool ArduinoHttpServer::AbstractJsonTokenizer::push(bool object)
+{
+   if (m_depth == MAX_DEPTH)
+   {
+      fail(Error::TOO_DEEP);
+      return false;
+   }
+
+   const uint32_t bit(1UL << m_depth);
+   m_containers = object ? (m_containers | bit) : (m_containers & ~bit);
+   ++m_depth;
+   return true;
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::valueEnded()
+{
+   m_expect = m_depth == 0 ? Expect::DONE : Expect::COMMA_OR_END;
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::startToken(Lexer lexer, size_t start)
+{
+   m_lexer = lexer;
+   m_tokenStart = start;
+   m_tokenInBuffer = false;
+   m_tokenLength = 0;
+   m_highSurrogate = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Copy the token's characters up to _end_ from the chunk into the
+//!    token buffer; it continues there.
+void ArduinoHttpServer::AbstractJsonTokenizer::moveTokenToBuffer(const char* data, size_t end)
+{
+   if (!m_tokenInBuffer)
+   {
+      m_tokenInBuffer = true;
+      m_tokenLength = 0;
+      appendToToken(data + m_tokenStart, end - m_tokenStart);
+   }
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::appendToToken(const char* data, size_t length)
+{
+   if (m_tokenLength + length > m_tokenBufferSize)
+   {
+      fail(Error::TOKEN_TOO_LONG);
+      return;
+   }
+   memcpy(m_pTokenBuffer + m_tokenLength, data, length);
+   m_tokenLength += length;
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::appendCodePoint(uint32_t codePoint)
+{
+   char utf8[4];
+   size_t length(0);
+   if (codePoint < 0x80UL)
+   {
+      utf8[length++] = static_cast<char>(codePoint);
+   }
+   else if (codePoint < 0x800UL)
+   {
+      utf8[length++] = static_cast<char>(0xC0 | (codePoint >> 6));
+      utf8[length++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+   }
+   else if (codePoint < 0x10000UL)
+   {
+      utf8[length++] = static_cast<char>(0xE0 | (codePoint >> 12));
+      utf8[length++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      utf8[length++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+   }
+   else
+   {
+      utf8[length++] = static_cast<char>(0xF0 | (codePoint >> 18));
+      utf8[length++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      utf8[length++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      utf8[length++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+   }
+   appendToToken(utf8, length);
+}
+
+//! \brief Append a high surrogate which is not followed by a low one as is.
+void ArduinoHttpServer::AbstractJsonTokenizer::flushSurrogate()
+{
+   if (m_highSurrogate != 0)
+   {
+      const uint16_t codeUnit(m_highSurrogate);
+      m_highSurrogate = 0;
+      appendCodePoint(codeUnit);
+   }
+}
+
+void ArduinoHttpServer::AbstractJsonTokenizer::fail(Error error)
+{
+   DEBUG_ARDUINO_HTTP_SERVER_PRINT("JSON error at offset ");
+   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(m_offset);
+   m_error = error;
+}
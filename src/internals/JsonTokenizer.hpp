@@ -0,0 +1,202 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Incremental, event driven (SAX style) JSON tokenizer.
+
+#ifndef __ArduinoHttpServer__JsonTokenizer__
+#define __ArduinoHttpServer__JsonTokenizer__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Key or scalar value reported by the tokenizer.
+//! \details A view: the data is not zero terminated and only valid during
+//!    the callback it is passed to. Strings are unescaped.
+class JsonToken
+{
+
+public:
+   enum class Type : char
+   {
+      KEY,
+      STRING,
+      NUMBER,
+      BOOLEAN,
+      NULL_VALUE
+   };
+
+   JsonToken(Type type, const char* pData, size_t length) :
+      m_type(type), m_pData(pData), m_length(length) {};
+
+   inline Type getType() const { return m_type; };
+   inline const char* getData() const { return m_pData; };
+   inline size_t getLength() const { return m_length; };
+
+   bool equals(const char* text) const;
+   long toLong() const;
+   double toDouble() const;
+   inline bool toBool() const { return m_type == Type::BOOLEAN && m_pData[0] == 't'; };
+   String toString() const;
+
+private:
+   Type m_type;
+   const char* m_pData;
+   size_t m_length;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Receives the structure and values of a JSON document in document order.
+//! \details Override what is needed. Object members are reported as key()
+//!    followed by the value, which may be an object or array itself.
+class AbstractJsonHandler
+{
+
+public:
+   virtual ~AbstractJsonHandler() {};
+
+   virtual void startObject() {};
+   virtual void endObject() {};
+   virtual void startArray() {};
+   virtual void endArray() {};
+   virtual void key(const JsonToken& key) {};
+   virtual void value(const JsonToken& value) {};
+
+protected:
+   AbstractJsonHandler() {};
+
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Tokenizes a JSON document fed in chunks of any size, e.g. a request body
+//! as it arrives, and reports it to an AbstractJsonHandler.
+//! \details Uses constant RAM: a nesting stack of MAX_DEPTH bits and a token
+//!    buffer. Tokens which lie completely within one chunk and need no
+//!    unescaping are reported as views into the chunk; only tokens split
+//!    across chunks or containing escapes are copied into the token buffer,
+//!    which limits their length. Being a Print, it can be handed to
+//!    StreamHttpRequest::streamBody() directly.
+class AbstractJsonTokenizer: public Print
+{
+
+public:
+   enum class Error : char
+   {
+      NONE,
+      SYNTAX,
+      TOO_DEEP,
+      TOKEN_TOO_LONG,
+      INCOMPLETE
+   };
+
+   static const uint8_t MAX_DEPTH = 32U;
+
+   size_t feed(const char* data, size_t length);
+   bool finish();
+   void reset();
+
+   // Print interface, so bodies and files can be written to the tokenizer.
+   using Print::write;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+
+   inline Error getError() const { return m_error; };
+   inline size_t getErrorOffset() const { return m_offset; }; //!< Bytes accepted before the error.
+   inline bool isComplete() const { return m_expect == Expect::DONE && m_lexer == Lexer::NONE; };
+   inline uint8_t getDepth() const { return m_depth; };
+
+protected:
+   AbstractJsonTokenizer(AbstractJsonHandler& handler, char* pTokenBuffer, size_t tokenBufferSize);
+
+private:
+   //! What the grammar allows next, outside of tokens.
+   enum class Expect : char
+   {
+      VALUE,
+      VALUE_OR_END,
+      KEY,
+      KEY_OR_END,
+      COLON,
+      COMMA_OR_END,
+      DONE
+   };
+
+   //! Token being scanned.
+   enum class Lexer : char
+   {
+      NONE,
+      STRING,
+      ESCAPE,
+      UNICODE,
+      NUMBER,
+      LITERAL
+   };
+
+   size_t structural(const char* data, size_t length, size_t index);
+   size_t scanString(const char* data, size_t length, size_t index);
+   void escaped(char ch);
+   void unicodeDigit(char ch);
+   void endString(const char* data, size_t index);
+   void endScalar(const char* data, size_t index);
+
+   bool isValueExpected() const { return m_expect == Expect::VALUE || m_expect == Expect::VALUE_OR_END; };
+   bool isInObject() const { return m_depth > 0 && (m_containers & (1UL << (m_depth - 1))) != 0; };
+   bool push(bool object);
+   void valueEnded();
+   void startToken(Lexer lexer, size_t start);
+   void moveTokenToBuffer(const char* data, size_t end);
+   void appendToToken(const char* data, size_t length);
+   void appendCodePoint(uint32_t codePoint);
+   void flushSurrogate();
+   void fail(Error error);
+
+   AbstractJsonHandler& m_handler;
+   char* const m_pTokenBuffer;
+   const size_t m_tokenBufferSize;
+
+   Error m_error;
+   Expect m_expect;
+   Lexer m_lexer;
+   uint8_t m_depth;
+   uint32_t m_containers; //!< Bit per nesting level, set for objects.
+   size_t m_offset;
+
+   bool m_tokenIsKey;
+   bool m_tokenInBuffer; //!< Token copied into the buffer, else it starts at m_tokenStart in the chunk.
+   size_t m_tokenStart;
+   size_t m_tokenLength;
+   uint8_t m_unicodeDigits;
+   uint16_t m_codeUnit;
+   uint16_t m_highSurrogate;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Tokenizer with room for split or escaped tokens of up to MAX_TOKEN_SIZE bytes.
+template <size_t MAX_TOKEN_SIZE = 64>
+class JsonTokenizer: public AbstractJsonTokenizer
+{
+
+public:
+   JsonTokenizer(AbstractJsonHandler& handler) : AbstractJsonTokenizer(handler, m_tokenBuffer, MAX_TOKEN_SIZE) {};
+
+private:
+   char m_tokenBuffer[MAX_TOKEN_SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__JsonTokenizer__
@@ -0,0 +1,249 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming JSON writer.
+
+#include "JsonWriter.hpp"
+
+#include <math.h>
+
+ArduinoHttpServer::AbstractJsonWriter::AbstractJsonWriter(Print* pOut, char* pBuffer, size_t bufferSize) :
+   m_pOut(pOut),
+   m_pBuffer(pBuffer),
+   m_bufferSize(bufferSize),
+   m_bufferLength(0),
+   m_length(0),
+   m_depth(0),
+   m_hasElements(0),
+   m_afterKey(false)
+{
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::beginObject()
+{
+   separator();
+   write('{');
+   push();
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::endObject()
+{
+   pop();
+   write('}');
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::beginArray()
+{
+   separator();
+   write('[');
+   push();
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::endArray()
+{
+   pop();
+   write(']');
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write an object member's name; its value is written next.
+void ArduinoHttpServer::AbstractJsonWriter::key(const char* name)
+{
+   separator();
+   write('"');
+   writeEscaped(name, strlen(name));
+   write(reinterpret_cast<const uint8_t*>("\":"), 2);
+   m_afterKey = true;
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::value(const char* text)
+{
+   if (!text)
+   {
+      nullValue();
+      return;
+   }
+   value(text, strlen(text));
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::value(const char* text, size_t length)
+{
+   separator();
+   write('"');
+   writeEscaped(text, length);
+   write('"');
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::value(long number)
+{
+   separator();
+   print(number);
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::value(unsigned long number)
+{
+   separator();
+   print(number);
+}
+
+//! \brief Write _number_ with _digits_ decimals; NaN and infinity, which JSON
+//!    cannot represent, become null.
+void ArduinoHttpServer::AbstractJsonWriter::value(double number, int digits)
+{
+   if (isnan(number) || isinf(number))
+   {
+      nullValue();
+      return;
+   }
+   separator();
+   print(number, digits);
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::value(bool flag)
+{
+   separator();
+   if (flag)
+   {
+      write(reinterpret_cast<const uint8_t*>("true"), 4);
+   }
+   else
+   {
+      write(reinterpret_cast<const uint8_t*>("false"), 5);
+   }
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::nullValue()
+{
+   separator();
+   write(reinterpret_cast<const uint8_t*>("null"), 4);
+}
+
+size_t ArduinoHttpServer::AbstractJsonWriter::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+size_t ArduinoHttpServer::AbstractJsonWriter::write(const uint8_t* buffer, size_t size)
+{
+   m_length += size;
+   if (!m_pOut)
+   {
+      return size;
+   }
+
+   size_t remaining(size);
+   while (remaining > 0)
+   {
+      const size_t space(m_bufferSize - m_bufferLength);
+      const size_t part(remaining < space ? remaining : space);
+      memcpy(m_pBuffer + m_bufferLength, buffer, part);
+      m_bufferLength += part;
+      buffer += part;
+      remaining -= part;
+      if (m_bufferLength == m_bufferSize)
+      {
+         flush();
+      }
+   }
+   return size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Pass buffered output on. Does not flush the output itself.
+void ArduinoHttpServer::AbstractJsonWriter::flush()
+{
+   if (m_pOut && m_bufferLength > 0)
+   {
+      m_pOut->write(reinterpret_cast<const uint8_t*>(m_pBuffer), m_bufferLength);
+   }
+   m_bufferLength = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write the comma before all but the first element of a container.
+void ArduinoHttpServer::AbstractJsonWriter::separator()
+{
+   if (m_afterKey)
+   {
+      m_afterKey = false;
+      return;
+   }
+   if (m_depth == 0 || m_depth > MAX_DEPTH)
+   {
+      return;
+   }
+
+   const uint32_t bit(1UL << (m_depth - 1));
+   if (m_hasElements & bit)
+   {
+      write(',');
+   }
+   m_hasElements |= bit;
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::push()
+{
+   ++m_depth;
+   if (m_depth <= MAX_DEPTH)
+   {
+      m_hasElements &= ~(1UL << (m_depth - 1));
+   }
+}
+
+void ArduinoHttpServer::AbstractJsonWriter::pop()
+{
+   if (m_depth > 0)
+   {
+      --m_depth;
+   }
+   m_afterKey = false;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write _text_ with quotes, backslashes and control characters escaped.
+//! \details Runs of characters needing no escape are written in one go.
+void ArduinoHttpServer::AbstractJsonWriter::writeEscaped(const char* text, size_t length)
+{
+   static const char HEX_DIGITS[] = "0123456789abcdef";
+
+   size_t runStart(0);
+   for (size_t i=0; i < length; ++i)
+   {
+      const unsigned char ch(static_cast<unsigned char>(text[i]));
+      if (ch >= 0x20U && ch != '"' && ch != '\\')
+      {
+         continue;
+      }
+
+      write(reinterpret_cast<const uint8_t*>(text + runStart), i - runStart);
+      runStart = i + 1;
+
+      char escape[6] = { '\\', static_cast<char>(ch), 0, 0, 0, 0 };
+      size_t escapeLength(2);
+      switch (ch)
+      {
+         case '"':
+         case '\\':
+            break;
+         case '\b': escape[1] = 'b'; break;
+         case '\f': escape[1] = 'f'; break;
+         case '\n': escape[1] = 'n'; break;
+         case '\r': escape[1] = 'r'; break;
+         case '\t': escape[1] = 't'; break;
+         default:
+            escape[1] = 'u';
+            escape[2] = '0';
+            escape[3] = '0';
+            escape[4] = HEX_DIGITS[ch >> 4];
+            escape[5] = HEX_DIGITS[ch & 0x0F];
+            escapeLength = 6;
+            break;
+      }
+      write(reinterpret_cast<const uint8_t*>(escape), escapeLength);
+   }
+   write(reinterpret_cast<const uint8_t*>(text + runStart), length - runStart);
+}
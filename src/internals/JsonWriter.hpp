@@ -0,0 +1,101 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming JSON writer.
+
+#ifndef __ArduinoHttpServer__JsonWriter__
+#define __ArduinoHttpServer__JsonWriter__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Writes a JSON document through a small buffer to a Print, e.g. a reply's
+//! Stream or a StreamHttpChunkedReply.
+//! \details Commas and colons are inserted automatically, strings are escaped
+//!    on the fly; nothing is allocated. Without output the writer only
+//!    counts, so the same code can determine a Content-Length first. Nesting
+//!    is tracked up to MAX_DEPTH levels. Being a Print itself, raw JSON can
+//!    be written in between with print().
+class AbstractJsonWriter: public Print
+{
+
+public:
+   static const uint8_t MAX_DEPTH = 32U;
+
+   void beginObject();
+   void endObject();
+   void beginArray();
+   void endArray();
+
+   void key(const char* name);
+   void key(const String& name) { key(name.c_str()); };
+
+   void value(const char* text);
+   void value(const char* text, size_t length);
+   void value(const String& text) { value(text.c_str(), text.length()); };
+   void value(long number);
+   void value(unsigned long number);
+   void value(int number) { value(static_cast<long>(number)); };
+   void value(unsigned int number) { value(static_cast<unsigned long>(number)); };
+   void value(double number, int digits = 2);
+   void value(bool flag);
+   void nullValue();
+
+   // Print interface; raw output without separators or escaping.
+   using Print::write;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   virtual void flush();
+
+   inline size_t getLength() const { return m_length; }; //!< Bytes written so far, including buffered ones.
+
+protected:
+   AbstractJsonWriter(Print* pOut, char* pBuffer, size_t bufferSize);
+
+private:
+   void separator();
+   void push();
+   void pop();
+   void writeEscaped(const char* text, size_t length);
+
+   Print* const m_pOut;
+   char* const m_pBuffer;
+   const size_t m_bufferSize;
+   size_t m_bufferLength;
+   size_t m_length;
+
+   uint8_t m_depth;
+   uint32_t m_hasElements; //!< Bit per nesting level, set once it holds an element.
+   bool m_afterKey;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! JSON writer with a BUFFER_SIZE bytes output buffer; flushed on destruction.
+template <size_t BUFFER_SIZE = 64>
+class JsonWriter: public AbstractJsonWriter
+{
+
+public:
+   JsonWriter(Print& out) : AbstractJsonWriter(&out, m_buffer, BUFFER_SIZE) {};
+   //! Count only, see getLength().
+   JsonWriter() : AbstractJsonWriter(0, m_buffer, BUFFER_SIZE) {};
+   ~JsonWriter() { flush(); };
+
+private:
+   char m_buffer[BUFFER_SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__JsonWriter__
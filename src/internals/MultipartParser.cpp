@@ -0,0 +1,387 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming multipart/form-data parser.
+
+#include "MultipartParser.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+#include <strings.h>
+
+namespace
+{
+   inline bool isSpace(char ch) { return ch == ' ' || ch == '\t'; }
+
+   //! Copy a parameter value, quoted or up to the next ';', into _pOut_.
+   //! \returns Position after the value.
+   const char* copyValue(const char* pValue, char* pOut, size_t outSize)
+   {
+      const bool quoted(*pValue == '"');
+      if (quoted)
+      {
+         ++pValue;
+      }
+
+      size_t length(0);
+      while (*pValue && (quoted ? *pValue != '"' : *pValue != ';'))
+      {
+         if (length < outSize - 1)
+         {
+            pOut[length++] = *pValue;
+         }
+         ++pValue;
+      }
+      while (!quoted && length > 0 && isSpace(pOut[length - 1]))
+      {
+         --length;
+      }
+      pOut[length] = '\0';
+
+      return quoted && *pValue ? pValue + 1 : pValue;
+   }
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::MultipartParser::MultipartParser(AbstractMultipartHandler& handler) :
+   m_handler(handler),
+   m_state(State::FAILED),
+   m_error(Error::NO_BOUNDARY),
+   m_delimiter{0},
+   m_delimiterLength(0),
+   m_skip{0},
+   m_matched(0),
+   m_line{0},
+   m_lineLength(0),
+   m_name{0},
+   m_filename{0},
+   m_contentType{0}
+{
+}
+
+//------------------------------------------------------------------------------
+//! \brief Take the boundary from the request's Content-Type and start over.
+//! \returns False when it is not a multipart type with a valid boundary.
+bool ArduinoHttpServer::MultipartParser::begin(const char* contentType)
+{
+   static const char MULTIPART[] = "multipart/";
+   static const char BOUNDARY[] = "boundary=";
+
+   m_error = Error::NONE;
+   m_state = State::PREAMBLE;
+   m_lineLength = 0;
+   // The body may start with the delimiter right away, without the CRLF
+   // which precedes it everywhere else: take that CRLF as matched.
+   m_matched = 2;
+
+   const char* pBoundary(0);
+   if (strncasecmp(contentType, MULTIPART, sizeof(MULTIPART) - 1) == 0)
+   {
+      for (const char* p=contentType; *p && !pBoundary; ++p)
+      {
+         if ((p == contentType || p[-1] == ';' || isSpace(p[-1])) && strncasecmp(p, BOUNDARY, sizeof(BOUNDARY) - 1) == 0)
+         {
+            pBoundary = p + sizeof(BOUNDARY) - 1;
+         }
+      }
+   }
+
+   char boundary[MAX_BOUNDARY_SIZE + 2];
+   if (pBoundary)
+   {
+      copyValue(pBoundary, boundary, sizeof(boundary));
+   }
+
+   const size_t boundaryLength(pBoundary ? strlen(boundary) : 0U);
+   if (boundaryLength == 0 || boundaryLength > MAX_BOUNDARY_SIZE)
+   {
+      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("No multipart boundary.");
+      fail(Error::NO_BOUNDARY);
+      return false;
+   }
+
+   memcpy(m_delimiter, "\r\n--", 4);
+   memcpy(m_delimiter + 4, boundary, boundaryLength);
+   m_delimiterLength = static_cast<uint8_t>(4 + boundaryLength);
+
+   // Horspool: shift by the distance of the window's last byte to its last
+   // occurrence in the delimiter, excluding the delimiter's last byte.
+   memset(m_skip, m_delimiterLength, sizeof(m_skip));
+   for (size_t i=0; i + 1 < m_delimiterLength; ++i)
+   {
+      m_skip[static_cast<uint8_t>(m_delimiter[i])] = static_cast<uint8_t>(m_delimiterLength - 1 - i);
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Parse the next _length_ bytes of the body.
+//! \returns _length_, or the number of bytes accepted before an error.
+size_t ArduinoHttpServer::MultipartParser::feed(const char* data, size_t length)
+{
+   size_t index(0);
+   while (index < length)
+   {
+      switch (m_state)
+      {
+         case State::PREAMBLE:
+         case State::DATA:
+            index += scanData(data + index, length - index);
+            break;
+
+         case State::DELIMITER_SUFFIX:
+         case State::DELIMITER_DASH:
+         case State::DELIMITER_LF:
+            index += delimiterSuffix(data[index]);
+            break;
+
+         case State::HEADERS:
+            headerByte(data[index]);
+            ++index;
+            break;
+
+         case State::END:
+            return length; // Epilogue, ignored.
+
+         case State::FAILED:
+            return index;
+      }
+   }
+   return length;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Signal the end of the body.
+//! \returns True when the closing delimiter was seen without error.
+bool ArduinoHttpServer::MultipartParser::finish()
+{
+   if (m_state != State::END && m_state != State::FAILED)
+   {
+      fail(Error::INCOMPLETE);
+   }
+   return m_error == Error::NONE;
+}
+
+size_t ArduinoHttpServer::MultipartParser::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+//! \returns _size_, or 0 after an error so writers stop early.
+size_t ArduinoHttpServer::MultipartParser::write(const uint8_t* buffer, size_t size)
+{
+   feed(reinterpret_cast<const char*>(buffer), size);
+   return m_state == State::FAILED ? 0 : size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Pass content on up to the next delimiter.
+//! \details Content which could be the start of a delimiter continuing in the
+//!    next chunk is withheld. It is always a prefix of the delimiter, so it
+//!    does not need to be stored: m_matched says how much of it.
+//! \returns Bytes consumed, including a delimiter found.
+size_t ArduinoHttpServer::MultipartParser::scanData(const char* data, size_t length)
+{
+   size_t from(0);
+   if (m_matched > 0)
+   {
+      size_t count(0);
+      while (count < length && m_matched + count < m_delimiterLength && data[count] == m_delimiter[m_matched + count])
+      {
+         ++count;
+      }
+
+      if (m_matched + count == m_delimiterLength)
+      {
+         m_matched = 0;
+         delimiterFound();
+         return count;
+      }
+      if (count == length)
+      {
+         m_matched = static_cast<uint8_t>(m_matched + count);
+         return length;
+      }
+
+      // No delimiter after all. It starts with the only CR of the delimiter,
+      // so none can start within the bytes matched.
+      emit(m_delimiter, m_matched);
+      m_matched = 0;
+      from = count;
+   }
+
+   size_t withheld(0);
+   size_t position(from);
+   const size_t last(m_delimiterLength - 1U);
+   while (position + last < length)
+   {
+      size_t i(last);
+      while (data[position + i] == m_delimiter[i])
+      {
+         if (i == 0)
+         {
+            emit(data, position);
+            delimiterFound();
+            return position + m_delimiterLength;
+         }
+         --i;
+      }
+      position += m_skip[static_cast<uint8_t>(data[position + last])];
+   }
+
+   // The earliest CR from which the rest of the chunk matches the delimiter.
+   for (; position < length; ++position)
+   {
+      if (data[position] == '\r' && memcmp(data + position, m_delimiter, length - position) == 0)
+      {
+         withheld = length - position;
+         break;
+      }
+   }
+
+   emit(data, length - withheld);
+   m_matched = static_cast<uint8_t>(withheld);
+   return length;
+}
+
+//------------------------------------------------------------------------------
+//! \returns Bytes consumed, 1 or 0 on error.
+size_t ArduinoHttpServer::MultipartParser::delimiterSuffix(char ch)
+{
+   if (m_state == State::DELIMITER_SUFFIX && ch == '-')
+   {
+      m_state = State::DELIMITER_DASH;
+   }
+   else if (m_state == State::DELIMITER_SUFFIX && ch == '\r')
+   {
+      m_state = State::DELIMITER_LF;
+   }
+   else if (m_state == State::DELIMITER_SUFFIX && isSpace(ch))
+   {
+      // Transport padding.
+   }
+   else if (m_state == State::DELIMITER_DASH && ch == '-')
+   {
+      m_state = State::END;
+   }
+   else if (m_state == State::DELIMITER_LF && ch == '\n')
+   {
+      m_state = State::HEADERS;
+      m_lineLength = 0;
+      m_name[0] = '\0';
+      m_filename[0] = '\0';
+      m_contentType[0] = '\0';
+   }
+   else
+   {
+      fail(Error::SYNTAX);
+      return 0;
+   }
+   return 1;
+}
+
+void ArduinoHttpServer::MultipartParser::headerByte(char ch)
+{
+   if (ch != '\n')
+   {
+      if (m_lineLength < MAX_HEADER_LINE_SIZE - 1)
+      {
+         m_line[m_lineLength++] = ch;
+      }
+      return;
+   }
+
+   if (m_lineLength > 0 && m_line[m_lineLength - 1] == '\r')
+   {
+      --m_lineLength;
+   }
+   m_line[m_lineLength] = '\0';
+
+   if (m_lineLength == 0)
+   {
+      m_state = State::DATA;
+      m_matched = 0;
+      m_handler.partBegin(m_name, m_filename, m_contentType);
+   }
+   else
+   {
+      parseHeaderLine();
+      m_lineLength = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Take name and filename from Content-Disposition, and Content-Type.
+void ArduinoHttpServer::MultipartParser::parseHeaderLine()
+{
+   static const char DISPOSITION[] = "content-disposition:";
+   static const char TYPE[] = "content-type:";
+   static const char NAME[] = "name=";
+   static const char FILENAME[] = "filename=";
+
+   if (strncasecmp(m_line, TYPE, sizeof(TYPE) - 1) == 0)
+   {
+      const char* pValue(m_line + sizeof(TYPE) - 1);
+      while (isSpace(*pValue)) { ++pValue; }
+      copyValue(pValue, m_contentType, sizeof(m_contentType));
+      return;
+   }
+
+   if (strncasecmp(m_line, DISPOSITION, sizeof(DISPOSITION) - 1) != 0)
+   {
+      return;
+   }
+
+   // form-data; name="field"; filename="file.bin"
+   const char* p(strchr(m_line, ';'));
+   while (p && *p)
+   {
+      while (*p == ';' || isSpace(*p)) { ++p; }
+
+      if (strncasecmp(p, NAME, sizeof(NAME) - 1) == 0)
+      {
+         p = copyValue(p + sizeof(NAME) - 1, m_name, sizeof(m_name));
+      }
+      else if (strncasecmp(p, FILENAME, sizeof(FILENAME) - 1) == 0)
+      {
+         p = copyValue(p + sizeof(FILENAME) - 1, m_filename, sizeof(m_filename));
+      }
+      else
+      {
+         char ignored[2];
+         const char* pValue(strchr(p, '='));
+         p = pValue ? copyValue(pValue + 1, ignored, sizeof(ignored)) : 0;
+      }
+
+      p = p ? strchr(p, ';') : 0;
+   }
+}
+
+void ArduinoHttpServer::MultipartParser::emit(const char* data, size_t length)
+{
+   if (m_state == State::DATA && length > 0)
+   {
+      m_handler.partData(data, length);
+   }
+}
+
+void ArduinoHttpServer::MultipartParser::delimiterFound()
+{
+   if (m_state == State::DATA)
+   {
+      m_handler.partEnd();
+   }
+   m_state = State::DELIMITER_SUFFIX;
+}
+
+void ArduinoHttpServer::MultipartParser::fail(Error error)
+{
+   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("Multipart parse error.");
+   m_error = error;
+   m_state = State::FAILED;
+}
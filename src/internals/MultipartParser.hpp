@@ -0,0 +1,119 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming multipart/form-data parser.
+
+#ifndef __ArduinoHttpServer__MultipartParser__
+#define __ArduinoHttpServer__MultipartParser__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Receives the parts of a multipart body as they arrive.
+class AbstractMultipartHandler
+{
+
+public:
+   virtual ~AbstractMultipartHandler() {};
+
+   //! A part starts. _filename_ is empty for plain form fields.
+   virtual void partBegin(const char* name, const char* filename, const char* contentType) {};
+   //! Next piece of the current part's content; called any number of times.
+   virtual void partData(const char* data, size_t length) {};
+   virtual void partEnd() {};
+
+protected:
+   AbstractMultipartHandler() {};
+
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Splits a multipart/form-data body fed in chunks of any size into parts,
+//! streaming their content to an AbstractMultipartHandler.
+//! \details The delimiter is searched Boyer-Moore-Horspool style, skipping up
+//!    to its length per comparison, so large uploads (files, firmware images)
+//!    pass at close to memory speed. Part content is passed on straight from
+//!    the fed chunks; RAM use is constant. Being a Print, it can be handed to
+//!    StreamHttpRequest::streamBody() directly.
+class MultipartParser: public Print
+{
+
+public:
+   enum class Error : char
+   {
+      NONE,
+      NO_BOUNDARY,
+      SYNTAX,
+      INCOMPLETE
+   };
+
+   static const size_t MAX_BOUNDARY_SIZE = 70U; //!< RFC 2046.
+   static const size_t MAX_HEADER_LINE_SIZE = 128U; //!< Longer part header lines are truncated.
+   static const size_t MAX_NAME_SIZE = 48U; //!< Longer names, filenames and content types are truncated.
+
+   MultipartParser(AbstractMultipartHandler& handler);
+
+   bool begin(const char* contentType);
+   bool begin(const String& contentType) { return begin(contentType.c_str()); };
+   size_t feed(const char* data, size_t length);
+   bool finish();
+
+   // Print interface, so bodies can be written to the parser.
+   using Print::write;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+
+   inline Error getError() const { return m_error; };
+   inline bool isComplete() const { return m_state == State::END; };
+
+private:
+   enum class State : char
+   {
+      PREAMBLE,
+      DELIMITER_SUFFIX, //!< After a delimiter: "--" ends the body, CRLF starts a part.
+      DELIMITER_DASH,
+      DELIMITER_LF,
+      HEADERS,
+      DATA,
+      END,
+      FAILED
+   };
+
+   size_t scanData(const char* data, size_t length);
+   size_t delimiterSuffix(char ch);
+   void headerByte(char ch);
+   void parseHeaderLine();
+   void emit(const char* data, size_t length);
+   void delimiterFound();
+   void fail(Error error);
+
+   AbstractMultipartHandler& m_handler;
+   State m_state;
+   Error m_error;
+
+   char m_delimiter[4 + MAX_BOUNDARY_SIZE]; //!< "\r\n--" boundary.
+   uint8_t m_delimiterLength;
+   uint8_t m_skip[256]; //!< Horspool shift per byte value.
+   uint8_t m_matched; //!< Delimiter prefix matched at the end of the previous chunk.
+
+   char m_line[MAX_HEADER_LINE_SIZE];
+   size_t m_lineLength;
+   char m_name[MAX_NAME_SIZE];
+   char m_filename[MAX_NAME_SIZE];
+   char m_contentType[MAX_NAME_SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__MultipartParser__
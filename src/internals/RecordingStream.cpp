@@ -0,0 +1,294 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Capture of inbound connection data and its timing, for replay on a host.
+
+#include "RecordingStream.hpp"
+#include "StreamHttpReply.hpp"
+
+namespace
+{
+   size_t encodeVarint(uint8_t* pOut, unsigned long value)
+   {
+      size_t length(0);
+      do
+      {
+         uint8_t byte(value & 0x7FU);
+         value >>= 7;
+         if (value != 0)
+         {
+            byte |= 0x80U;
+         }
+         pOut[length++] = byte;
+      } while (value != 0);
+      return length;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Decode a number of the capture format.
+//! \return Bytes used by the number at _pIn_, 0 when it is incomplete.
+size_t ArduinoHttpServer::decodeRecordingVarint(const uint8_t* pIn, size_t available, unsigned long& value)
+{
+   value = 0;
+   for (size_t i=0; i < available && i < RECORDING_MAX_VARINT_SIZE; ++i)
+   {
+      value |= static_cast<unsigned long>(pIn[i] & 0x7FU) << (7 * i);
+      if ((pIn[i] & 0x80U) == 0)
+      {
+         return i + 1;
+      }
+   }
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Constructor. Writes the connection record to _sink_.
+ArduinoHttpServer::RecordingStream::RecordingStream(Stream& stream, Print& sink) :
+   m_stream(stream),
+   m_sink(sink),
+   m_previousRecordUs(micros()),
+   m_pendingUs(0),
+   m_lastReadUs(0),
+   m_pending(),
+   m_pendingLength(0)
+{
+   uint8_t record[1 + RECORDING_MAX_VARINT_SIZE];
+   record[0] = RECORDING_TAG_CONNECTION;
+   const size_t length(1 + encodeVarint(record + 1, millis()));
+   m_sink.write(record, length);
+}
+
+ArduinoHttpServer::RecordingStream::~RecordingStream()
+{
+   endRecording();
+}
+
+int ArduinoHttpServer::RecordingStream::available()
+{
+   return m_stream.available();
+}
+
+int ArduinoHttpServer::RecordingStream::read()
+{
+   const int c(m_stream.read());
+   if (c >= 0)
+   {
+      const char byte(static_cast<char>(c));
+      record(&byte, 1);
+   }
+   return c;
+}
+
+int ArduinoHttpServer::RecordingStream::peek()
+{
+   return m_stream.peek();
+}
+
+size_t ArduinoHttpServer::RecordingStream::readBytes(char* buffer, size_t length)
+{
+   const size_t count(m_stream.readBytes(buffer, length));
+   record(buffer, count);
+   return count;
+}
+
+#ifdef STREAMSEND_API
+//------------------------------------------------------------------------------
+//! \brief Record the consumed bytes while they are still in the wrapped stream's buffer.
+void ArduinoHttpServer::RecordingStream::peekConsume(size_t consume)
+{
+   record(m_stream.peekBuffer(), consume);
+   m_stream.peekConsume(consume);
+}
+#endif
+
+size_t ArduinoHttpServer::RecordingStream::write(uint8_t byte)
+{
+   endRecording();
+   return m_stream.write(byte);
+}
+
+size_t ArduinoHttpServer::RecordingStream::write(const uint8_t* buffer, size_t size)
+{
+   endRecording();
+   return m_stream.write(buffer, size);
+}
+
+int ArduinoHttpServer::RecordingStream::availableForWrite()
+{
+   return m_stream.availableForWrite();
+}
+
+void ArduinoHttpServer::RecordingStream::flush()
+{
+   m_stream.flush();
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write the data collected so far. Further reads are still recorded.
+void ArduinoHttpServer::RecordingStream::endRecording()
+{
+   if (m_pendingLength > 0)
+   {
+      writeRecord();
+   }
+}
+
+void ArduinoHttpServer::RecordingStream::record(const char* buffer, size_t length)
+{
+   const unsigned long nowUs(micros());
+   if (m_pendingLength > 0 && nowUs - m_lastReadUs > RECORD_GAP_US)
+   {
+      writeRecord();
+   }
+   m_lastReadUs = nowUs;
+
+   while (length > 0)
+   {
+      if (m_pendingLength == 0)
+      {
+         m_pendingUs = nowUs;
+      }
+
+      size_t count(RECORD_DATA_SIZE - m_pendingLength);
+      if (count > length)
+      {
+         count = length;
+      }
+      memcpy(m_pending + m_pendingLength, buffer, count);
+      m_pendingLength += count;
+      buffer += count;
+      length -= count;
+
+      if (m_pendingLength == RECORD_DATA_SIZE)
+      {
+         writeRecord();
+      }
+   }
+}
+
+void ArduinoHttpServer::RecordingStream::writeRecord()
+{
+   uint8_t record[1 + 2 * RECORDING_MAX_VARINT_SIZE + RECORD_DATA_SIZE];
+   size_t length(0);
+   record[length++] = RECORDING_TAG_DATA;
+   length += encodeVarint(record + length, m_pendingUs - m_previousRecordUs);
+   length += encodeVarint(record + length, m_pendingLength);
+   memcpy(record + length, m_pending, m_pendingLength);
+   length += m_pendingLength;
+
+   m_sink.write(record, length);
+   m_previousRecordUs = m_pendingUs;
+   m_pendingLength = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Constructor. _pStorage_ has to outlive the buffer.
+ArduinoHttpServer::AbstractRecordingBuffer::AbstractRecordingBuffer(uint8_t* pStorage, size_t size) :
+   m_storage(pStorage),
+   m_size(size),
+   m_length(0),
+   m_droppedRecords(0)
+{
+
+}
+
+size_t ArduinoHttpServer::AbstractRecordingBuffer::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Append one complete record, dropping the oldest connections as needed.
+//! \return _size_ when stored, 0 when the record was dropped.
+size_t ArduinoHttpServer::AbstractRecordingBuffer::write(const uint8_t* buffer, size_t size)
+{
+   while (m_length + size > m_size)
+   {
+      if (!dropOldestConnection())
+      {
+         ++m_droppedRecords;
+         return 0;
+      }
+   }
+
+   memcpy(m_storage + m_length, buffer, size);
+   m_length += size;
+   return size;
+}
+
+void ArduinoHttpServer::AbstractRecordingBuffer::clear()
+{
+   m_length = 0;
+   m_droppedRecords = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Reply with the capture, e.g. when "/debug/capture" is requested.
+void ArduinoHttpServer::AbstractRecordingBuffer::sendReply(Stream& stream, Method method) const
+{
+   StreamHttpReply httpReply(stream, "application/octet-stream", method);
+   // No Content-Length; the body ends when the connection is closed.
+   httpReply.sendHeader(0);
+   if (httpReply.hasBody())
+   {
+      stream.write(m_storage, m_length);
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Remove the first connection, keeping the one currently recorded.
+//! \return false when there is no older connection to drop.
+bool ArduinoHttpServer::AbstractRecordingBuffer::dropOldestConnection()
+{
+   size_t offset(recordLength(0));
+   while (offset != 0 && offset < m_length && m_storage[offset] != RECORDING_TAG_CONNECTION)
+   {
+      const size_t length(recordLength(offset));
+      offset = length != 0 ? offset + length : 0;
+   }
+
+   if (offset == 0 || offset >= m_length)
+   {
+      return false;
+   }
+
+   memmove(m_storage, m_storage + offset, m_length - offset);
+   m_length -= offset;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \return Length of the record at _offset_, 0 when it is malformed.
+size_t ArduinoHttpServer::AbstractRecordingBuffer::recordLength(size_t offset) const
+{
+   const uint8_t* pRecord(m_storage + offset);
+   const size_t available(m_length - offset);
+   unsigned long value(0);
+
+   if (available == 0)
+   {
+      return 0;
+   }
+   else if (pRecord[0] == RECORDING_TAG_CONNECTION)
+   {
+      const size_t used(decodeRecordingVarint(pRecord + 1, available - 1, value));
+      return used != 0 ? 1 + used : 0;
+   }
+   else if (pRecord[0] == RECORDING_TAG_DATA)
+   {
+      const size_t timeUsed(decodeRecordingVarint(pRecord + 1, available - 1, value));
+      if (timeUsed == 0)
+      {
+         return 0;
+      }
+      const size_t lengthUsed(decodeRecordingVarint(pRecord + 1 + timeUsed, available - 1 - timeUsed, value));
+      const size_t length(1 + timeUsed + lengthUsed + value);
+      return lengthUsed != 0 && length <= available ? length : 0;
+   }
+   return 0;
+}
@@ -0,0 +1,139 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Capture of inbound connection data and its timing, for replay on a host.
+
+#ifndef __ArduinoHttpServer__RecordingStream__
+#define __ArduinoHttpServer__RecordingStream__
+
+#include <Arduino.h>
+
+#include "HttpTypes.hpp"
+
+namespace ArduinoHttpServer
+{
+
+//! Capture format: a sequence of records, each starting with a tag byte.
+//! Numbers are unsigned LEB128 (7 bits per byte, least significant first).
+//! - RECORDING_TAG_CONNECTION, <millis() at start>: a new connection begins.
+//! - RECORDING_TAG_DATA, <us since previous record>, <length>, <bytes>: bytes read.
+static const uint8_t RECORDING_TAG_CONNECTION = 'C';
+static const uint8_t RECORDING_TAG_DATA = 'D';
+static const size_t RECORDING_MAX_VARINT_SIZE = 5U;
+
+size_t decodeRecordingVarint(const uint8_t* pIn, size_t available, unsigned long& value);
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Stream wrapper recording everything read from the wrapped stream.
+//! \details Bytes read without a pause of more than RECORD_GAP_US are collected
+//!    into one record. Records are written whole, in a single write() call, to
+//!    the sink: a file or an AbstractRecordingBuffer. Timing is that of the
+//!    reads, which is when the bytes were needed rather than when they arrived.
+//!    Writes are passed through unrecorded; the first one ends the recording of
+//!    the request.
+class RecordingStream: public Stream
+{
+
+public:
+   static const unsigned long RECORD_GAP_US = 1000UL; //!< Pause after which a new record starts.
+   static const size_t RECORD_DATA_SIZE = 32U;        //!< Maximum bytes per record.
+
+   RecordingStream(Stream& stream, Print& sink);
+   virtual ~RecordingStream();
+
+   // Stream interface.
+   virtual int available();
+   virtual int read();
+   virtual int peek();
+   virtual size_t readBytes(char* buffer, size_t length);
+   size_t readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); };
+
+   // Print interface.
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   using Print::write;
+   virtual int availableForWrite();
+   virtual void flush();
+
+   #ifdef STREAMSEND_API
+   // Bulk peek interface, passed through when the wrapped stream offers it.
+   virtual bool hasPeekBufferAPI() const { return m_stream.hasPeekBufferAPI(); };
+   virtual size_t peekAvailable() { return m_stream.peekAvailable(); };
+   virtual const char* peekBuffer() { return m_stream.peekBuffer(); };
+   virtual void peekConsume(size_t consume);
+   #endif
+
+   void endRecording();
+
+private:
+   void record(const char* buffer, size_t length);
+   void writeRecord();
+
+   Stream& m_stream;
+   Print& m_sink;
+   unsigned long m_previousRecordUs; //!< Start of the previous record.
+   unsigned long m_pendingUs;        //!< Start of the pending record.
+   unsigned long m_lastReadUs;
+   uint8_t m_pending[RECORD_DATA_SIZE];
+   uint8_t m_pendingLength;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! RAM sink for RecordingStream keeping the most recent connections.
+//! \details When a record does not fit, whole connections are dropped from the
+//!    front until it does. Records of a connection larger than the buffer
+//!    are dropped. Use RecordingBuffer<SIZE> to allocate the storage. Not
+//!    synchronized; record from a single thread.
+class AbstractRecordingBuffer: public Print
+{
+
+public:
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+   using Print::write;
+
+   void clear();
+   const uint8_t* getData() const { return m_storage; };
+   size_t getLength() const { return m_length; };
+   unsigned long getDroppedRecords() const { return m_droppedRecords; };
+
+   void sendReply(Stream& stream, Method method = Method::Get) const;
+
+protected:
+   AbstractRecordingBuffer(uint8_t* pStorage, size_t size);
+
+private:
+   bool dropOldestConnection();
+   size_t recordLength(size_t offset) const;
+
+   uint8_t* m_storage;
+   const size_t m_size;
+   size_t m_length;
+   unsigned long m_droppedRecords;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+template <size_t SIZE>
+class RecordingBuffer: public AbstractRecordingBuffer
+{
+
+public:
+   RecordingBuffer() : AbstractRecordingBuffer(m_buffer, SIZE) {};
+
+private:
+   uint8_t m_buffer[SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__RecordingStream__
@@ -0,0 +1,53 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Pieces of a reply body in RAM, in flash or produced on demand.
+
+#include "ReplySegment.hpp"
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::ReplySegment ArduinoHttpServer::ReplySegment::flash(const __FlashStringHelper* text)
+{
+   PGM_P pText(reinterpret_cast<PGM_P>(text));
+   return flash(pText, strlen_P(pText));
+}
+
+//------------------------------------------------------------------------------
+//! \brief Copy up to _size_ bytes from _offset_ on to _pBuffer_, from RAM,
+//!    with memcpy_P from flash, or from the source.
+//! \returns Bytes copied, 0 at the end or when the source failed.
+size_t ArduinoHttpServer::ReplySegment::read(size_t offset, uint8_t* pBuffer, size_t size) const
+{
+   if (offset >= m_length)
+   {
+      return 0;
+   }
+   if (size > m_length - offset)
+   {
+      size = m_length - offset;
+   }
+
+   switch (m_type)
+   {
+      case Type::RAM:
+         memcpy(pBuffer, getRamData() + offset, size);
+         return size;
+
+      case Type::FLASH:
+         memcpy_P(pBuffer, static_cast<PGM_P>(m_pData) + offset, size);
+         return size;
+
+      case Type::PULL:
+      default:
+      {
+         const size_t length(m_pSource->read(offset, pBuffer, size));
+         return length < size ? length : size;
+      }
+   }
+}
@@ -0,0 +1,80 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Pieces of a reply body in RAM, in flash or produced on demand.
+
+#ifndef __ArduinoHttpServer__ReplySegment__
+#define __ArduinoHttpServer__ReplySegment__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Produces the content of a ReplySegment while it is being sent.
+class AbstractSegmentSource
+{
+
+public:
+   virtual ~AbstractSegmentSource() {};
+
+   //! Copy up to _size_ bytes of the segment, from _offset_ on, to _pBuffer_.
+   //! \returns Bytes copied; less than requested (but not 0) is fine, 0 ends
+   //!    the reply early.
+   virtual size_t read(size_t offset, uint8_t* pBuffer, size_t size) { return 0; };
+
+protected:
+   AbstractSegmentSource() {};
+
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! A piece of a reply body, like an iovec entry: a span in RAM, a span in
+//! flash (PROGMEM) or _length_ bytes pulled from an AbstractSegmentSource.
+//! \details Segments only refer to their data; it has to stay valid until the
+//!    reply has been sent. See AbstractStreamHttpReply::send().
+class ReplySegment
+{
+
+public:
+   static ReplySegment ram(const void* pData, size_t length) { return ReplySegment(Type::RAM, pData, 0, length); };
+   static ReplySegment ram(const char* text) { return ram(text, strlen(text)); };
+   static ReplySegment ram(const String& text) { return ram(text.c_str(), text.length()); };
+   static ReplySegment flash(PGM_P pData, size_t length) { return ReplySegment(Type::FLASH, pData, 0, length); };
+   static ReplySegment flash(const __FlashStringHelper* text);
+   static ReplySegment pull(AbstractSegmentSource& source, size_t length) { return ReplySegment(Type::PULL, 0, &source, length); };
+
+   inline size_t getLength() const { return m_length; };
+   size_t read(size_t offset, uint8_t* pBuffer, size_t size) const;
+   inline bool isRam() const { return m_type == Type::RAM; };
+   inline const uint8_t* getRamData() const { return static_cast<const uint8_t*>(m_pData); };
+
+private:
+   enum class Type : char
+   {
+      RAM,
+      FLASH,
+      PULL
+   };
+
+   ReplySegment(Type type, const void* pData, AbstractSegmentSource* pSource, size_t length) :
+      m_type(type), m_pData(pData), m_pSource(pSource), m_length(length) {};
+
+   Type m_type;
+   const void* m_pData;
+   AbstractSegmentSource* m_pSource;
+   size_t m_length;
+};
+
+}
+
+#endif // __ArduinoHttpServer__ReplySegment__
@@ -0,0 +1,57 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Application hooks deciding on a request while it is being read.
+
+#ifndef __ArduinoHttpServer__RequestFilter__
+#define __ArduinoHttpServer__RequestFilter__
+
+#include <stddef.h>
+
+namespace ArduinoHttpServer
+{
+
+template <size_t MAX_BODY_SIZE> class HttpRequestParser;
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Accepts or rejects a request while it is being parsed, before the rest of
+//! it is read.
+//! \details Attach an instance to a request with setFilter(). A hook returns
+//!    0 to accept, or the status code to reply with, e.g. "404". Parsing
+//!    stops right there: a rejected request fails with Error::REJECTED and
+//!    getErrorStatusCode() returns that status code, so it is answered like
+//!    any failed request, without reading the remaining fields or the body.
+template <size_t MAX_BODY_SIZE>
+class AbstractRequestFilter
+{
+
+public:
+   using Request = HttpRequestParser<MAX_BODY_SIZE>;
+
+   virtual ~AbstractRequestFilter() {};
+
+   //! Called when the request line has been parsed. Method, resource and
+   //! version are available, the fields are not. Reject unknown resources
+   //! ("404") or methods ("405") here.
+   virtual const char* requestLineRead(const Request& request) { return 0; };
+
+   //! Called when the header has been parsed, before any of the body is
+   //! read and before a client waiting for "100 Continue" gets it. Fields
+   //! and authenticate() are available. Reject missing credentials ("401")
+   //! or oversized bodies ("413") here.
+   virtual const char* headersRead(const Request& request) { return 0; };
+
+protected:
+   AbstractRequestFilter() {};
+
+};
+
+}
+
+#endif // __ArduinoHttpServer__RequestFilter__
@@ -0,0 +1,139 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! SHA-1 digest, as needed for the WebSocket handshake.
+
+#include "Sha1.hpp"
+
+namespace
+{
+   inline uint32_t rotateLeft(uint32_t value, unsigned int bits)
+   {
+      return (value << bits) | (value >> (32U - bits));
+   }
+}
+
+ArduinoHttpServer::Sha1::Sha1() :
+   m_state{0x67452301UL, 0xEFCDAB89UL, 0x98BADCFEUL, 0x10325476UL, 0xC3D2E1F0UL},
+   m_block(),
+   m_blockLength(0),
+   m_totalLength(0)
+{
+
+}
+
+void ArduinoHttpServer::Sha1::update(const uint8_t* data, size_t length)
+{
+   m_totalLength += length;
+   while (length > 0)
+   {
+      size_t count(BLOCK_SIZE - m_blockLength);
+      if (count > length)
+      {
+         count = length;
+      }
+      memcpy(m_block + m_blockLength, data, count);
+      m_blockLength += count;
+      data += count;
+      length -= count;
+
+      if (m_blockLength == BLOCK_SIZE)
+      {
+         processBlock();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Pad the message and write the digest. The instance is used up.
+void ArduinoHttpServer::Sha1::finish(uint8_t digest[DIGEST_SIZE])
+{
+   const uint32_t totalBits(m_totalLength << 3);
+
+   m_block[m_blockLength++] = 0x80U;
+   if (m_blockLength > BLOCK_SIZE - 8U)
+   {
+      memset(m_block + m_blockLength, 0, BLOCK_SIZE - m_blockLength);
+      processBlock();
+   }
+   memset(m_block + m_blockLength, 0, BLOCK_SIZE - m_blockLength);
+
+   // Big endian bit count; the upper 32 bits stay zero.
+   m_block[BLOCK_SIZE - 4] = static_cast<uint8_t>(totalBits >> 24);
+   m_block[BLOCK_SIZE - 3] = static_cast<uint8_t>(totalBits >> 16);
+   m_block[BLOCK_SIZE - 2] = static_cast<uint8_t>(totalBits >> 8);
+   m_block[BLOCK_SIZE - 1] = static_cast<uint8_t>(totalBits);
+   m_block[BLOCK_SIZE - 5] = static_cast<uint8_t>(m_totalLength >> 29);
+   processBlock();
+
+   for (size_t i=0; i < DIGEST_SIZE; ++i)
+   {
+      digest[i] = static_cast<uint8_t>(m_state[i / 4] >> (24 - 8 * (i % 4)));
+   }
+}
+
+void ArduinoHttpServer::Sha1::processBlock()
+{
+   // Rolling 16 word schedule instead of 80 words, to keep the stack small.
+   uint32_t w[16];
+   for (size_t i=0; i < 16; ++i)
+   {
+      w[i] = (static_cast<uint32_t>(m_block[4*i]) << 24) | (static_cast<uint32_t>(m_block[4*i + 1]) << 16) |
+             (static_cast<uint32_t>(m_block[4*i + 2]) << 8) | static_cast<uint32_t>(m_block[4*i + 3]);
+   }
+
+   uint32_t a(m_state[0]);
+   uint32_t b(m_state[1]);
+   uint32_t c(m_state[2]);
+   uint32_t d(m_state[3]);
+   uint32_t e(m_state[4]);
+
+   for (size_t i=0; i < 80; ++i)
+   {
+      if (i >= 16)
+      {
+         w[i & 15] = rotateLeft(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15], 1);
+      }
+
+      uint32_t f;
+      uint32_t k;
+      if (i < 20)
+      {
+         f = (b & c) | (~b & d);
+         k = 0x5A827999UL;
+      }
+      else if (i < 40)
+      {
+         f = b ^ c ^ d;
+         k = 0x6ED9EBA1UL;
+      }
+      else if (i < 60)
+      {
+         f = (b & c) | (b & d) | (c & d);
+         k = 0x8F1BBCDCUL;
+      }
+      else
+      {
+         f = b ^ c ^ d;
+         k = 0xCA62C1D6UL;
+      }
+
+      const uint32_t temp(rotateLeft(a, 5) + f + e + k + w[i & 15]);
+      e = d;
+      d = c;
+      c = rotateLeft(b, 30);
+      b = a;
+      a = temp;
+   }
+
+   m_state[0] += a;
+   m_state[1] += b;
+   m_state[2] += c;
+   m_state[3] += d;
+   m_state[4] += e;
+   m_blockLength = 0;
+}
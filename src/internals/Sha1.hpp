@@ -0,0 +1,48 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! SHA-1 digest, as needed for the WebSocket handshake.
+
+#ifndef __ArduinoHttpServer__Sha1__
+#define __ArduinoHttpServer__Sha1__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Incremental SHA-1 (FIPS 180-4).
+//! \details SHA-1 is not collision resistant; only use it where a protocol
+//!    requires it, like Sec-WebSocket-Accept.
+class Sha1
+{
+
+public:
+   static const size_t DIGEST_SIZE = 20U;
+
+   Sha1();
+
+   void update(const uint8_t* data, size_t length);
+   void finish(uint8_t digest[DIGEST_SIZE]);
+
+private:
+   static const size_t BLOCK_SIZE = 64U;
+
+   void processBlock();
+
+   uint32_t m_state[5];
+   uint8_t m_block[BLOCK_SIZE];
+   size_t m_blockLength;
+   uint32_t m_totalLength; //!< Bytes hashed so far; 4 GB is plenty here.
+};
+
+}
+
+#endif // __ArduinoHttpServer__Sha1__
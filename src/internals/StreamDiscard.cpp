@@ -0,0 +1,47 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Bulk skipping of unwanted input.
+
+#include "StreamDiscard.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+//------------------------------------------------------------------------------
+//! \brief Read and throw away up to _maxBytes_ from _stream_ using bulk reads.
+//! \param waitMs Time budget for bytes which have not been received yet.
+//!    Pass 0 to only discard what is available right now.
+//! \returns Number of bytes discarded.
+size_t ArduinoHttpServer::discardInput(Stream& stream, size_t maxBytes, unsigned long waitMs)
+{
+   char scratch[DISCARD_CHUNK_SIZE];
+   size_t discarded(0);
+   const unsigned long startMs(millis());
+
+   while (discarded < maxBytes)
+   {
+      const int available(stream.available());
+      if (available > 0)
+      {
+         size_t chunkSize(maxBytes - discarded);
+         if (static_cast<size_t>(available) < chunkSize) { chunkSize = available; }
+         if (DISCARD_CHUNK_SIZE < chunkSize) { chunkSize = DISCARD_CHUNK_SIZE; }
+
+         discarded += stream.readBytes(scratch, chunkSize);
+      }
+      else if (millis() - startMs >= waitMs)
+      {
+         break;
+      }
+      else
+      {
+         yield();
+      }
+   }
+
+   AHS_TRACE(INPUT_DISCARDED, discarded);
+   return discarded;
+}
@@ -0,0 +1,24 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Bulk skipping of unwanted input.
+
+#ifndef __ArduinoHttpServer__StreamDiscard__
+#define __ArduinoHttpServer__StreamDiscard__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+static const size_t DISCARD_CHUNK_SIZE = 64U; //!< Stack scratch buffer used while discarding.
+
+size_t discardInput(Stream& stream, size_t maxBytes, unsigned long waitMs);
+
+}
+
+#endif // __ArduinoHttpServer__StreamDiscard__
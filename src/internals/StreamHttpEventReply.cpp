@@ -0,0 +1,228 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Server-Sent Events (text/event-stream) reply.
+
+#include "StreamHttpEventReply.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+namespace
+{
+   //! Collects an event in _pBuffer_ and writes it to _pOut_ in buffer sized
+   //! pieces. Without _pOut_ it only counts, so the length is known upfront.
+   class EventWriter
+   {
+   public:
+      EventWriter(Print* pOut, char* pBuffer, size_t bufferSize) :
+         m_pOut(pOut), m_pBuffer(pBuffer), m_bufferSize(bufferSize), m_length(0), m_total(0)
+      {
+      }
+
+      void append(const char* data, size_t length)
+      {
+         m_total += length;
+         if (!m_pOut)
+         {
+            return;
+         }
+         while (length > 0)
+         {
+            const size_t space(m_bufferSize - m_length);
+            const size_t part(length < space ? length : space);
+            memcpy(m_pBuffer + m_length, data, part);
+            m_length += part;
+            data += part;
+            length -= part;
+            if (m_length == m_bufferSize)
+            {
+               flush();
+            }
+         }
+      }
+
+      void append(const char* text) { append(text, strlen(text)); }
+
+      //! Field "_name_: _value_\n" per line of _value_; a '\r' ending a line is dropped.
+      void appendField(const char* name, const char* value)
+      {
+         const char* pLine(value);
+         while (true)
+         {
+            const char* pEnd(strchr(pLine, '\n'));
+            size_t length(pEnd ? static_cast<size_t>(pEnd - pLine) : strlen(pLine));
+            if (length > 0 && pLine[length - 1] == '\r')
+            {
+               --length;
+            }
+            append(name);
+            append(": ", 2);
+            append(pLine, length);
+            append("\n", 1);
+            if (!pEnd)
+            {
+               return;
+            }
+            pLine = pEnd + 1;
+         }
+      }
+
+      size_t finish()
+      {
+         flush();
+         return m_total;
+      }
+
+   private:
+      void flush()
+      {
+         if (m_pOut && m_length > 0)
+         {
+            m_pOut->write(reinterpret_cast<const uint8_t*>(m_pBuffer), m_length);
+         }
+         m_length = 0;
+      }
+
+      Print* m_pOut;
+      char* m_pBuffer;
+      const size_t m_bufferSize;
+      size_t m_length;
+      size_t m_total;
+   };
+
+   void writeEvent(EventWriter& writer, const char* id, const char* type, const char* data)
+   {
+      if (id && *id)
+      {
+         writer.appendField("id", id);
+      }
+      if (type && *type)
+      {
+         writer.appendField("event", type);
+      }
+      writer.appendField("data", data ? data : "");
+      writer.append("\n", 1);
+   }
+
+   //! Decimal digits of _value_, zero terminated, into _text_.
+   void formatDecimal(unsigned long value, char (&text)[11])
+   {
+      char digits[10];
+      size_t count(0);
+      do
+      {
+         digits[count++] = static_cast<char>('0' + value % 10UL);
+         value /= 10UL;
+      } while (value > 0 && count < sizeof(digits));
+
+      for (size_t i=0; i < count; ++i)
+      {
+         text[i] = digits[count - 1 - i];
+      }
+      text[count] = '\0';
+   }
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::StreamHttpEventReply::StreamHttpEventReply(Stream& stream, Method method) :
+   AbstractStreamHttpReply(stream, "text/event-stream", "200", method),
+   m_droppedEvents(0),
+   m_dropWhenFull(false)
+{
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send the header which opens the event stream.
+//! \param retryMs Reconnection delay the browser should use, 0 for its default.
+void ArduinoHttpServer::StreamHttpEventReply::send(unsigned long retryMs)
+{
+   m_droppedEvents = 0;
+
+   beginReply();
+   size_t bytesWritten(printHeader(0, AHS_F("OK")));
+   if (retryMs > 0 && hasBody())
+   {
+      bytesWritten += getStream().print(AHS_F("retry: "));
+      bytesWritten += getStream().print(retryMs);
+      bytesWritten += getStream().print(AHS_F("\n\n"));
+   }
+   endReply(bytesWritten);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send one event. _id_ and _type_ may be 0 to leave them out, _data_
+//!    may span several lines.
+//! \returns Bytes written, 0 when the event was dropped for lack of send
+//!    buffer space.
+size_t ArduinoHttpServer::StreamHttpEventReply::sendEvent(const char* id, const char* type, const char* data)
+{
+   if (!hasBody() || !hasWriteSpace(getEventLength(id, type, data)))
+   {
+      return 0;
+   }
+
+   char buffer[EVENT_BUFFER_SIZE];
+   EventWriter writer(&getStream(), buffer, sizeof(buffer));
+   writeEvent(writer, id, type, data);
+   return writer.finish();
+}
+
+size_t ArduinoHttpServer::StreamHttpEventReply::sendEvent(unsigned long id, const char* type, const char* data)
+{
+   char idText[11];
+   formatDecimal(id, idText);
+   return sendEvent(idText, type, data);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send a comment line, ignored by the browser. Useful as keep-alive.
+size_t ArduinoHttpServer::StreamHttpEventReply::sendComment(const char* text)
+{
+   EventWriter counter(0, 0, 0);
+   counter.appendField("", text);
+   if (!hasBody() || !hasWriteSpace(counter.finish() + 1))
+   {
+      return 0;
+   }
+
+   char buffer[EVENT_BUFFER_SIZE];
+   EventWriter writer(&getStream(), buffer, sizeof(buffer));
+   writer.appendField("", text);
+   writer.append("\n", 1);
+   return writer.finish();
+}
+
+//------------------------------------------------------------------------------
+//! \brief Number of bytes sendEvent() writes for these arguments.
+size_t ArduinoHttpServer::StreamHttpEventReply::getEventLength(const char* id, const char* type, const char* data)
+{
+   EventWriter counter(0, 0, 0);
+   writeEvent(counter, id, type, data);
+   return counter.finish();
+}
+
+//------------------------------------------------------------------------------
+//! \brief Events must not be cached, nor buffered by proxies.
+size_t ArduinoHttpServer::StreamHttpEventReply::printExtraFields(Print& out)
+{
+   return out.print(AHS_F("Cache-Control: no-cache\r\n"));
+}
+
+//------------------------------------------------------------------------------
+//! \brief Check whether _length_ bytes can be written without blocking,
+//!    when dropping events is enabled. Counts a dropped event otherwise.
+bool ArduinoHttpServer::StreamHttpEventReply::hasWriteSpace(size_t length)
+{
+   if (m_dropWhenFull && getStream().availableForWrite() < static_cast<int>(length))
+   {
+      ++m_droppedEvents;
+      AHS_TRACE(EVENT_DROPPED, length);
+      return false;
+   }
+   return true;
+}
@@ -0,0 +1,226 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Server-Sent Events (text/event-stream) reply and subscriber set.
+
+#ifndef __ArduinoHttpServer__StreamHttpEventReply__
+#define __ArduinoHttpServer__StreamHttpEventReply__
+
+#include <Arduino.h>
+
+#include "StreamHttpReply.hpp"
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Long-lived reply streaming events to a browser's EventSource.
+//! \details send() writes the header once, after which sendEvent() can be
+//!    called for as long as the client stays connected. Events are assembled
+//!    in a small buffer on the stack; nothing is allocated per event.
+//!
+//!    Events are written as any reply is, blocking while the stream's send
+//!    buffer is full. With setDropWhenFull(true) an event which does not fit
+//!    availableForWrite() is dropped instead, so a slow subscriber misses
+//!    values rather than stalling everyone else. Only enable it for streams
+//!    which implement availableForWrite(), e.g. WiFiClient on ESP8266 and
+//!    ESP32; Print's default of 0 would drop every event.
+class StreamHttpEventReply: public AbstractStreamHttpReply
+{
+public:
+   StreamHttpEventReply(Stream& stream, Method method = Method::Get);
+   template <size_t MAX_BODY_SIZE>
+   StreamHttpEventReply(StreamHttpRequest<MAX_BODY_SIZE>& request);
+
+   void send(unsigned long retryMs = 0);
+   size_t sendEvent(const char* id, const char* type, const char* data);
+   size_t sendEvent(unsigned long id, const char* type, const char* data);
+   size_t sendComment(const char* text);
+
+   inline void setDropWhenFull(bool dropWhenFull) { m_dropWhenFull = dropWhenFull; };
+   inline unsigned long getDroppedEvents() const { return m_droppedEvents; };
+
+   static size_t getEventLength(const char* id, const char* type, const char* data);
+
+protected:
+   virtual size_t printExtraFields(Print& out);
+
+private:
+   static const size_t EVENT_BUFFER_SIZE = 64U;
+
+   bool hasWriteSpace(size_t length);
+
+   unsigned long m_droppedEvents;
+   bool m_dropWhenFull;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Fixed set of up to _MAX_SUBSCRIBERS_ clients following the same events.
+//! \details CLIENT is the connection type kept per subscriber, e.g. WiFiClient
+//!    or EthernetClient. Subscribers which disconnected are stopped and their
+//!    slot reused on the next broadcast. _dropWhenFull_ is applied to every
+//!    subscriber, see StreamHttpEventReply::setDropWhenFull().
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+class EventSubscribers
+{
+public:
+   EventSubscribers(bool dropWhenFull = false);
+
+   bool add(const CLIENT& client, unsigned long retryMs = 0);
+   size_t broadcast(const char* type, const char* data);
+   void keepAlive();
+
+   size_t getCount();
+   inline unsigned long getLastEventId() const { return m_lastEventId; };
+   unsigned long getDroppedEvents() const;
+
+private:
+   //! The reply refers to the client next to it, which is replaced by add().
+   struct Subscriber
+   {
+      Subscriber() : client(), reply(client), used(false) {};
+
+      CLIENT client;
+      StreamHttpEventReply reply;
+      bool used;
+   };
+
+   void removeDisconnected();
+
+   Subscriber m_subscribers[MAX_SUBSCRIBERS];
+   unsigned long m_lastEventId;
+   const bool m_dropWhenFull;
+};
+
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::StreamHttpEventReply::StreamHttpEventReply(StreamHttpRequest<MAX_BODY_SIZE>& request) :
+   AbstractStreamHttpReply(request.getStream(), "text/event-stream", "200", request.getMethod()),
+   m_droppedEvents(0),
+   m_dropWhenFull(false)
+{
+   setInputToDiscard(getInputToDiscard(request));
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::EventSubscribers(bool dropWhenFull) :
+   m_subscribers(),
+   m_lastEventId(0),
+   m_dropWhenFull(dropWhenFull)
+{
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send the event stream header to _client_ and keep it as subscriber.
+//! \returns False when all slots are taken; reply to the client yourself,
+//!    e.g. with a 503 StreamHttpErrorReply.
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+bool ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::add(const CLIENT& client, unsigned long retryMs)
+{
+   removeDisconnected();
+   for (size_t i=0; i < MAX_SUBSCRIBERS; ++i)
+   {
+      Subscriber& subscriber(m_subscribers[i]);
+      if (!subscriber.used)
+      {
+         subscriber.client = client;
+         subscriber.used = true;
+         subscriber.reply.setDropWhenFull(m_dropWhenFull);
+         subscriber.reply.send(retryMs);
+         return true;
+      }
+   }
+   return false;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send an event with the next id to all subscribers.
+//! \returns Number of subscribers the event was written to.
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+size_t ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::broadcast(const char* type, const char* data)
+{
+   removeDisconnected();
+   ++m_lastEventId;
+
+   size_t sent(0);
+   for (size_t i=0; i < MAX_SUBSCRIBERS; ++i)
+   {
+      if (m_subscribers[i].used && m_subscribers[i].reply.sendEvent(m_lastEventId, type, data) > 0)
+      {
+         ++sent;
+      }
+   }
+   return sent;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send a comment to all subscribers, so idle connections are not
+//!    closed by proxies and dead ones are noticed.
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+void ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::keepAlive()
+{
+   removeDisconnected();
+   for (size_t i=0; i < MAX_SUBSCRIBERS; ++i)
+   {
+      if (m_subscribers[i].used)
+      {
+         m_subscribers[i].reply.sendComment("");
+      }
+   }
+}
+
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+size_t ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::getCount()
+{
+   removeDisconnected();
+   size_t count(0);
+   for (size_t i=0; i < MAX_SUBSCRIBERS; ++i)
+   {
+      count += m_subscribers[i].used ? 1U : 0U;
+   }
+   return count;
+}
+
+//! \brief Events dropped for lack of send buffer space, summed over the current subscribers.
+//!    Always 0 unless dropWhenFull.
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+unsigned long ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::getDroppedEvents() const
+{
+   unsigned long dropped(0);
+   for (size_t i=0; i < MAX_SUBSCRIBERS; ++i)
+   {
+      dropped += m_subscribers[i].used ? m_subscribers[i].reply.getDroppedEvents() : 0UL;
+   }
+   return dropped;
+}
+
+template <class CLIENT, size_t MAX_SUBSCRIBERS>
+void ArduinoHttpServer::EventSubscribers<CLIENT, MAX_SUBSCRIBERS>::removeDisconnected()
+{
+   for (size_t i=0; i < MAX_SUBSCRIBERS; ++i)
+   {
+      Subscriber& subscriber(m_subscribers[i]);
+      if (subscriber.used && !subscriber.client.connected())
+      {
+         subscriber.client.stop();
+         subscriber.used = false;
+      }
+   }
+}
+
+#endif // __ArduinoHttpServer__StreamHttpEventReply__
@@ -3,6 +3,96 @@
 #include <Arduino.h>
 
 #include "ArduinoHttpServerDebug.h"
+#include "StreamDiscard.hpp"
+
+namespace
+{
+   //! Collects writes in a buffer and passes them on a buffer full at a time.
+   //! Writes at least the buffer size go through directly.
+   class BufferedPrint: public Print
+   {
+   public:
+      BufferedPrint(Print& out, uint8_t* pBuffer, size_t bufferSize) :
+         m_out(out), m_pBuffer(pBuffer), m_bufferSize(bufferSize), m_length(0), m_written(0), m_failed(false)
+      {
+      }
+
+      using Print::write;
+      virtual size_t write(uint8_t byte) { return write(&byte, 1); }
+
+      virtual size_t write(const uint8_t* buffer, size_t size)
+      {
+         if (m_length + size > m_bufferSize)
+         {
+            flushBuffer();
+         }
+         if (size >= m_bufferSize)
+         {
+            passOn(buffer, size);
+            return size;
+         }
+         memcpy(m_pBuffer + m_length, buffer, size);
+         m_length += size;
+         return size;
+      }
+
+      //! \brief Read _segment_ straight into the buffer.
+      //! \returns False when its source ended early.
+      bool writeSegment(const ArduinoHttpServer::ReplySegment& segment)
+      {
+         if (segment.isRam() && segment.getLength() >= m_bufferSize)
+         {
+            write(segment.getRamData(), segment.getLength());
+            return true;
+         }
+
+         for (size_t offset=0; offset < segment.getLength() && !m_failed; )
+         {
+            if (m_length == m_bufferSize)
+            {
+               flushBuffer();
+            }
+            const size_t length(segment.read(offset, m_pBuffer + m_length, m_bufferSize - m_length));
+            if (length == 0)
+            {
+               return false;
+            }
+            m_length += length;
+            offset += length;
+         }
+         return true;
+      }
+
+      //! \returns False when the output did not accept everything.
+      bool flushBuffer()
+      {
+         passOn(m_pBuffer, m_length);
+         m_length = 0;
+         return !m_failed;
+      }
+
+      size_t getWritten() const { return m_written; }
+
+   private:
+      void passOn(const uint8_t* buffer, size_t size)
+      {
+         if (size == 0 || m_failed)
+         {
+            return;
+         }
+         const size_t written(m_out.write(buffer, size));
+         m_written += written;
+         m_failed = written != size;
+      }
+
+      Print& m_out;
+      uint8_t* const m_pBuffer;
+      const size_t m_bufferSize;
+      size_t m_length;
+      size_t m_written;
+      bool m_failed;
+   };
+}
 
 //------------------------------------------------------------------------------
 //                             Class Definition
@@ -10,53 +100,167 @@
 
 //------------------------------------------------------------------------------
 //! \brief Constructor.
-ArduinoHttpServer::AbstractStreamHttpReply::AbstractStreamHttpReply(Stream& stream, const String& contentType, const String& code) :
+ArduinoHttpServer::AbstractStreamHttpReply::AbstractStreamHttpReply(Stream& stream, const String& contentType, const String& code, Method method) :
    m_stream(stream),
    m_contentType(contentType),
-   m_code(code)
+   m_code(code),
+   m_observer(0),
+   m_inputToDiscard(DISCARD_AVAILABLE_INPUT),
+   m_method(method)
 {
 
 }
 
 void ArduinoHttpServer::AbstractStreamHttpReply::sendHeader(
     size_t size, const String& title) {
-   // Read away remaining bytes.
-   while (getStream().read() >= 0) {
-   }
-
-   getStream().print(AHS_F("HTTP/1.1 "));
-   getStream().print(getCode() + " ");
-   getStream().print(title + "\r\n");
-   getStream().print(AHS_F("Connection: close\r\n"));
-   if (size > 0) {
-      getStream().print(AHS_F("Content-Length: "));
-      getStream().print(size);
-      getStream().print(AHS_F("\r\n"));
-   }
-   getStream().print(AHS_F("Content-Type: "));
-   getStream().print(m_contentType);
-   getStream().print(AHS_F("\r\n"));
-   getStream().print(AHS_F("\r\n"));
+   beginReply();
+   endReply(printHeader(size, title));
 }
 
 //------------------------------------------------------------------------------
 //! \brief Send this reply / print this reply to stream.
-//! \todo: Accept char* also for data coming directly from flash.
+//! \details For data in flash, send ReplySegment::flash() segments.
 void ArduinoHttpServer::AbstractStreamHttpReply::send(const String& data, const String& title)
 {
-   DEBUG_ARDUINO_HTTP_SERVER_PRINT("Printing Reply ... ");
-   AbstractStreamHttpReply::sendHeader(data.length(), title);
-   getStream().print( data ); getStream().print( AHS_F("\r\n") );
-   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("done.");
+   beginReply();
+   size_t bytesWritten(printHeader(data.length(), title));
+   if (hasBody())
+   {
+      bytesWritten += getStream().print( data );
+      bytesWritten += getStream().print( AHS_F("\r\n") );
+   }
+   endReply(bytesWritten);
 }
 
 void ArduinoHttpServer::AbstractStreamHttpReply::send(const uint8_t* buf,
                                                       const size_t size,
                                                       const String& title) {
-   DEBUG_ARDUINO_HTTP_SERVER_PRINT("Printing Reply ... ");
-   AbstractStreamHttpReply::sendHeader(size, title);
-   getStream().write(buf, size);
-   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("done.");
+   beginReply();
+   size_t bytesWritten(printHeader(size, title));
+   if (hasBody())
+   {
+      bytesWritten += getStream().write(buf, size);
+   }
+   endReply(bytesWritten);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send a body made of _count_ segments, e.g. a page header from
+//!    flash, a value in RAM and a footer from flash, without concatenating them.
+//! \details Content-Length is the sum of the segment lengths. The header and
+//!    all segments go out through one SEGMENT_BUFFER_SIZE bytes buffer, so
+//!    the reply takes few writes to the stream. Flash segments are copied
+//!    with memcpy_P and sources read straight into it; RAM segments at least
+//!    the buffer size are written directly.
+//! \returns False when a source ended early or the stream did not accept
+//!    everything; the body is incomplete then, close the connection.
+bool ArduinoHttpServer::AbstractStreamHttpReply::send(const ReplySegment* pSegments, size_t count, const String& title)
+{
+   size_t length(0);
+   for (size_t i=0; i < count; ++i)
+   {
+      length += pSegments[i].getLength();
+   }
+
+   beginReply();
+   uint8_t buffer[SEGMENT_BUFFER_SIZE];
+   BufferedPrint out(getStream(), buffer, sizeof(buffer));
+   printHeader(out, length, title);
+
+   bool complete(true);
+   for (size_t i=0; i < count && complete && hasBody(); ++i)
+   {
+      complete = out.writeSegment(pSegments[i]);
+   }
+   complete = out.flushBuffer() && complete;
+
+   endReply(out.getWritten());
+   return complete;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Print the status line and header fields.
+//! \returns Number of bytes written.
+//! \param chunked Announce a chunked body instead of _size_.
+//! \param contentEncoding Content-Encoding of the body, e.g. "gzip", or 0.
+size_t ArduinoHttpServer::AbstractStreamHttpReply::printHeader(
+    size_t size, const String& title, bool chunked, const char* contentEncoding) {
+   return printHeader(getStream(), size, title, chunked, contentEncoding);
+}
+
+//! \brief Print the header to _out_, e.g. a buffer in front of the stream.
+size_t ArduinoHttpServer::AbstractStreamHttpReply::printHeader(
+    Print& out, size_t size, const String& title, bool chunked, const char* contentEncoding) {
+   discardRemainingInput();
+
+   size_t bytesWritten(0);
+   bytesWritten += out.print(AHS_F("HTTP/1.1 "));
+   bytesWritten += out.print(getCode() + " ");
+   bytesWritten += out.print(title + "\r\n");
+   bytesWritten += out.print(AHS_F("Connection: close\r\n"));
+   if (chunked) {
+      bytesWritten += out.print(AHS_F("Transfer-Encoding: chunked\r\n"));
+   } else if (size > 0) {
+      bytesWritten += out.print(AHS_F("Content-Length: "));
+      bytesWritten += out.print(size);
+      bytesWritten += out.print(AHS_F("\r\n"));
+   }
+   bytesWritten += out.print(AHS_F("Content-Type: "));
+   bytesWritten += out.print(m_contentType);
+   bytesWritten += out.print(AHS_F("\r\n"));
+   if (contentEncoding) {
+      bytesWritten += out.print(AHS_F("Content-Encoding: "));
+      bytesWritten += out.print(contentEncoding);
+      bytesWritten += out.print(AHS_F("\r\nVary: Accept-Encoding\r\n"));
+   }
+   bytesWritten += printExtraFields(out);
+   bytesWritten += out.print(AHS_F("\r\n"));
+
+   return bytesWritten;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Read away input the client sent but nobody consumed.
+//! \details Closing a connection with unread input makes most TCP stacks reset
+//!    it, possibly before the client received the reply.
+void ArduinoHttpServer::AbstractStreamHttpReply::discardRemainingInput()
+{
+   if (m_inputToDiscard == DISCARD_AVAILABLE_INPUT)
+   {
+      discardInput(getStream(), MAX_DISCARD_BYTES, 0);
+   }
+   else if (m_inputToDiscard <= MAX_DISCARD_BYTES)
+   {
+      discardInput(getStream(), m_inputToDiscard, DISCARD_TIMEOUT_MS);
+   }
+   else
+   {
+      AHS_TRACE(DISCARD_REFUSED, m_inputToDiscard);
+   }
+   m_inputToDiscard = 0;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Mark the end of the application's handler phase.
+void ArduinoHttpServer::AbstractStreamHttpReply::beginReply()
+{
+   AHS_TRACE(REPLY_START, 0);
+   if(m_observer)
+   {
+      m_observer->phaseEnded(AbstractHttpObserver::Phase::HANDLER, micros());
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Mark the end of the reply phase.
+void ArduinoHttpServer::AbstractStreamHttpReply::endReply(size_t bytesWritten)
+{
+   AHS_TRACE(REPLY_DONE, bytesWritten);
+   if(m_observer)
+   {
+      m_observer->phaseEnded(AbstractHttpObserver::Phase::REPLY, micros());
+      m_observer->replySent(bytesWritten);
+   }
 }
 
 
@@ -83,8 +287,8 @@ const String& ArduinoHttpServer::AbstractStreamHttpReply::getContentType()
 //                             Class Definition
 //------------------------------------------------------------------------------
 
-ArduinoHttpServer::StreamHttpReply::StreamHttpReply(Stream& stream, const String& contentType) :
-   AbstractStreamHttpReply(stream, contentType, "200")
+ArduinoHttpServer::StreamHttpReply::StreamHttpReply(Stream& stream, const String& contentType, Method method) :
+   AbstractStreamHttpReply(stream, contentType, "200", method)
 {
 
 }
@@ -94,30 +298,34 @@ ArduinoHttpServer::StreamHttpReply::StreamHttpReply(Stream& stream, const String
 //                             Class Definition
 //------------------------------------------------------------------------------
 
-ArduinoHttpServer::StreamHttpErrorReply::StreamHttpErrorReply(Stream& stream, const String& contentType, const String& code) :
-   AbstractStreamHttpReply(stream, contentType, code)
+ArduinoHttpServer::StreamHttpErrorReply::StreamHttpErrorReply(Stream& stream, const String& contentType, const String& code, Method method) :
+   AbstractStreamHttpReply(stream, contentType, code, method)
 {
 
 }
 
 void ArduinoHttpServer::StreamHttpErrorReply::send(const String& data)
 {
-   String body;
-
-   if(getContentType() == CONTENT_TYPE_TEXT_HTML)
+   if(getContentType() == CONTENT_TYPE_APPLICATION_JSON)
    {
-      body = getHtmlBody(data);
+      const String body(getJsonBody(data));
+      if (body.length() > 0)
+      {
+         AbstractStreamHttpReply::send(body, data);
+      }
+      else
+      {
+         sendJsonBody(data);
+      }
    }
-   else if(getContentType() == CONTENT_TYPE_APPLICATION_JSON)
+   else if(getContentType() == CONTENT_TYPE_TEXT_HTML)
    {
-      body = getJsonBody(data);
+      AbstractStreamHttpReply::send(getHtmlBody(data), data);
    }
    else
    {
-      body = data;
+      AbstractStreamHttpReply::send(data, data);
    }
-
-   AbstractStreamHttpReply::send(body, data);
 }
 
 
@@ -135,18 +343,162 @@ String ArduinoHttpServer::StreamHttpErrorReply::getHtmlBody(const String& data)
    return body;
 }
 
+//------------------------------------------------------------------------------
+//! \brief Body of application/json error replies.
+//! \details The default is empty: send() then streams {"Error":_data_},
+//!    escaped while writing, without building it in RAM. A body returned by
+//!    an override is sent as it is.
 String ArduinoHttpServer::StreamHttpErrorReply::getJsonBody(const String& data)
 {
-   // Copy string since replace modifies original.
-   String dataCopy(data);
-   dataCopy.replace("\"", "\\\"");
+   return String();
+}
 
-   String body;
-   body += AHS_F("{\"Error\": \"");
-   body +=dataCopy;
-   body += AHS_F("\"}");
+//------------------------------------------------------------------------------
+//! \brief Send {"Error":_data_}, escaped on the fly while writing.
+void ArduinoHttpServer::StreamHttpErrorReply::sendJsonBody(const String& data)
+{
+   JsonWriter<> counter;
+   counter.beginObject();
+   counter.key("Error");
+   counter.value(data);
+   counter.endObject();
+
+   beginReply();
+   size_t bytesWritten(printHeader(counter.getLength(), data));
+   if (hasBody())
+   {
+      JsonWriter<> json(getStream());
+      json.beginObject();
+      json.key("Error");
+      json.value(data);
+      json.endObject();
+      json.flush();
+      bytesWritten += json.getLength();
+   }
+   endReply(bytesWritten);
+}
 
-   return body;
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+
+ArduinoHttpServer::StreamHttpChunkedReply::StreamHttpChunkedReply(Stream& stream, const String& contentType, const String& code, Method method) :
+   AbstractStreamHttpReply(stream, contentType, code, method),
+   m_bytesWritten(0),
+   m_chunkOpen(false),
+   m_failed(false)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send the header; write the body next and finish with end().
+//! \param contentEncoding E.g. DeflateWriter::getContentEncoding() when
+//!    writing through a DeflateWriter.
+void ArduinoHttpServer::StreamHttpChunkedReply::begin(const String& title, const char* contentEncoding)
+{
+   beginReply();
+   m_bytesWritten = printHeader(0, title, true, contentEncoding);
+   m_chunkOpen = false;
+   m_failed = false;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send the last, empty chunk, unless the reply failed.
+void ArduinoHttpServer::StreamHttpChunkedReply::end()
+{
+   if (hasBody() && !m_failed)
+   {
+      writeChunkHeader(0, true);
+   }
+   endReply(m_bytesWritten);
+}
+
+size_t ArduinoHttpServer::StreamHttpChunkedReply::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send _buffer_ as one chunk.
+//! \returns _size_, or 0 once the reply has failed.
+size_t ArduinoHttpServer::StreamHttpChunkedReply::write(const uint8_t* buffer, size_t size)
+{
+   if (size == 0 || m_failed)
+   {
+      return 0; // An empty chunk would end the body, a failed reply sends nothing.
+   }
+
+   if (!hasBody())
+   {
+      return size;
+   }
+
+   // Once the size is announced, the chunk has to be sent completely.
+   if (!writeChunkHeader(size, false) || !writeAll(buffer, size))
+   {
+      return 0;
+   }
+   m_chunkOpen = true;
+   return size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write all of _buffer_, however little the stream takes at a time.
+//! \returns False, failing the reply, when the stream takes nothing at all.
+bool ArduinoHttpServer::StreamHttpChunkedReply::writeAll(const uint8_t* buffer, size_t size)
+{
+   while (size > 0)
+   {
+      const size_t written(getStream().write(buffer, size));
+      if (written == 0)
+      {
+         m_failed = true;
+         return false;
+      }
+      m_bytesWritten += written;
+      buffer += written;
+      size -= written;
+   }
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write the previous chunk's CRLF and the size line of the next one
+//!    in a single write, so a chunk costs two writes to the stream.
+bool ArduinoHttpServer::StreamHttpChunkedReply::writeChunkHeader(size_t size, bool last)
+{
+   static const char HEX_DIGITS[] = "0123456789abcdef";
+
+   char header[2 + 2*sizeof(size_t) + 4];
+   size_t length(0);
+   if (m_chunkOpen)
+   {
+      header[length++] = '\r';
+      header[length++] = '\n';
+   }
+
+   char digits[2*sizeof(size_t)];
+   size_t digitCount(0);
+   do
+   {
+      digits[digitCount++] = HEX_DIGITS[size & 0x0F];
+      size >>= 4;
+   } while (size > 0);
+   while (digitCount > 0)
+   {
+      header[length++] = digits[--digitCount];
+   }
+
+   header[length++] = '\r';
+   header[length++] = '\n';
+   if (last)
+   {
+      header[length++] = '\r';
+      header[length++] = '\n';
+   }
+   m_chunkOpen = false;
+   return writeAll(reinterpret_cast<const uint8_t*>(header), length);
 }
 
 //------------------------------------------------------------------------------
@@ -155,26 +507,29 @@ String ArduinoHttpServer::StreamHttpErrorReply::getJsonBody(const String& data)
 
 #ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
 
-ArduinoHttpServer::StreamHttpAuthenticateReply::StreamHttpAuthenticateReply(Stream& stream, const String& contentType) :
-   AbstractStreamHttpReply(stream, contentType, "401")
+ArduinoHttpServer::StreamHttpAuthenticateReply::StreamHttpAuthenticateReply(Stream& stream, const String& contentType, Method method) :
+   AbstractStreamHttpReply(stream, contentType, "401", method)
 {
 
 }
 
 void ArduinoHttpServer::StreamHttpAuthenticateReply::send()
 {
-   // Read away remaining bytes.
-   while(getStream().read()>=0);
-
-   DEBUG_ARDUINO_HTTP_SERVER_PRINT("Printing authenticate reply ... ");
-   getStream().println(AHS_F("HTTP/1.1 401 Unauthorized"));
-   getStream().println(AHS_F("WWW-Authenticate: Basic realm=\"Login Required\""));
-   getStream().println(AHS_F("Connection: close"));
-   getStream().println(AHS_F(""));
-   getStream().println(AHS_F("<html><head><title>401 Unauthorized</title></head><body><h4>401 Unauthorized</h4>Authorization required.</body></html>"));
-   getStream().println(AHS_F(""));
-   getStream().println(AHS_F(""));
-   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("done.");
+   discardRemainingInput();
+
+   beginReply();
+   size_t bytesWritten(0);
+   bytesWritten += getStream().println(AHS_F("HTTP/1.1 401 Unauthorized"));
+   bytesWritten += getStream().println(AHS_F("WWW-Authenticate: Basic realm=\"Login Required\""));
+   bytesWritten += getStream().println(AHS_F("Connection: close"));
+   bytesWritten += getStream().println(AHS_F(""));
+   if (hasBody())
+   {
+      bytesWritten += getStream().println(AHS_F("<html><head><title>401 Unauthorized</title></head><body><h4>401 Unauthorized</h4>Authorization required.</body></html>"));
+      bytesWritten += getStream().println(AHS_F(""));
+      bytesWritten += getStream().println(AHS_F(""));
+   }
+   endReply(bytesWritten);
 }
 
 #endif
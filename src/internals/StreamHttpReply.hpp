@@ -13,14 +13,22 @@
 #include <Arduino.h>
 
 #include "ArduinoHttpServerDebug.h"
+#include "HttpObserver.hpp"
+#include "JsonWriter.hpp"
+#include "ReplySegment.hpp"
 
 namespace ArduinoHttpServer
 {
 
+template <size_t MAX_BODY_SIZE> class StreamHttpRequest;
+
 //------------------------------------------------------------------------------
 //                             Class Declaration
 //------------------------------------------------------------------------------
 //! Shared Reply functionality
+//! \details Replies constructed from the request they answer take its
+//!    method and discard exactly its unread body. Replies to HEAD requests send the same header as they would for
+//!    GET, Content-Length included, but no body.
 class AbstractStreamHttpReply
 {
 
@@ -28,13 +36,45 @@ public:
     virtual void sendHeader(size_t size, const String& title);
     virtual void send(const String& data, const String& title);
     virtual void send(const uint8_t* buf, const size_t size, const String& title);
+    bool send(const ReplySegment* pSegments, size_t count, const String& title);
+
+    // Instrumentation. Pass 0 to detach.
+    void setObserver(AbstractHttpObserver* pObserver) { m_observer = pObserver; };
+
+    //! Discard exactly _length_ unread input bytes before replying, e.g.
+    //! StreamHttpRequest::getUnreadBodyLength(). Keeps a pipelined next request.
+    void setInputToDiscard(size_t length) { m_inputToDiscard = length; };
+
+    //! False when replying to a HEAD request; skip generating the body.
+    inline bool hasBody() const { return m_method != Method::Head; };
+
+    static const size_t DISCARD_AVAILABLE_INPUT = static_cast<size_t>(-1);
+    static const size_t MAX_DISCARD_BYTES = 8192U; //!< Larger input is left for the connection close.
+    static const unsigned long DISCARD_TIMEOUT_MS = 1000UL;
+    static const size_t SEGMENT_BUFFER_SIZE = 128U; //!< Stack buffer collecting header and segments.
 
 protected:
-   AbstractStreamHttpReply(Stream& stream, const String& contentType, const String& code);
+   AbstractStreamHttpReply(Stream& stream, const String& contentType, const String& code, Method method);
    virtual Stream& getStream();
    virtual const String& getCode();
    virtual const String& getContentType();
 
+   size_t printHeader(size_t size, const String& title, bool chunked = false, const char* contentEncoding = 0);
+   size_t printHeader(Print& out, size_t size, const String& title, bool chunked = false, const char* contentEncoding = 0);
+   //! Header fields of a subclass, each ending in "\r\n", printed after Content-Type.
+   virtual size_t printExtraFields(Print& out) { return 0; };
+   void beginReply();
+   void endReply(size_t bytesWritten);
+   void discardRemainingInput();
+
+   //! Exactly the unread body of a request read completely, so a pipelined
+   //! next request is kept; all available input after a failed one.
+   template <size_t MAX_BODY_SIZE>
+   static size_t getInputToDiscard(StreamHttpRequest<MAX_BODY_SIZE>& request)
+   {
+      return request.getErrorCode() == RequestError::OK ? request.getUnreadBodyLength() : DISCARD_AVAILABLE_INPUT;
+   }
+
    constexpr static const char* CONTENT_TYPE_TEXT_HTML PROGMEM = "text/html";
    constexpr static const char* CONTENT_TYPE_APPLICATION_JSON PROGMEM = "application/json";
 
@@ -43,6 +83,9 @@ private:
    Stream& m_stream;
    String m_contentType; //!< Needs to be overridden to default when required. Therefore not const.
    const String m_code;
+   AbstractHttpObserver* m_observer;
+   size_t m_inputToDiscard;
+   const Method m_method;
 
 };
 
@@ -53,12 +96,18 @@ private:
 class StreamHttpErrorReply: public AbstractStreamHttpReply
 {
 public:
-    StreamHttpErrorReply(Stream& stream, const String& contentType, const String& code = "400");
+    StreamHttpErrorReply(Stream& stream, const String& contentType, const String& code = "400", Method method = Method::Get);
+    //! Reply to _request_, by default with its StreamHttpRequest::getErrorStatusCode().
+    template <size_t MAX_BODY_SIZE>
+    StreamHttpErrorReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType);
+    template <size_t MAX_BODY_SIZE>
+    StreamHttpErrorReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType, const String& code);
     virtual void send(const String& data);
 
 protected:
     virtual String getHtmlBody(const String& data);
     virtual String getJsonBody(const String& data);
+    void sendJsonBody(const String& data);
 };
 
 //------------------------------------------------------------------------------
@@ -69,7 +118,9 @@ protected:
 class StreamHttpAuthenticateReply: public AbstractStreamHttpReply
 {
 public:
-    StreamHttpAuthenticateReply(Stream& stream, const String& contentType);
+    StreamHttpAuthenticateReply(Stream& stream, const String& contentType, Method method = Method::Get);
+    template <size_t MAX_BODY_SIZE>
+    StreamHttpAuthenticateReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType);
     virtual void send();
 };
 #endif
@@ -81,13 +132,96 @@ public:
 class StreamHttpReply: public AbstractStreamHttpReply
 {
 public:
-    StreamHttpReply(Stream& stream, const String& contentType);
+    StreamHttpReply(Stream& stream, const String& contentType, Method method = Method::Get);
+    //! Reply to _request_, on its stream and with the body suppressed for HEAD.
+    template <size_t MAX_BODY_SIZE>
+    StreamHttpReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType);
     virtual void send(const String& data, const bool gzipencoded=false) { AbstractStreamHttpReply::send(data, "OK"); };
     virtual void send(const uint8_t* buf, const size_t size, const String& title="OK") { AbstractStreamHttpReply::send(buf, size, title); };
     virtual void sendHeader(size_t size, const String& title="OK") { AbstractStreamHttpReply::sendHeader(size, title); }
+    bool send(const ReplySegment* pSegments, size_t count, const String& title="OK") { return AbstractStreamHttpReply::send(pSegments, count, title); };
+    //! E.g. send({ReplySegment::flash(F("<p>")), ReplySegment::ram(value), ReplySegment::flash(F("</p>"))}).
+    template <size_t COUNT>
+    bool send(const ReplySegment (&segments)[COUNT], const String& title="OK") { return AbstractStreamHttpReply::send(segments, COUNT, title); };
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Reply with a body of unknown length, sent in chunks as it is written.
+//! \details Each write() becomes one chunk, so write through a buffer, e.g.
+//!    a JsonWriter, rather than byte by byte. end() terminates the body.
+//!    Replying to a HEAD request, writes are accepted and dropped. Once the
+//!    stream stops accepting data in the middle of a chunk, the reply has
+//!    failed: nothing more is sent, so the framing is never corrupted, and
+//!    the connection has to be closed.
+class StreamHttpChunkedReply: public AbstractStreamHttpReply, public Print
+{
+public:
+    StreamHttpChunkedReply(Stream& stream, const String& contentType, const String& code = "200", Method method = Method::Get);
+    template <size_t MAX_BODY_SIZE>
+    StreamHttpChunkedReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType, const String& code = "200");
+    void begin(const String& title = "OK", const char* contentEncoding = 0);
+    void end();
+
+    using Print::write;
+    virtual size_t write(uint8_t byte);
+    virtual size_t write(const uint8_t* buffer, size_t size);
+
+    inline bool hasFailed() const { return m_failed; };
+
+private:
+    bool writeChunkHeader(size_t size, bool last);
+    bool writeAll(const uint8_t* buffer, size_t size);
+
+    size_t m_bytesWritten;
+    bool m_chunkOpen; //!< A chunk was written whose trailing CRLF is still pending.
+    bool m_failed; //!< The stream did not take a whole chunk.
 };
 
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::StreamHttpErrorReply::StreamHttpErrorReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType) :
+   AbstractStreamHttpReply(request.getStream(), contentType, request.getErrorStatusCode(), request.getMethod())
+{
+   setInputToDiscard(getInputToDiscard(request));
+}
+
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::StreamHttpErrorReply::StreamHttpErrorReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType, const String& code) :
+   AbstractStreamHttpReply(request.getStream(), contentType, code, request.getMethod())
+{
+   setInputToDiscard(getInputToDiscard(request));
+}
 
+#ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::StreamHttpAuthenticateReply::StreamHttpAuthenticateReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType) :
+   AbstractStreamHttpReply(request.getStream(), contentType, "401", request.getMethod())
+{
+   setInputToDiscard(getInputToDiscard(request));
+}
+#endif
+
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::StreamHttpReply::StreamHttpReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType) :
+   AbstractStreamHttpReply(request.getStream(), contentType, "200", request.getMethod())
+{
+   setInputToDiscard(getInputToDiscard(request));
+}
+
+template <size_t MAX_BODY_SIZE>
+ArduinoHttpServer::StreamHttpChunkedReply::StreamHttpChunkedReply(StreamHttpRequest<MAX_BODY_SIZE>& request, const String& contentType, const String& code) :
+   AbstractStreamHttpReply(request.getStream(), contentType, code, request.getMethod()),
+   m_bytesWritten(0),
+   m_chunkOpen(false),
+   m_failed(false)
+{
+   setInputToDiscard(getInputToDiscard(request));
 }
 
 #endif // __ArduinoHttpServer__StreamHttpReply__
@@ -10,110 +10,69 @@
 #ifndef __ArduinoHttpServer__StreamHttpRequest__
 #define __ArduinoHttpServer__StreamHttpRequest__
 
-#include "FixString.hpp"
-#include "HttpResource.hpp"
-#include "HttpField.hpp"
-#include "HttpVersion.hpp"
+#include "HttpRequestParser.hpp"
+#include "StreamDiscard.hpp"
 #include "ArduinoHttpServerDebug.h"
 
 #include <Arduino.h>
-#ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
-   #include <Base64.h>
-#endif
-
-#include <string.h>
 
 namespace ArduinoHttpServer
 {
 
-enum class Method : char
-{
-   Invalid, Get, Put, Post, Head, Delete
-};
-
-
-typedef FixString<32> ErrorMessageString;
-typedef FixString<128> ErrorString;
-
 //------------------------------------------------------------------------------
 //                             Class Declaration
 //------------------------------------------------------------------------------
 //! HTTP request read from a _Stream_.
+//! \details Feeds an HttpRequestParser from the stream within the deadlines
+//!    of RequestLimits. Streams offering the ESP8266 bulk peek API (e.g.
+//!    WiFiClient) are parsed directly in their receive buffer. Otherwise the
+//!    header is read byte by byte, so nothing beyond the request is consumed,
+//!    and the body is read in bulk. Clients sending "Expect: 100-continue"
+//!    are answered with "100 Continue" as soon as the header has been read
+//!    and accepted by the filter, if any.
 template <size_t MAX_BODY_SIZE>
-class StreamHttpRequest
+class StreamHttpRequest: public HttpRequestParser<MAX_BODY_SIZE>
 {
 
 public:
+    using Error = ArduinoHttpServer::RequestError;
+
     StreamHttpRequest(Stream& stream);
 
     ~StreamHttpRequest() { };
 
     bool readRequest();
 
-    // Header retrieval methods.
-    inline const ArduinoHttpServer::HttpResource& getResource() const { return m_resource; };
-    inline const ArduinoHttpServer::HttpVersion& getVersion() const { return m_version; };
-    inline const ArduinoHttpServer::Method getMethod() const { return m_method; };
-
-    // Field retrieval methods.
-    inline const String& getContentType() const { return m_contentTypeField.getValueAsString(); };
-    inline const int getContentLength() const { return m_contentLengthField.getValueAsInt(); };
+    bool discardBody();
 
-    // Body retrieval methods.
-    //! Retrieve zero terminated body content.
-    inline const char* const getBody() const { return m_body; };
+    bool streamBody(Print& sink);
 
-    // State retrieval
-    const ErrorString getError() const;
     Stream& getStream() { return m_stream; };
 
-    // Validate if client provided credentials match _username_ and _password_.
-    #ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
-    bool authenticate(const char * username, const char * password) const;
-    #endif
-
 private:
+   using Parser = HttpRequestParser<MAX_BODY_SIZE>;
+   using State = typename Parser::State;
 
-   enum class Error: char {
-      OK,
-      TIMEOUT,
-      CANNOT_HANDLE_HTTP_METHOD,
-      PARSE_ERROR_INVALID_HTTP_VERSION,
-      PARSE_ERROR_NO_RESOURCE
-   };
-
-   //! \todo To reduce program memory size reduce these to the proper types: char and int.
-   //!    Or better yet, make these Template variables.
-   static const int MAX_LINE_SIZE = 255+1;
-   static const int MAX_BODY_LENGTH = MAX_BODY_SIZE-1; //!< Byte size of array. Leaves space for terminating \0.
-   static const long LINE_READ_TIMEOUT_MS = 10000L; //!< [ms] Wait 10s for reception of a complete line.
-   static const int MAX_RETRIES_WAIT_DATA_AVAILABLE = 255;
-
-   void parseRequest(char lineBuffer[MAX_LINE_SIZE]);
-   void parseMethod(char lineBuffer[MAX_LINE_SIZE]);
-   void parseResource();
-   void parseVersion();
-   void parseField(char lineBuffer[MAX_LINE_SIZE]);
-
-   void neglectToken();
+   static const long LINE_READ_TIMEOUT_MS = 10000L; //!< [ms] Default Stream timeout for application reads.
+   static const unsigned long WAIT_DATA_AVAILABLE_POLL_MS = 10UL;
+   static const size_t HEADER_CHUNK_SIZE = 32U; //!< Stack buffer collecting header bytes for the parser.
+   static const size_t BODY_CHUNK_SIZE = 64U; //!< Stack buffer passing streamed body bytes on.
 
-   bool readLine(char lineBuffer[MAX_LINE_SIZE]);
+   void readHeader();
+   void sendContinue();
+   void readBody();
+   #ifdef STREAMSEND_API
+   void readPeekBuffer();
+   #endif
 
-   void setError(const Error, const ErrorMessageString& errorMessage = ErrorMessageString());
+   void startPhase(unsigned long timeoutMs, Error timeoutError);
+   bool checkPhaseExpired();
 
    Stream& m_stream;
-   char m_body[MAX_BODY_SIZE];
-   Method m_method;
-   ArduinoHttpServer::HttpResource m_resource;
-   ArduinoHttpServer::HttpVersion m_version;
-   ArduinoHttpServer::HttpField m_contentTypeField;
-   ArduinoHttpServer::HttpField m_contentLengthField;
-   ArduinoHttpServer::HttpField m_authorizationField;
-
-   Error m_error;
-   ErrorMessageString m_errorDetail;
-
-   char *m_lineBufferStrTokContext;
+
+   unsigned long m_phaseStartMs;
+   unsigned long m_phaseTimeoutMs;
+   Error m_phaseTimeoutError;
 };
 
 }
@@ -126,18 +85,12 @@ private:
 //! \brief Constructor. sets Stream timeout for reading data.
 template <size_t MAX_BODY_SIZE>
 ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::StreamHttpRequest(Stream& stream) :
+    Parser(),
     m_stream(stream),
-    m_body{0},
-    m_method(Method::Invalid),
-    m_resource(),
-    m_version(),
-    m_contentTypeField(),
-    m_contentLengthField(),
-    m_error(Error::OK),
-    m_errorDetail(),
-    m_lineBufferStrTokContext(0)
+    m_phaseStartMs(0),
+    m_phaseTimeoutMs(0),
+    m_phaseTimeoutError(Error::TIMEOUT)
 {
-   static_assert(MAX_BODY_SIZE >= 0, "HTTP body length less then zero specified.");
    m_stream.setTimeout(LINE_READ_TIMEOUT_MS);
 }
 
@@ -146,280 +99,297 @@ ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::StreamHttpRequest(Stream& s
 template <size_t MAX_BODY_SIZE>
 bool ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::readRequest()
 {
+   AHS_TRACE(REQUEST_START, 0);
+   if(this->m_observer)
+   {
+      this->m_observer->requestStarted(micros());
+   }
 
-   char lineBuffer[MAX_LINE_SIZE] = {0};
-
-   int attempts(0);
+   startPhase(this->getLimits().firstByteTimeoutMs, Error::TIMEOUT);
    while(!m_stream.available())
    {
-      // Quit when failed to retrieve data after n retries.
-      if(attempts >= MAX_RETRIES_WAIT_DATA_AVAILABLE)
+      if(checkPhaseExpired())
       {
-         setError(Error::TIMEOUT);
          break;
       }
 
-      delay(10);
-      ++attempts;
+      delay(WAIT_DATA_AVAILABLE_POLL_MS);
    }
+   AHS_TRACE(DATA_AVAILABLE, millis() - m_phaseStartMs);
+   this->notifyPhaseEnded(AbstractHttpObserver::Phase::WAIT_FOR_DATA);
 
-   // Read complete line.
-   if(readLine(lineBuffer))
+   #ifdef STREAMSEND_API
+   if(m_stream.hasPeekBufferAPI())
    {
-      // Parse the request header (first line).
-      parseRequest(lineBuffer);
-
-      // Keep parsing fields until an empty line has been found (with only new line / carriage return).
-      while (readLine(lineBuffer))
+      readPeekBuffer();
+   }
+   else
+   #endif
+   {
+      readHeader();
+      if(this->getState() == State::BODY || this->getState() == State::COMPLETE)
       {
-         parseField(lineBuffer);
+         sendContinue();
       }
-
-      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("HTTP field parsing complete.");
-
-      // Parse body.
-      int contentLength(getContentLength());
-      if (contentLength > MAX_BODY_LENGTH)
+      if(this->getState() == State::BODY)
       {
-         DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("Content-Length larger then the maximum content we can consume. Trunkating body.");
-         contentLength = MAX_BODY_LENGTH;
+         readBody();
       }
+   }
 
-      DEBUG_ARDUINO_HTTP_SERVER_PRINT("Content-Length: ");
-      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(contentLength);
-
-      if(contentLength > 0)
-      {
-         DEBUG_ARDUINO_HTTP_SERVER_PRINT("Parsing body .... ");
-         m_stream.readBytes(m_body, contentLength);
-         DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("done");
-      }
+   AHS_TRACE(REQUEST_DONE, this->getErrorCode());
+   if(this->m_observer)
+   {
+      this->m_observer->requestRead(this->getMethod(), this->getErrorCode(), this->m_bytesRead, this->m_headerCount);
    }
 
-   return m_error == Error::OK;
+   return this->getErrorCode() == Error::OK;
 }
 
-
 //------------------------------------------------------------------------------
-//! \brief Read a single line from Stream into _linebuffer_
+//! \brief Feed the request line and fields to the parser.
+//! \details The request line and all fields have to arrive within a single
+//!    deadline. Reads a byte at a time so the body, or the next request,
+//!    stays in the stream, but feeds the parser up to a line at a time.
 template <size_t MAX_BODY_SIZE>
-bool ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::readLine(char linebuffer[])
+void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::readHeader()
 {
-    if(m_error!=Error::OK) { return false; }
+   startPhase(this->getLimits().headerTimeoutMs, Error::HEADER_TIMEOUT);
 
-    int bytesRead(0);
+   char chunk[HEADER_CHUNK_SIZE];
+   size_t chunkLength(0);
 
-    memset(linebuffer, 0, MAX_LINE_SIZE);
-    bytesRead = m_stream.readBytesUntil('\r', linebuffer, MAX_LINE_SIZE);
-
-    // Read away remaining new-line and carriage returns
-    for (int i=0; i<2 && m_stream.read() != '\n'; i++)
-    {
-        // Allow SoftwareSerial to process incomming data.
-        delay(2);
-    }
+   while (this->getState() == State::REQUEST_LINE || this->getState() == State::FIELDS)
+   {
+      const int ch(m_stream.read());
+      if (ch < 0)
+      {
+         if (checkPhaseExpired())
+         {
+            return;
+         }
+
+         // Allow SoftwareSerial and network stacks to process incomming data.
+         yield();
+         continue;
+      }
 
-    return bytesRead > 0 ;
+      // Only a line end can end the header, so nothing is read beyond it.
+      chunk[chunkLength++] = static_cast<char>(ch);
+      if (ch == '\n' || chunkLength == HEADER_CHUNK_SIZE)
+      {
+         this->feed(chunk, chunkLength);
+         chunkLength = 0;
+      }
+   }
 }
 
 //------------------------------------------------------------------------------
-//! \brief Parse first line of HTTP request.
+//! \brief Let a client waiting for "100 Continue" send its body.
+//! \details Called once the header has been read and accepted. A client
+//!    whose request the filter rejected gets the final error reply instead
+//!    and does not send the body at all.
 template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::parseRequest(char lineBuffer[])
+void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::sendContinue()
 {
-    parseMethod(lineBuffer);
-    parseResource();
-    parseVersion();
+   if (!this->expectsContinue() || this->getContentLength() <= 0)
+   {
+      return;
+   }
+
+   m_stream.print(AHS_F("HTTP/1.1 100 Continue\r\n\r\n"));
 }
 
 //------------------------------------------------------------------------------
-//! \brief Parse method: GET, PUT, HEAD, etc.
+//! \brief Read the body straight into the parser's body buffer within the body deadline.
 template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::parseMethod(char lineBuffer[])
+void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::readBody()
 {
-   if(m_error!=Error::OK) { return; }
+   startPhase(this->getLimits().bodyTimeoutMs, Error::BODY_TIMEOUT);
 
-   // First strtok call, initialize with cached line buffer.
-   // len("DELETE") + 1 for terminating null = 7
-   FixString<7U> token(strtok_r(lineBuffer, " ", &m_lineBufferStrTokContext));
-
-   if(token == "GET")
-   {
-      m_method = Method::Get;
-   }
-   else if (token == "PUT")
-   {
-      m_method = Method::Put;
-   }
-   else if (token == "POST")
-   {
-      m_method = Method::Post;
-   }
-   else if (token == "HEAD")
-   {
-      m_method = Method::Head;
-   }
-   else if (token == "DELETE")
-   {
-      m_method = Method::Delete;
-   }
-   else
+   while (this->getState() == State::BODY)
    {
-      m_method = Method::Invalid;
-      setError(Error::CANNOT_HANDLE_HTTP_METHOD, token);
+      const int available(m_stream.available());
+      if (available > 0)
+      {
+         size_t chunkSize(this->getBodySpace());
+         if (static_cast<size_t>(available) < chunkSize)
+         {
+            chunkSize = available;
+         }
+         this->bodyReceived(m_stream.readBytes(this->getBodyEnd(), chunkSize));
+      }
+      else if (checkPhaseExpired())
+      {
+         break;
+      }
+      else
+      {
+         yield();
+      }
    }
 }
 
-//! Parse "HTTP/1.1" (or any other version).
+#ifdef STREAMSEND_API
+//------------------------------------------------------------------------------
+//! \brief Feed the parser straight from the stream's receive buffer.
+//! \details The parser stops consuming at the end of the request, so only
+//!    the request is taken from the stream. Applies the header deadline until
+//!    the header is complete and the body deadline after that.
 template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::parseVersion()
+void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::readPeekBuffer()
 {
-    if(m_error!=Error::OK) { return; }
+   startPhase(this->getLimits().headerTimeoutMs, Error::HEADER_TIMEOUT);
 
-    // HTTP/000.000
-    HttpVersion::FixStringT version(strtok_r(0, " ", &m_lineBufferStrTokContext));
-
-    //String version(strtok_r(0, " ", &m_lineBufferStrTokContext));
-    int slashPosition(version.lastIndexOf('/'));
+   while (!this->isDone())
+   {
+      const size_t available(m_stream.peekAvailable());
+      if (available == 0)
+      {
+         if (checkPhaseExpired())
+         {
+            return;
+         }
 
-    // String returns unsigned int for length.
-    if (static_cast<unsigned int>(slashPosition) < version.length() && slashPosition > 0)
-    {
-        m_version = HttpVersion(version.substring(slashPosition));
-    }
-    else
-    {
-        setError(Error::PARSE_ERROR_INVALID_HTTP_VERSION, version);
+         yield();
+         continue;
+      }
 
-    }
+      const bool inHeader(this->getState() != State::BODY);
+      m_stream.peekConsume(this->feed(m_stream.peekBuffer(), available));
 
+      if (inHeader && (this->getState() == State::BODY || this->getState() == State::COMPLETE))
+      {
+         sendContinue();
+      }
+      if (inHeader && this->getState() == State::BODY)
+      {
+         startPhase(this->getLimits().bodyTimeoutMs, Error::BODY_TIMEOUT);
+      }
+   }
 }
+#endif
 
+//------------------------------------------------------------------------------
+//! \brief Skip the body bytes which were not read into the body buffer.
+//! \details Leaves a pipelined next request untouched. Refuses to discard
+//!    more than RequestLimits::maxDiscardBytes.
+//! \returns False when the body could not be discarded completely; close the
+//!    connection in that case.
 template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::parseResource()
+bool ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::discardBody()
 {
-   if(m_error!=Error::OK) { return; }
+   if (this->m_unreadBodyLength > this->getLimits().maxDiscardBytes)
+   {
+      AHS_TRACE(DISCARD_REFUSED, this->m_unreadBodyLength);
+      return false;
+   }
 
-    String resource( strtok_r(0, " ", &m_lineBufferStrTokContext) );
-    m_resource = ArduinoHttpServer::HttpResource(resource);
+   const size_t discarded(discardInput(m_stream, this->m_unreadBodyLength, this->getLimits().discardTimeoutMs));
+   this->m_bytesRead += discarded;
+   this->m_unreadBodyLength -= discarded;
 
-    if (!m_resource.isValid())
-    {
-        setError(Error::PARSE_ERROR_NO_RESOURCE);
-    }
-}
-
-template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::neglectToken()
-{
-    strtok_r(0, " ", &m_lineBufferStrTokContext);
+   return this->m_unreadBodyLength == 0;
 }
 
+//------------------------------------------------------------------------------
+//! \brief Write the whole body to _sink_: the part in the body buffer, then
+//!    the unread rest straight from the stream, a chunk at a time.
+//! \details Lets handlers process bodies larger than MAX_BODY_SIZE in constant
+//!    RAM, e.g. with a JsonTokenizer as sink. Streams offering the bulk peek
+//!    API are passed to the sink from their receive buffer without copying.
+//!    Call once, after readRequest(). The rest of the body has to arrive
+//!    within RequestLimits::streamBodyTimeoutMs, however steadily it trickles.
+//! \returns False when the body ended early, timed out (BODY_TIMEOUT) or
+//!    the sink accepted less than it was given.
 template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::parseField(char lineBuffer[])
+bool ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::streamBody(Print& sink)
 {
-   if(m_error!=Error::OK) { return; }
-
-   ArduinoHttpServer::HttpField httpField(lineBuffer);
-
-   if(httpField.getType() == ArduinoHttpServer::HttpField::Type::CONTENT_TYPE)
-   {
-      m_contentTypeField = httpField;
-   }
-   else if(httpField.getType() == ArduinoHttpServer::HttpField::Type::CONTENT_LENGTH)
+   const size_t buffered(this->getBodyLength());
+   if (buffered > 0 && sink.write(reinterpret_cast<const uint8_t*>(this->getBody()), buffered) != buffered)
    {
-      m_contentLengthField = httpField;
-   }
-   else if(httpField.getType() == ArduinoHttpServer::HttpField::Type::AUTHORIZATION)
-   {
-      m_authorizationField = httpField;
-   }
-   else
-   {
-      // Ignore other fields for now.
+      return false;
    }
-}
-
-template <size_t MAX_BODY_SIZE>
-void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::setError(const Error error, const ErrorMessageString& errorMessage)
-{
-   m_error = error;
-   m_errorDetail = errorMessage;
-}
 
-template <size_t MAX_BODY_SIZE>
-const ArduinoHttpServer::ErrorString ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::getError() const
-{
-   ErrorString errorString;
-   switch(m_error)
+   startPhase(this->getLimits().streamBodyTimeoutMs, Error::BODY_TIMEOUT);
+   while (this->m_unreadBodyLength > 0)
    {
-      case Error::OK:
-         break;
-
-      case Error::TIMEOUT:
-         errorString = AHS_F("Timeout occurred while waiting for data");
-         break;
+      // Checked while data keeps arriving too, so the deadline is absolute.
+      if (checkPhaseExpired())
+      {
+         return false;
+      }
 
-      case Error::CANNOT_HANDLE_HTTP_METHOD:
-         errorString = AHS_F("Don't know how to handle HTTP method: \"");
-         errorString += m_errorDetail;
-         errorString += AHS_F("\"");
-         break;
+      size_t length(0);
+      size_t written(0);
+      size_t consumed(0);
 
-      case Error::PARSE_ERROR_INVALID_HTTP_VERSION:
-         errorString = AHS_F("Invalid HTTP version: \"");
-         errorString += m_errorDetail;
-         errorString += AHS_F("\"");
-         break;
+      #ifdef STREAMSEND_API
+      if (m_stream.hasPeekBufferAPI())
+      {
+         length = m_stream.peekAvailable();
+         length = length < this->m_unreadBodyLength ? length : this->m_unreadBodyLength;
+         if (length > 0)
+         {
+            written = sink.write(reinterpret_cast<const uint8_t*>(m_stream.peekBuffer()), length);
+            consumed = written;
+            m_stream.peekConsume(consumed);
+         }
+      }
+      else
+      #endif
+      {
+         char chunk[BODY_CHUNK_SIZE];
+         const int available(m_stream.available());
+         length = available > 0 ? static_cast<size_t>(available) : 0U;
+         length = length < sizeof(chunk) ? length : sizeof(chunk);
+         length = length < this->m_unreadBodyLength ? length : this->m_unreadBodyLength;
+         if (length > 0)
+         {
+            length = m_stream.readBytes(chunk, length);
+            consumed = length;
+            written = sink.write(reinterpret_cast<const uint8_t*>(chunk), length);
+         }
+      }
 
-      case Error::PARSE_ERROR_NO_RESOURCE:
-         errorString = AHS_F("No resource specified.");
-         break;
+      this->m_bytesRead += consumed;
+      this->m_unreadBodyLength -= consumed;
+      if (written < length)
+      {
+         return false;
+      }
 
-      default:
-         break;
+      if (consumed == 0)
+      {
+         yield();
+      }
    }
-
-   return errorString;
+   return true;
 }
 
-#ifndef ARDUINO_HTTP_SERVER_NO_BASIC_AUTH
+//------------------------------------------------------------------------------
+//! \brief Start a phase which has to complete within _timeoutMs_.
 template <size_t MAX_BODY_SIZE>
-bool ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::authenticate(const char *username, const char *password) const
+void ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::startPhase(unsigned long timeoutMs, Error timeoutError)
 {
-   if (m_authorizationField.getType() == HttpField::Type::NOT_SUPPORTED)
-   {
-      return false;
-   }
-
-   // HTTP value: "<Type> <Base 64 encoded credentials>"
-   // Retrieve type and verify wether it is basic authorization.
-   if(!(m_authorizationField.getSubValueString(0) == HttpField::BASIC_AUTH_TYPE_STR))
-   {
-      DEBUG_ARDUINO_HTTP_SERVER_PRINT("Unsupported authentication type: ");
-      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(m_authorizationField.getSubValueString(0).cStr());
-      return false;
-   }
-
-   FixString<128U> combinedInput(username);
-   combinedInput += AHS_F(":");
-   combinedInput += password;
-
-   const int encodedLength = Base64.encodedLength(combinedInput.length());
-
-   char encodedString[encodedLength+1]; // Base64 makes sure _encodedString_ is zero terminated.
-   Base64.encode(encodedString, const_cast<char*>(combinedInput.cStr()), combinedInput.length());
-   
-   DEBUG_ARDUINO_HTTP_SERVER_PRINT("Credentials string in client supplied auth: ");
-   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(m_authorizationField.getSubValueString(1).cStr() );
+   m_phaseStartMs = millis();
+   m_phaseTimeoutMs = timeoutMs;
+   m_phaseTimeoutError = timeoutError;
+}
 
-   if ( m_authorizationField.getSubValueString(1) == encodedString )
+//------------------------------------------------------------------------------
+//! \brief Fail with the phase's timeout error when its deadline has passed.
+//! \returns True when expired.
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::StreamHttpRequest<MAX_BODY_SIZE>::checkPhaseExpired()
+{
+   // Unsigned subtraction handles millis() wrap around.
+   if (millis() - m_phaseStartMs >= m_phaseTimeoutMs)
    {
+      this->fail(m_phaseTimeoutError);
       return true;
    }
-
    return false;
 }
-#endif
 
 #endif // __ArduinoHttpServer__StreamHttpRequest__
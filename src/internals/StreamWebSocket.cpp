@@ -0,0 +1,498 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! WebSocket (RFC 6455) connection over a Stream.
+
+#include "StreamWebSocket.hpp"
+#include "Sha1.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+#include <string.h>
+
+const char* const ArduinoHttpServer::StreamWebSocket::VERSION = "13";
+
+namespace
+{
+   const char WEBSOCKET_GUID[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+   const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+   const uint8_t FIN_BIT = 0x80U;
+   const uint8_t RESERVED_BITS = 0x70U;
+   const uint8_t OPCODE_BITS = 0x0FU;
+   const uint8_t MASK_BIT = 0x80U;
+   const uint8_t LENGTH_BITS = 0x7FU;
+   const uint8_t LENGTH_16 = 126U;
+   const uint8_t LENGTH_64 = 127U;
+   const uint8_t CONTROL_OPCODE_BIT = 0x08U;
+
+   //! Base64 of _length_ bytes into _pOut_, zero terminated.
+   void encodeBase64(const uint8_t* data, size_t length, char* pOut)
+   {
+      for (size_t i=0; i < length; i += 3)
+      {
+         const uint32_t group((static_cast<uint32_t>(data[i]) << 16) |
+                              (i + 1 < length ? static_cast<uint32_t>(data[i + 1]) << 8 : 0U) |
+                              (i + 2 < length ? static_cast<uint32_t>(data[i + 2]) : 0U));
+         *pOut++ = BASE64_ALPHABET[(group >> 18) & 0x3FU];
+         *pOut++ = BASE64_ALPHABET[(group >> 12) & 0x3FU];
+         *pOut++ = i + 1 < length ? BASE64_ALPHABET[(group >> 6) & 0x3FU] : '=';
+         *pOut++ = i + 2 < length ? BASE64_ALPHABET[group & 0x3FU] : '=';
+      }
+      *pOut = '\0';
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Constructor. Call accept() before anything else.
+ArduinoHttpServer::StreamWebSocket::StreamWebSocket(Stream& stream) :
+   m_stream(stream),
+   m_state(State::CONNECTING),
+   m_readState(ReadState::HEADER),
+   m_header(),
+   m_headerLength(0),
+   m_headerNeeded(2),
+   m_frameOpcode(Opcode::CONTINUATION),
+   m_frameFinal(false),
+   m_mask(),
+   m_maskIndex(0),
+   m_payloadRemaining(0),
+   m_control(),
+   m_controlLength(0),
+   m_messageType(Opcode::TEXT),
+   m_inMessage(false),
+   m_messageComplete(false),
+   m_sendingFragments(false),
+   m_closeCode(0),
+   m_lastPongMs(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send the "101 Switching Protocols" reply for _webSocketKey_.
+//! \details Starts a new connection; an instance can be reused for the next client.
+bool ArduinoHttpServer::StreamWebSocket::accept(const String& webSocketKey)
+{
+   m_readState = ReadState::HEADER;
+   m_headerLength = 0;
+   m_headerNeeded = 2;
+   m_inMessage = false;
+   m_messageComplete = false;
+   m_sendingFragments = false;
+   m_closeCode = 0;
+   m_lastPongMs = millis();
+
+   char acceptKey[29];
+   computeAcceptKey(webSocketKey, acceptKey);
+
+   m_stream.print(AHS_F("HTTP/1.1 101 Switching Protocols\r\n"));
+   m_stream.print(AHS_F("Upgrade: websocket\r\n"));
+   m_stream.print(AHS_F("Connection: Upgrade\r\n"));
+   m_stream.print(AHS_F("Sec-WebSocket-Accept: "));
+   m_stream.print(acceptKey);
+   m_stream.print(AHS_F("\r\n\r\n"));
+
+   m_state = State::OPEN;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Answer a handshake of an unsupported version with "426 Upgrade
+//!    Required", naming the version supported (RFC 6455, 4.4).
+void ArduinoHttpServer::StreamWebSocket::rejectVersion(Stream& stream)
+{
+   stream.print(AHS_F("HTTP/1.1 426 Upgrade Required\r\n"));
+   stream.print(AHS_F("Sec-WebSocket-Version: "));
+   stream.print(VERSION);
+   stream.print(AHS_F("\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"));
+}
+
+//------------------------------------------------------------------------------
+//! \brief Whether comma separated _list_ holds _token_, compared case insensitive.
+//! \details E.g. "keep-alive, Upgrade" holds "upgrade".
+bool ArduinoHttpServer::StreamWebSocket::hasToken(const String& list, const char* token)
+{
+   const size_t tokenLength(strlen(token));
+   const char* pCursor(list.c_str());
+
+   while (*pCursor != '\0')
+   {
+      while (*pCursor == ' ' || *pCursor == '\t' || *pCursor == ',')
+      {
+         ++pCursor;
+      }
+      const char* pEnd(pCursor);
+      while (*pEnd != '\0' && *pEnd != ',')
+      {
+         ++pEnd;
+      }
+
+      size_t length(pEnd - pCursor);
+      while (length > 0 && (pCursor[length - 1] == ' ' || pCursor[length - 1] == '\t'))
+      {
+         --length;
+      }
+      if (length == tokenLength && strncasecmp(pCursor, token, length) == 0)
+      {
+         return true;
+      }
+      pCursor = pEnd;
+   }
+   return false;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Base64(SHA-1(key + GUID)), 28 characters plus terminating zero.
+void ArduinoHttpServer::StreamWebSocket::computeAcceptKey(const String& webSocketKey, char acceptKey[29])
+{
+   Sha1 sha1;
+   sha1.update(reinterpret_cast<const uint8_t*>(webSocketKey.c_str()), webSocketKey.length());
+   sha1.update(reinterpret_cast<const uint8_t*>(WEBSOCKET_GUID), sizeof(WEBSOCKET_GUID) - 1);
+
+   uint8_t digest[Sha1::DIGEST_SIZE];
+   sha1.finish(digest);
+   encodeBase64(digest, sizeof(digest), acceptKey);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Read up to _length_ payload bytes of the current message.
+//! \details Never waits for data. Control frames arriving in between are
+//!    handled internally. isMessageComplete() is true after the call which
+//!    returned the last bytes of a message, which may be 0 bytes.
+//! \returns Bytes read, 0 when nothing is available, -1 once the connection
+//!    is closed.
+int ArduinoHttpServer::StreamWebSocket::read(char* buffer, size_t length)
+{
+   m_messageComplete = false;
+
+   while (m_state == State::OPEN || m_state == State::CLOSING)
+   {
+      if (m_readState == ReadState::HEADER)
+      {
+         if (!readHeader())
+         {
+            return 0;
+         }
+      }
+      else if (m_readState == ReadState::CONTROL_PAYLOAD)
+      {
+         if (!readControlPayload())
+         {
+            return 0;
+         }
+         handleControlFrame();
+      }
+      else
+      {
+         size_t count(length);
+         if (count > m_payloadRemaining)
+         {
+            count = m_payloadRemaining;
+         }
+         const int available(m_stream.available());
+         if (static_cast<size_t>(available > 0 ? available : 0) < count)
+         {
+            count = available > 0 ? available : 0;
+         }
+         if (count == 0 && m_payloadRemaining > 0)
+         {
+            return 0;
+         }
+
+         count = m_stream.readBytes(buffer, count);
+         unmask(buffer, count);
+         m_payloadRemaining -= count;
+
+         if (m_payloadRemaining == 0)
+         {
+            m_readState = ReadState::HEADER;
+            if (m_frameFinal)
+            {
+               m_inMessage = false;
+               m_messageComplete = true;
+            }
+         }
+         return static_cast<int>(count);
+      }
+   }
+   return -1;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Collect the frame header without waiting.
+//! \returns True once a complete header has been parsed.
+bool ArduinoHttpServer::StreamWebSocket::readHeader()
+{
+   while (m_headerLength < m_headerNeeded)
+   {
+      const int ch(m_stream.read());
+      if (ch < 0)
+      {
+         return false;
+      }
+      m_header[m_headerLength++] = static_cast<uint8_t>(ch);
+
+      if (m_headerLength == 2)
+      {
+         if ((m_header[0] & RESERVED_BITS) != 0 || (m_header[1] & MASK_BIT) == 0)
+         {
+            // No extensions were negotiated, and clients always mask.
+            fail(CLOSE_PROTOCOL_ERROR);
+            return false;
+         }
+
+         // Now the size of the extended length is known.
+         const uint8_t lengthCode(m_header[1] & LENGTH_BITS);
+         m_headerNeeded = 2 + (lengthCode == LENGTH_16 ? 2 : (lengthCode == LENGTH_64 ? 8 : 0)) + 4;
+      }
+   }
+
+   const bool parsed(parseHeader());
+   m_headerLength = 0;
+   m_headerNeeded = 2;
+   return parsed;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Validate the collected header and prepare reading its payload.
+bool ArduinoHttpServer::StreamWebSocket::parseHeader()
+{
+   m_frameFinal = (m_header[0] & FIN_BIT) != 0;
+   m_frameOpcode = static_cast<Opcode>(m_header[0] & OPCODE_BITS);
+
+   const uint8_t lengthCode(m_header[1] & LENGTH_BITS);
+   size_t offset(2);
+   unsigned long payloadLength(lengthCode);
+   if (lengthCode == LENGTH_16)
+   {
+      payloadLength = (static_cast<unsigned long>(m_header[2]) << 8) | m_header[3];
+      offset += 2;
+   }
+   else if (lengthCode == LENGTH_64)
+   {
+      // Lengths beyond 32 bits are not supported.
+      if (m_header[2] != 0 || m_header[3] != 0 || m_header[4] != 0 || m_header[5] != 0)
+      {
+         fail(CLOSE_MESSAGE_TOO_BIG);
+         return false;
+      }
+      payloadLength = (static_cast<unsigned long>(m_header[6]) << 24) | (static_cast<unsigned long>(m_header[7]) << 16) |
+                      (static_cast<unsigned long>(m_header[8]) << 8) | m_header[9];
+      offset += 8;
+   }
+   memcpy(m_mask, m_header + offset, sizeof(m_mask));
+   m_maskIndex = 0;
+   m_payloadRemaining = payloadLength;
+
+   if ((static_cast<uint8_t>(m_frameOpcode) & CONTROL_OPCODE_BIT) != 0)
+   {
+      if (!m_frameFinal || payloadLength > MAX_CONTROL_PAYLOAD_SIZE)
+      {
+         fail(CLOSE_PROTOCOL_ERROR);
+         return false;
+      }
+      m_controlLength = 0;
+      m_readState = ReadState::CONTROL_PAYLOAD;
+      return true;
+   }
+
+   if (m_frameOpcode == Opcode::CONTINUATION)
+   {
+      if (!m_inMessage)
+      {
+         fail(CLOSE_PROTOCOL_ERROR);
+         return false;
+      }
+   }
+   else if (m_frameOpcode == Opcode::TEXT || m_frameOpcode == Opcode::BINARY)
+   {
+      if (m_inMessage)
+      {
+         fail(CLOSE_PROTOCOL_ERROR);
+         return false;
+      }
+      m_messageType = m_frameOpcode;
+      m_inMessage = true;
+   }
+   else
+   {
+      fail(CLOSE_PROTOCOL_ERROR);
+      return false;
+   }
+
+   m_readState = ReadState::DATA_PAYLOAD;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//! \returns True once the whole control frame payload has been read.
+bool ArduinoHttpServer::StreamWebSocket::readControlPayload()
+{
+   while (m_payloadRemaining > 0)
+   {
+      const int available(m_stream.available());
+      if (available <= 0)
+      {
+         return false;
+      }
+      size_t count(m_payloadRemaining);
+      if (static_cast<size_t>(available) < count)
+      {
+         count = available;
+      }
+      count = m_stream.readBytes(reinterpret_cast<char*>(m_control + m_controlLength), count);
+      unmask(reinterpret_cast<char*>(m_control + m_controlLength), count);
+      m_controlLength += count;
+      m_payloadRemaining -= count;
+   }
+   m_readState = ReadState::HEADER;
+   return true;
+}
+
+void ArduinoHttpServer::StreamWebSocket::handleControlFrame()
+{
+   switch (m_frameOpcode)
+   {
+      case Opcode::PING:
+         if (m_state == State::OPEN)
+         {
+            sendFrame(Opcode::PONG, m_control, m_controlLength, true);
+         }
+         break;
+
+      case Opcode::PONG:
+         m_lastPongMs = millis();
+         break;
+
+      case Opcode::CLOSE:
+         m_closeCode = m_controlLength >= 2 ? (static_cast<uint16_t>(m_control[0]) << 8) | m_control[1] : CLOSE_NORMAL;
+         if (m_state == State::OPEN)
+         {
+            // Echo the status code, as the closing handshake requires.
+            sendFrame(Opcode::CLOSE, m_control, m_controlLength >= 2 ? 2 : 0, true);
+         }
+         m_state = State::CLOSED;
+         break;
+
+      default:
+         break;
+   }
+}
+
+void ArduinoHttpServer::StreamWebSocket::unmask(char* data, size_t length)
+{
+   for (size_t i=0; i < length; ++i)
+   {
+      data[i] ^= m_mask[m_maskIndex];
+      m_maskIndex = (m_maskIndex + 1) & 3U;
+   }
+}
+
+size_t ArduinoHttpServer::StreamWebSocket::send(const String& text)
+{
+   return sendFrame(Opcode::TEXT, reinterpret_cast<const uint8_t*>(text.c_str()), text.length(), true);
+}
+
+size_t ArduinoHttpServer::StreamWebSocket::send(const char* text)
+{
+   return sendFrame(Opcode::TEXT, reinterpret_cast<const uint8_t*>(text), strlen(text), true);
+}
+
+size_t ArduinoHttpServer::StreamWebSocket::sendBinary(const uint8_t* data, size_t length)
+{
+   return sendFrame(Opcode::BINARY, data, length, true);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Send part of a message whose total size is not known up front.
+//! \details Pass TEXT or BINARY with the first fragment and CONTINUATION with
+//!    the following ones; set _final_ with the last one. Control frames may be
+//!    sent in between.
+size_t ArduinoHttpServer::StreamWebSocket::sendFragment(Opcode opcode, const uint8_t* data, size_t length, bool final)
+{
+   if ((opcode == Opcode::CONTINUATION) != m_sendingFragments)
+   {
+      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("WebSocket fragment out of sequence.");
+      return 0;
+   }
+   m_sendingFragments = !final;
+   return sendFrame(opcode, data, length, final);
+}
+
+size_t ArduinoHttpServer::StreamWebSocket::ping(const uint8_t* data, size_t length)
+{
+   return sendFrame(Opcode::PING, data, length > MAX_CONTROL_PAYLOAD_SIZE ? MAX_CONTROL_PAYLOAD_SIZE : length, true);
+}
+
+//------------------------------------------------------------------------------
+//! \brief Start the closing handshake; read() returns -1 once the peer confirmed.
+void ArduinoHttpServer::StreamWebSocket::close(uint16_t code)
+{
+   if (m_state != State::OPEN)
+   {
+      return;
+   }
+
+   const uint8_t payload[2] = { static_cast<uint8_t>(code >> 8), static_cast<uint8_t>(code) };
+   sendFrame(Opcode::CLOSE, payload, sizeof(payload), true);
+   m_closeCode = code;
+   m_state = State::CLOSING;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write one unmasked frame.
+//! \returns Bytes written, header included.
+size_t ArduinoHttpServer::StreamWebSocket::sendFrame(Opcode opcode, const uint8_t* data, size_t length, bool final)
+{
+   if (m_state != State::OPEN)
+   {
+      return 0;
+   }
+
+   uint8_t header[10];
+   size_t headerLength(2);
+   header[0] = (final ? FIN_BIT : 0U) | static_cast<uint8_t>(opcode);
+   if (length < LENGTH_16)
+   {
+      header[1] = static_cast<uint8_t>(length);
+   }
+   else if (length <= 0xFFFFU)
+   {
+      header[1] = LENGTH_16;
+      header[2] = static_cast<uint8_t>(length >> 8);
+      header[3] = static_cast<uint8_t>(length);
+      headerLength = 4;
+   }
+   else
+   {
+      const unsigned long length32(length);
+      header[1] = LENGTH_64;
+      memset(header + 2, 0, 4);
+      header[6] = static_cast<uint8_t>(length32 >> 24);
+      header[7] = static_cast<uint8_t>(length32 >> 16);
+      header[8] = static_cast<uint8_t>(length32 >> 8);
+      header[9] = static_cast<uint8_t>(length32);
+      headerLength = 10;
+   }
+
+   size_t bytesWritten(m_stream.write(header, headerLength));
+   if (length > 0)
+   {
+      bytesWritten += m_stream.write(data, length);
+   }
+   return bytesWritten;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Close because the peer broke the protocol. The connection is unusable.
+void ArduinoHttpServer::StreamWebSocket::fail(uint16_t code)
+{
+   DEBUG_ARDUINO_HTTP_SERVER_PRINT("WebSocket protocol error, closing: ");
+   DEBUG_ARDUINO_HTTP_SERVER_PRINTLN(code);
+   close(code);
+   m_state = State::CLOSED;
+}
@@ -0,0 +1,193 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! WebSocket (RFC 6455) connection over a Stream.
+
+#ifndef __ArduinoHttpServer__StreamWebSocket__
+#define __ArduinoHttpServer__StreamWebSocket__
+
+#include <Arduino.h>
+
+#include "HttpRequestParser.hpp"
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Server side of a WebSocket connection, upgraded from an HTTP request.
+//! \details Reading never blocks: read() returns whatever payload of the
+//!    current message is available and answers pings and close frames on the
+//!    way. Messages are streamed, so they can be larger than any buffer.
+//!    Writing sends unmasked frames, optionally fragmented. The stream is
+//!    never flush()ed: on the ESP32 core 2.x that discards received data,
+//!    such as the client's first frame, and write() sends by itself.
+class StreamWebSocket
+{
+
+public:
+   enum class Opcode : uint8_t
+   {
+      CONTINUATION = 0x0,
+      TEXT = 0x1,
+      BINARY = 0x2,
+      CLOSE = 0x8,
+      PING = 0x9,
+      PONG = 0xA
+   };
+
+   enum class State : char
+   {
+      CONNECTING, //!< Handshake not sent yet.
+      OPEN,
+      CLOSING,    //!< Close frame sent, waiting for the peer's.
+      CLOSED
+   };
+
+   static const uint16_t CLOSE_NORMAL = 1000U;
+   static const uint16_t CLOSE_GOING_AWAY = 1001U;
+   static const uint16_t CLOSE_PROTOCOL_ERROR = 1002U;
+   static const uint16_t CLOSE_MESSAGE_TOO_BIG = 1009U;
+
+   StreamWebSocket(Stream& stream);
+
+   static const char* const VERSION; //!< The protocol version supported, "13".
+
+   template <size_t MAX_BODY_SIZE>
+   static bool isUpgradeRequest(const HttpRequestParser<MAX_BODY_SIZE>& request);
+   template <size_t MAX_BODY_SIZE>
+   static bool isOtherVersionRequest(const HttpRequestParser<MAX_BODY_SIZE>& request);
+   template <size_t MAX_BODY_SIZE>
+   bool accept(const HttpRequestParser<MAX_BODY_SIZE>& request);
+   bool accept(const String& webSocketKey);
+   static void rejectVersion(Stream& stream);
+
+   // Receiving.
+   int read(char* buffer, size_t length);
+   inline Opcode getMessageType() const { return m_messageType; };
+   inline bool isMessageComplete() const { return m_messageComplete; };
+
+   // Sending.
+   size_t send(const String& text);
+   size_t send(const char* text);
+   size_t sendBinary(const uint8_t* data, size_t length);
+   size_t sendFragment(Opcode opcode, const uint8_t* data, size_t length, bool final);
+   size_t ping(const uint8_t* data = 0, size_t length = 0);
+   void close(uint16_t code = CLOSE_NORMAL);
+
+   inline State getState() const { return m_state; };
+   inline bool isOpen() const { return m_state == State::OPEN; };
+   inline uint16_t getCloseCode() const { return m_closeCode; };
+   inline unsigned long getLastPongMs() const { return m_lastPongMs; };
+
+   static void computeAcceptKey(const String& webSocketKey, char acceptKey[29]);
+
+private:
+   template <size_t MAX_BODY_SIZE>
+   static bool isHandshake(const HttpRequestParser<MAX_BODY_SIZE>& request);
+   static bool hasToken(const String& list, const char* token);
+
+   static const size_t MAX_HEADER_SIZE = 14U;
+   static const size_t MAX_CONTROL_PAYLOAD_SIZE = 125U;
+
+   enum class ReadState : char
+   {
+      HEADER,
+      CONTROL_PAYLOAD,
+      DATA_PAYLOAD
+   };
+
+   bool readHeader();
+   bool parseHeader();
+   bool readControlPayload();
+   void handleControlFrame();
+   void unmask(char* data, size_t length);
+   size_t sendFrame(Opcode opcode, const uint8_t* data, size_t length, bool final);
+   void fail(uint16_t code);
+
+   Stream& m_stream;
+   State m_state;
+
+   ReadState m_readState;
+   uint8_t m_header[MAX_HEADER_SIZE];
+   uint8_t m_headerLength;
+   uint8_t m_headerNeeded;
+   Opcode m_frameOpcode;
+   bool m_frameFinal;
+   uint8_t m_mask[4];
+   uint8_t m_maskIndex;
+   unsigned long m_payloadRemaining;
+
+   uint8_t m_control[MAX_CONTROL_PAYLOAD_SIZE];
+   uint8_t m_controlLength;
+
+   Opcode m_messageType;
+   bool m_inMessage;
+   bool m_messageComplete;
+   bool m_sendingFragments;
+
+   uint16_t m_closeCode;
+   unsigned long m_lastPongMs;
+};
+
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+//! \brief Whether _request_ asks to switch to the WebSocket protocol, version 13.
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::StreamWebSocket::isUpgradeRequest(const HttpRequestParser<MAX_BODY_SIZE>& request)
+{
+   return isHandshake(request) && request.getWebSocketVersion() == VERSION;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Whether _request_ is a WebSocket handshake of a version other than
+//!    13, to be answered with rejectVersion().
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::StreamWebSocket::isOtherVersionRequest(const HttpRequestParser<MAX_BODY_SIZE>& request)
+{
+   return isHandshake(request) && request.getWebSocketVersion() != VERSION;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Complete the handshake when _request_ is an upgrade request.
+//! \details A handshake of another version is answered by rejectVersion().
+//! \returns False when the connection was not upgraded. Nothing is written
+//!    when _request_ is no handshake at all.
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::StreamWebSocket::accept(const HttpRequestParser<MAX_BODY_SIZE>& request)
+{
+   if (isOtherVersionRequest(request))
+   {
+      rejectVersion(m_stream);
+      return false;
+   }
+   if (!isUpgradeRequest(request))
+   {
+      return false;
+   }
+   return accept(request.getWebSocketKey());
+}
+
+//------------------------------------------------------------------------------
+//! \brief Whether _request_ is a WebSocket opening handshake (RFC 6455, 4.2.1),
+//!    of any version.
+template <size_t MAX_BODY_SIZE>
+bool ArduinoHttpServer::StreamWebSocket::isHandshake(const HttpRequestParser<MAX_BODY_SIZE>& request)
+{
+   return request.getMethod() == Method::Get &&
+          hasToken(request.getUpgrade(), "websocket") &&
+          hasToken(request.getConnection(), "upgrade") &&
+          request.getWebSocketKey().length() > 0;
+}
+
+#endif // __ArduinoHttpServer__StreamWebSocket__
@@ -0,0 +1,160 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming {{placeholder}} substitution in templates stored in flash.
+
+#include "TemplateRenderer.hpp"
+#include "ArduinoHttpServerDebug.h"
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::AbstractTemplateRenderer::AbstractTemplateRenderer(AbstractTemplateHandler& handler, char* pBuffer, size_t bufferSize) :
+   m_handler(handler),
+   m_pBuffer(pBuffer),
+   m_bufferSize(bufferSize),
+   m_length(0),
+   m_pOut(0),
+   m_failed(false),
+   m_name{0}
+{
+}
+
+//------------------------------------------------------------------------------
+//! \brief Write _pTemplate_ to _out_ with its placeholders substituted.
+//! \returns False when _out_ did not accept all output.
+bool ArduinoHttpServer::AbstractTemplateRenderer::render(PGM_P pTemplate, Print& out)
+{
+   m_pOut = &out;
+   m_length = 0;
+   m_failed = false;
+
+   const size_t templateLength(strlen_P(pTemplate));
+   size_t position(0);
+   while (position < templateLength && !m_failed)
+   {
+      if (m_length == m_bufferSize)
+      {
+         flushBuffer();
+      }
+
+      // Copy the next block to the end of the output, then cut it at the first placeholder.
+      const size_t space(m_bufferSize - m_length);
+      const size_t remaining(templateLength - position);
+      const size_t blockLength(remaining < space ? remaining : space);
+      char* const pBlock(m_pBuffer + m_length);
+      memcpy_P(pBlock, pTemplate + position, blockLength);
+
+      size_t literalLength(blockLength);
+      size_t placeholderLength(0);
+      for (size_t i=0; i < blockLength; ++i)
+      {
+         const char* pOpen(static_cast<const char*>(memchr(pBlock + i, '{', blockLength - i)));
+         if (!pOpen)
+         {
+            break;
+         }
+
+         i = pOpen - pBlock;
+         placeholderLength = readPlaceholder(pTemplate + position + i, remaining - i);
+         if (placeholderLength > 0)
+         {
+            literalLength = i;
+            break;
+         }
+      }
+
+      m_length += literalLength;
+      position += literalLength;
+
+      if (placeholderLength > 0)
+      {
+         m_handler.placeholder(m_name, *this);
+         position += placeholderLength;
+      }
+   }
+
+   flushBuffer();
+   m_pOut = 0;
+   return !m_failed;
+}
+
+size_t ArduinoHttpServer::AbstractTemplateRenderer::write(uint8_t byte)
+{
+   return write(&byte, 1);
+}
+
+size_t ArduinoHttpServer::AbstractTemplateRenderer::write(const uint8_t* buffer, size_t size)
+{
+   if (!m_pOut || m_failed)
+   {
+      return 0;
+   }
+
+   size_t remaining(size);
+   while (remaining > 0)
+   {
+      if (m_length == m_bufferSize)
+      {
+         flushBuffer();
+      }
+
+      const size_t space(m_bufferSize - m_length);
+      const size_t part(remaining < space ? remaining : space);
+      memcpy(m_pBuffer + m_length, buffer, part);
+      m_length += part;
+      buffer += part;
+      remaining -= part;
+   }
+   return size;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Read "{{ name }}" at _pStart_ in flash into m_name.
+//! \returns Length of the placeholder, 0 when there is none.
+size_t ArduinoHttpServer::AbstractTemplateRenderer::readPlaceholder(PGM_P pStart, size_t available)
+{
+   if (available < 4U || pgm_read_byte(pStart + 1) != '{')
+   {
+      return 0;
+   }
+
+   size_t nameLength(0);
+   bool nameEnded(false);
+   for (size_t i=2; i + 1 < available; ++i)
+   {
+      const char ch(static_cast<char>(pgm_read_byte(pStart + i)));
+      if (ch == '}' && pgm_read_byte(pStart + i + 1) == '}')
+      {
+         m_name[nameLength] = '\0';
+         return nameLength > 0 ? i + 2 : 0;
+      }
+
+      if (ch == ' ')
+      {
+         nameEnded = nameLength > 0;
+         continue;
+      }
+
+      if (ch == '{' || ch == '}' || ch == '\n' || nameEnded || nameLength == MAX_NAME_SIZE - 1)
+      {
+         return 0;
+      }
+      m_name[nameLength++] = ch;
+   }
+   return 0;
+}
+
+void ArduinoHttpServer::AbstractTemplateRenderer::flushBuffer()
+{
+   if (m_length > 0 && !m_failed && m_pOut->write(reinterpret_cast<const uint8_t*>(m_pBuffer), m_length) != m_length)
+   {
+      DEBUG_ARDUINO_HTTP_SERVER_PRINTLN("Template output failed.");
+      m_failed = true;
+   }
+   m_length = 0;
+}
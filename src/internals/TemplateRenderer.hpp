@@ -0,0 +1,98 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Streaming {{placeholder}} substitution in templates stored in flash.
+
+#ifndef __ArduinoHttpServer__TemplateRenderer__
+#define __ArduinoHttpServer__TemplateRenderer__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Supplies the values of a template's placeholders.
+class AbstractTemplateHandler
+{
+
+public:
+   virtual ~AbstractTemplateHandler() {};
+
+   //! Write the value of placeholder _name_ to _out_, e.g. with print().
+   //! Unknown names can simply write nothing.
+   virtual void placeholder(const char* name, Print& out) {};
+
+protected:
+   AbstractTemplateHandler() {};
+
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Renders a template from flash (PROGMEM) to a Print, e.g. a
+//! StreamHttpChunkedReply, replacing each {{name}} by what the handler writes.
+//! \details The template is copied from flash with memcpy_P a block at a time,
+//!    straight into the output buffer, which is written out whenever it is
+//!    full. Placeholder names are read from flash as well, so RAM use is the
+//!    block plus MAX_NAME_SIZE bytes, however large the page. Values written
+//!    by the handler are collected in the same buffer, so the output arrives
+//!    in block sized chunks. Spaces around a name are ignored; "{{" not
+//!    followed by a name of at most MAX_NAME_SIZE - 1 characters and "}}" is
+//!    copied as it is, so "{{{name}}}" is the value in braces. There is no
+//!    escaping; handlers write values as they are to be sent.
+class AbstractTemplateRenderer: public Print
+{
+
+public:
+   static const size_t MAX_NAME_SIZE = 32U;
+
+   bool render(PGM_P pTemplate, Print& out);
+   bool render(const __FlashStringHelper* pTemplate, Print& out) { return render(reinterpret_cast<PGM_P>(pTemplate), out); };
+
+   // Print interface, used by the handler while rendering.
+   using Print::write;
+   virtual size_t write(uint8_t byte);
+   virtual size_t write(const uint8_t* buffer, size_t size);
+
+protected:
+   AbstractTemplateRenderer(AbstractTemplateHandler& handler, char* pBuffer, size_t bufferSize);
+
+private:
+   size_t readPlaceholder(PGM_P pStart, size_t available);
+   void flushBuffer();
+
+   AbstractTemplateHandler& m_handler;
+   char* const m_pBuffer;
+   const size_t m_bufferSize;
+   size_t m_length;
+   Print* m_pOut; //!< Set while rendering.
+   bool m_failed;
+   char m_name[MAX_NAME_SIZE];
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Template renderer reading and writing through a BLOCK_SIZE bytes buffer.
+template <size_t BLOCK_SIZE = 128>
+class TemplateRenderer: public AbstractTemplateRenderer
+{
+
+public:
+   TemplateRenderer(AbstractTemplateHandler& handler) : AbstractTemplateRenderer(handler, m_buffer, BLOCK_SIZE) {};
+
+private:
+   char m_buffer[BLOCK_SIZE];
+};
+
+}
+
+#endif // __ArduinoHttpServer__TemplateRenderer__
@@ -0,0 +1,183 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! In place application/x-www-form-urlencoded decoding.
+
+#include "UrlEncodedForm.hpp"
+
+namespace
+{
+   inline bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
+
+   //! \returns Value of hexadecimal digit _ch_, or -1.
+   int hexValue(char ch)
+   {
+      if (ch >= '0' && ch <= '9') { return ch - '0'; }
+      if (ch >= 'a' && ch <= 'f') { return ch - 'a' + 10; }
+      if (ch >= 'A' && ch <= 'F') { return ch - 'A' + 10; }
+      return -1;
+   }
+
+   //! \brief Decode the character at _pEncoded_: "%XX", '+' or a literal.
+   //! \returns Encoded characters taken, 1 or 3.
+   size_t decodeCharacter(const char* pEncoded, size_t length, char& decoded)
+   {
+      if (pEncoded[0] == '+')
+      {
+         decoded = ' ';
+         return 1U;
+      }
+
+      if (pEncoded[0] == '%' && length >= 3U)
+      {
+         const int high(hexValue(pEncoded[1]));
+         const int low(hexValue(pEncoded[2]));
+         if (high >= 0 && low >= 0)
+         {
+            decoded = static_cast<char>((high << 4) | low);
+            return 3U;
+         }
+      }
+
+      // Malformed escapes are kept as they are, as browsers do.
+      decoded = pEncoded[0];
+      return 1U;
+   }
+}
+
+//------------------------------------------------------------------------------
+//! \brief Percent decode _length_ characters, '+' meaning space.
+//! \details _pDecoded_ may be _pEncoded_, decoding in place.
+//! \returns Decoded length, at most _length_.
+size_t ArduinoHttpServer::urlDecode(const char* pEncoded, size_t length, char* pDecoded)
+{
+   size_t decodedLength(0);
+   for (size_t i=0; i < length; )
+   {
+      i += decodeCharacter(pEncoded + i, length - i, pDecoded[decodedLength++]);
+   }
+   return decodedLength;
+}
+
+//------------------------------------------------------------------------------
+//! \brief Compare encoded data with plain _text_ without decoding it first.
+bool ArduinoHttpServer::urlDecodedEquals(const char* pEncoded, size_t length, const char* text)
+{
+   size_t i(0);
+   for (; i < length && *text; ++text)
+   {
+      char decoded;
+      i += decodeCharacter(pEncoded + i, length - i, decoded);
+      if (decoded != *text)
+      {
+         return false;
+      }
+   }
+   return i == length && *text == '\0';
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+bool ArduinoHttpServer::FormField::keyEquals(const char* key) const
+{
+   return strlen(key) == m_keyLength && memcmp(m_pKey, key, m_keyLength) == 0;
+}
+
+bool ArduinoHttpServer::FormField::equals(const char* text) const
+{
+   return strlen(text) == m_valueLength && memcmp(m_pValue, text, m_valueLength) == 0;
+}
+
+//! \brief Leading integer of the value, 0 when there is none.
+long ArduinoHttpServer::FormField::toLong() const
+{
+   const bool negative(m_valueLength > 0 && m_pValue[0] == '-');
+   long result(0);
+   for (size_t i=(negative ? 1U : 0U); i < m_valueLength && isDigit(m_pValue[i]); ++i)
+   {
+      result = result * 10L + (m_pValue[i] - '0');
+   }
+   return negative ? -result : result;
+}
+
+String ArduinoHttpServer::FormField::toString() const
+{
+   String result;
+   result.reserve(m_valueLength);
+   for (size_t i=0; i < m_valueLength; ++i)
+   {
+      result += m_pValue[i];
+   }
+   return result;
+}
+
+//------------------------------------------------------------------------------
+//                             Class Definition
+//------------------------------------------------------------------------------
+ArduinoHttpServer::AbstractUrlEncodedForm::AbstractUrlEncodedForm(FormField* pFields, size_t maxFields) :
+   m_pFields(pFields),
+   m_maxFields(maxFields),
+   m_count(0),
+   m_truncated(false)
+{
+}
+
+//------------------------------------------------------------------------------
+//! \brief Split _data_ into fields and decode them in place, replacing the
+//!    fields parsed before.
+//! \details Empty fields ("a=1&&b=2") are skipped, a field without '=' has
+//!    an empty value.
+//! \returns Number of fields.
+size_t ArduinoHttpServer::AbstractUrlEncodedForm::parse(char* data, size_t length)
+{
+   m_count = 0;
+   m_truncated = false;
+
+   size_t start(0);
+   while (start < length)
+   {
+      const char* pSeparator(static_cast<const char*>(memchr(data + start, '&', length - start)));
+      const size_t end(pSeparator ? static_cast<size_t>(pSeparator - data) : length);
+
+      if (end > start)
+      {
+         if (m_count == m_maxFields)
+         {
+            m_truncated = true;
+            break;
+         }
+
+         char* const pKey(data + start);
+         const char* pEquals(static_cast<const char*>(memchr(pKey, '=', end - start)));
+         const size_t keyEnd(pEquals ? static_cast<size_t>(pEquals - data) : end);
+         char* const pValue(data + (pEquals ? keyEnd + 1U : end));
+
+         const size_t keyLength(urlDecode(pKey, keyEnd - start, pKey));
+         const size_t valueLength(urlDecode(pValue, data + end - pValue, pValue));
+         m_pFields[m_count++] = FormField(pKey, keyLength, pValue, valueLength);
+      }
+
+      start = end + 1U;
+   }
+
+   return m_count;
+}
+
+//------------------------------------------------------------------------------
+//! \returns First field named _key_, or 0.
+const ArduinoHttpServer::FormField* ArduinoHttpServer::AbstractUrlEncodedForm::find(const char* key) const
+{
+   for (size_t i=0; i < m_count; ++i)
+   {
+      if (m_pFields[i].keyEquals(key))
+      {
+         return &m_pFields[i];
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,106 @@
+//
+//! \file
+//  ArduinoHttpServer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! In place application/x-www-form-urlencoded decoding.
+
+#ifndef __ArduinoHttpServer__UrlEncodedForm__
+#define __ArduinoHttpServer__UrlEncodedForm__
+
+#include <Arduino.h>
+
+namespace ArduinoHttpServer
+{
+
+size_t urlDecode(const char* pEncoded, size_t length, char* pDecoded);
+bool urlDecodedEquals(const char* pEncoded, size_t length, const char* text);
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Decoded name and value of a form field or query parameter.
+//! \details Views into the decoded data: not zero terminated and only valid
+//!    as long as the data is.
+class FormField
+{
+
+public:
+   FormField() : m_pKey(0), m_keyLength(0), m_pValue(0), m_valueLength(0) {};
+   FormField(const char* pKey, size_t keyLength, const char* pValue, size_t valueLength) :
+      m_pKey(pKey), m_keyLength(keyLength), m_pValue(pValue), m_valueLength(valueLength) {};
+
+   inline const char* getKey() const { return m_pKey; };
+   inline size_t getKeyLength() const { return m_keyLength; };
+   inline const char* getValue() const { return m_pValue; };
+   inline size_t getValueLength() const { return m_valueLength; };
+
+   bool keyEquals(const char* key) const;
+   bool equals(const char* text) const;
+   long toLong() const;
+   String toString() const;
+
+private:
+   const char* m_pKey;
+   size_t m_keyLength;
+   const char* m_pValue;
+   size_t m_valueLength;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Splits key=value&key=value data, e.g. a POSTed form body or a chunk of
+//! one holding complete fields, and percent decodes it in place.
+//! \details Nothing is allocated: each name and value is decoded over its own
+//!    encoded form, which is never shorter, and recorded in a table of
+//!    fields. The table is what makes lookups possible after decoding, which
+//!    can turn %26 into '&' and %3D into '='. Fields beyond its size are
+//!    left undecoded and reported by isTruncated().
+class AbstractUrlEncodedForm
+{
+
+public:
+   size_t parse(char* data, size_t length);
+
+   const FormField* find(const char* key) const;
+
+   inline size_t getCount() const { return m_count; };
+   inline bool isTruncated() const { return m_truncated; };
+   inline const FormField& operator[](size_t index) const { return m_pFields[index]; };
+
+   // Iteration over the fields, in the order they were sent.
+   inline const FormField* begin() const { return m_pFields; };
+   inline const FormField* end() const { return m_pFields + m_count; };
+
+protected:
+   AbstractUrlEncodedForm(FormField* pFields, size_t maxFields);
+
+private:
+   FormField* const m_pFields;
+   const size_t m_maxFields;
+   size_t m_count;
+   bool m_truncated;
+};
+
+//------------------------------------------------------------------------------
+//                             Class Declaration
+//------------------------------------------------------------------------------
+//! Url encoded form of up to MAX_FIELDS fields.
+template <size_t MAX_FIELDS = 16>
+class UrlEncodedForm: public AbstractUrlEncodedForm
+{
+
+public:
+   UrlEncodedForm() : AbstractUrlEncodedForm(m_fields, MAX_FIELDS) {};
+   UrlEncodedForm(char* data, size_t length) : AbstractUrlEncodedForm(m_fields, MAX_FIELDS) { parse(data, length); };
+
+private:
+   FormField m_fields[MAX_FIELDS];
+};
+
+}
+
+#endif // __ArduinoHttpServer__UrlEncodedForm__
@@ -0,0 +1,69 @@
+//
+//! \file
+//  Unit test support
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Checks for the unit tests, which are plain programs built and run by
+//! "make test" in extras/host.
+
+#ifndef __ArduinoHttpServer__TestSupport__
+#define __ArduinoHttpServer__TestSupport__
+
+#include <stdio.h>
+#include <string>
+
+namespace TestSupport
+{
+
+//! Failed checks of this test program.
+inline int& failures()
+{
+   static int count(0);
+   return count;
+}
+
+inline void check(bool condition, const char* pExpression, const char* pFile, int line)
+{
+   if (!condition)
+   {
+      ++failures();
+      printf("%s:%d: check failed: %s\n", pFile, line, pExpression);
+   }
+}
+
+inline void checkEqual(const std::string& expected, const std::string& actual, const char* pExpression, const char* pFile, int line)
+{
+   if (expected != actual)
+   {
+      ++failures();
+      printf("%s:%d: check failed: %s\n   expected \"%s\"\n   actual   \"%s\"\n",
+             pFile, line, pExpression, expected.c_str(), actual.c_str());
+   }
+}
+
+inline void checkEqual(long long expected, long long actual, const char* pExpression, const char* pFile, int line)
+{
+   if (expected != actual)
+   {
+      ++failures();
+      printf("%s:%d: check failed: %s\n   expected %lld\n   actual   %lld\n",
+             pFile, line, pExpression, expected, actual);
+   }
+}
+
+//! Report the outcome of test program _pName_.
+//! \returns Exit code for main().
+inline int result(const char* pName)
+{
+   printf("%s: %s\n", pName, failures() == 0 ? "passed" : "FAILED");
+   return failures() == 0 ? 0 : 1;
+}
+
+}
+
+#define TEST_CHECK(condition) TestSupport::check((condition), #condition, __FILE__, __LINE__)
+#define TEST_CHECK_EQUAL(expected, actual) TestSupport::checkEqual((expected), (actual), #actual, __FILE__, __LINE__)
+
+#endif // __ArduinoHttpServer__TestSupport__
@@ -0,0 +1,358 @@
+//
+//! \file
+//  Unit test for DeflateWriter
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Decompresses the output with a minimal inflater for stored and fixed
+//! Huffman blocks (RFC 1951), independent of the writer's code.
+
+#include "TestSupport.hpp"
+#include "../src/internals/DeflateWriter.hpp"
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Collects what is printed to it.
+struct StringPrint : Print
+{
+   std::string text;
+   virtual size_t write(uint8_t byte) { text += static_cast<char>(byte); return 1; };
+   virtual size_t write(const uint8_t* buffer, size_t size) { text.append(reinterpret_cast<const char*>(buffer), size); return size; };
+};
+
+//! Reads a deflate stream bit by bit.
+class Inflater
+{
+public:
+   Inflater(const std::string& data, size_t offset) : m_data(data), m_offset(offset), m_bit(0), m_failed(false) { };
+
+   //! Decompress up to and including the final block.
+   //! \returns False on a malformed or unsupported stream.
+   bool inflate(std::string& output)
+   {
+      bool final(false);
+      while (!final && !m_failed)
+      {
+         final = bits(1) == 1;
+         const uint32_t type(bits(2));
+         if (type == 0)
+         {
+            stored(output);
+         }
+         else if (type == 1)
+         {
+            fixed(output);
+         }
+         else
+         {
+            return false; // Dynamic Huffman, the writer never uses it.
+         }
+      }
+      return !m_failed;
+   }
+
+   //! Offset of the first byte after the deflate stream.
+   size_t getEndOffset() const { return m_offset + (m_bit > 0 ? 1 : 0); };
+
+private:
+   uint32_t bits(int count)
+   {
+      uint32_t value(0);
+      for (int i = 0; i < count; ++i)
+      {
+         if (m_offset >= m_data.size())
+         {
+            m_failed = true;
+            return 0;
+         }
+         value |= ((static_cast<uint8_t>(m_data[m_offset]) >> m_bit) & 1U) << i;
+         if (++m_bit == 8)
+         {
+            m_bit = 0;
+            ++m_offset;
+         }
+      }
+      return value;
+   }
+
+   //! Huffman codes are packed starting with their most significant bit.
+   uint32_t codeBits(int count)
+   {
+      uint32_t code(0);
+      for (int i = 0; i < count; ++i)
+      {
+         code = (code << 1) | bits(1);
+      }
+      return code;
+   }
+
+   void stored(std::string& output)
+   {
+      if (m_bit > 0)
+      {
+         m_bit = 0;
+         ++m_offset;
+      }
+      const uint32_t length(bits(16));
+      const uint32_t complement(bits(16));
+      if ((length ^ 0xFFFFU) != complement || m_offset + length > m_data.size())
+      {
+         m_failed = true;
+         return;
+      }
+      output.append(m_data, m_offset, length);
+      m_offset += length;
+   }
+
+   //! Literal/length symbol of the fixed code: 7, 8 or 9 bits.
+   uint32_t fixedSymbol()
+   {
+      uint32_t code(codeBits(7));
+      if (code <= 0x17U) { return 256U + code; }
+      code = (code << 1) | bits(1);
+      if (code >= 0x30U && code <= 0xBFU) { return code - 0x30U; }
+      if (code >= 0xC0U && code <= 0xC7U) { return 280U + code - 0xC0U; }
+      code = (code << 1) | bits(1);
+      return 144U + code - 0x190U;
+   }
+
+   void fixed(std::string& output)
+   {
+      static const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+      static const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                                3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+      static const uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                                  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                                  8193, 12289, 16385, 24577 };
+      static const uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                                  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+      while (!m_failed)
+      {
+         const uint32_t symbol(fixedSymbol());
+         if (symbol < 256U)
+         {
+            output += static_cast<char>(symbol);
+            continue;
+         }
+         if (symbol == 256U)
+         {
+            return;
+         }
+         if (symbol > 285U)
+         {
+            m_failed = true;
+            return;
+         }
+         const size_t length(LENGTH_BASE[symbol - 257U] + bits(LENGTH_EXTRA[symbol - 257U]));
+         const uint32_t distanceCode(codeBits(5));
+         if (distanceCode >= 30U)
+         {
+            m_failed = true;
+            return;
+         }
+         const size_t distance(DISTANCE_BASE[distanceCode] + bits(DISTANCE_EXTRA[distanceCode]));
+         if (distance > output.size())
+         {
+            m_failed = true;
+            return;
+         }
+         for (size_t i = 0; i < length; ++i)
+         {
+            output += output[output.size() - distance];
+         }
+      }
+   }
+
+   const std::string& m_data;
+   size_t m_offset;
+   int m_bit;
+   bool m_failed;
+};
+
+uint32_t crc32(const std::string& data)
+{
+   uint32_t crc(0xFFFFFFFFUL);
+   for (const char ch : data)
+   {
+      crc ^= static_cast<uint8_t>(ch);
+      for (int i = 0; i < 8; ++i)
+      {
+         crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+      }
+   }
+   return ~crc;
+}
+
+uint32_t adler32(const std::string& data)
+{
+   uint32_t a(1), b(0);
+   for (const char ch : data)
+   {
+      a = (a + static_cast<uint8_t>(ch)) % 65521UL;
+      b = (b + a) % 65521UL;
+   }
+   return (b << 16) | a;
+}
+
+uint32_t littleEndian(const std::string& data, size_t offset)
+{
+   uint32_t value(0);
+   for (int i = 3; i >= 0; --i) { value = (value << 8) | static_cast<uint8_t>(data[offset + i]); }
+   return value;
+}
+
+uint32_t bigEndian(const std::string& data, size_t offset)
+{
+   uint32_t value(0);
+   for (int i = 0; i < 4; ++i) { value = (value << 8) | static_cast<uint8_t>(data[offset + i]); }
+   return value;
+}
+
+//! Compress _input_, written in pieces of _pieceSize_ bytes.
+template <size_t WINDOW_SIZE>
+std::string compress(const std::string& input, AbstractDeflateWriter::Format format, size_t pieceSize)
+{
+   StringPrint out;
+   DeflateWriter<WINDOW_SIZE> writer(out, format);
+   for (size_t offset = 0; offset < input.size(); offset += pieceSize)
+   {
+      const size_t length(pieceSize < input.size() - offset ? pieceSize : input.size() - offset);
+      TEST_CHECK_EQUAL(length, writer.write(reinterpret_cast<const uint8_t*>(input.data()) + offset, length));
+   }
+   TEST_CHECK(writer.finish());
+   TEST_CHECK_EQUAL(input.size(), writer.getInputLength());
+   TEST_CHECK_EQUAL(out.text.size(), writer.getOutputLength());
+   return out.text;
+}
+
+//! Decompress gzip _data_, checking header and trailer.
+std::string gunzip(const std::string& data)
+{
+   std::string output;
+   TEST_CHECK(data.size() >= 18 && data.compare(0, 3, "\x1f\x8b\x08") == 0 && data[3] == 0);
+   if (data.size() < 18)
+   {
+      return output;
+   }
+   Inflater inflater(data, 10);
+   TEST_CHECK(inflater.inflate(output));
+   const size_t trailer(inflater.getEndOffset());
+   TEST_CHECK_EQUAL(trailer + 8, data.size());
+   if (trailer + 8 == data.size())
+   {
+      TEST_CHECK_EQUAL(crc32(output), littleEndian(data, trailer));
+      TEST_CHECK_EQUAL(output.size(), littleEndian(data, trailer + 4));
+   }
+   return output;
+}
+
+//! Decompress zlib _data_, checking header and trailer.
+std::string unzlib(const std::string& data, size_t windowSize)
+{
+   std::string output;
+   TEST_CHECK(data.size() >= 6);
+   if (data.size() < 6)
+   {
+      return output;
+   }
+   const uint8_t cmf(static_cast<uint8_t>(data[0]));
+   const uint8_t flg(static_cast<uint8_t>(data[1]));
+   TEST_CHECK_EQUAL(8, cmf & 0x0FU);
+   TEST_CHECK(windowSize <= (1UL << ((cmf >> 4) + 8)));
+   TEST_CHECK_EQUAL(0, (cmf * 256U + flg) % 31U);
+   TEST_CHECK_EQUAL(0, flg & 0x20U); // No preset dictionary.
+
+   Inflater inflater(data, 2);
+   TEST_CHECK(inflater.inflate(output));
+   const size_t trailer(inflater.getEndOffset());
+   TEST_CHECK_EQUAL(trailer + 4, data.size());
+   if (trailer + 4 == data.size())
+   {
+      TEST_CHECK_EQUAL(adler32(output), bigEndian(data, trailer));
+   }
+   return output;
+}
+
+//! Inputs exercising literals, short and maximum length matches, distances
+//! up to and beyond the window, and incompressible data.
+std::vector<std::string> inputs()
+{
+   std::vector<std::string> result;
+   result.push_back("");
+   result.push_back("a");
+   result.push_back("{\"temperature\": 21.5}");
+   result.push_back(std::string(1000, 'x'));
+
+   std::string json("[");
+   for (int i = 0; i < 400; ++i)
+   {
+      json += (i > 0 ? ", " : "") + std::string("{\"id\": ") + std::to_string(i) + ", \"name\": \"sensor\", \"value\": " +
+              std::to_string(i * 37 % 101) + "}";
+   }
+   result.push_back(json + "]");
+
+   std::mt19937 random(7);
+   std::string binary;
+   for (int i = 0; i < 5000; ++i) { binary += static_cast<char>(random() & 0xFF); }
+   result.push_back(binary);
+
+   // Repeats farther apart than a small window.
+   result.push_back(binary.substr(0, 700) + std::string(3000, '-') + binary.substr(0, 700) + json.substr(0, 20000));
+   return result;
+}
+
+template <size_t WINDOW_SIZE>
+void testRoundTrip()
+{
+   for (const std::string& input : inputs())
+   {
+      for (size_t pieceSize : { static_cast<size_t>(1), static_cast<size_t>(100), input.size() + 1 })
+      {
+         TEST_CHECK(input == gunzip(compress<WINDOW_SIZE>(input, AbstractDeflateWriter::Format::GZIP, pieceSize)));
+         TEST_CHECK(input == unzlib(compress<WINDOW_SIZE>(input, AbstractDeflateWriter::Format::DEFLATE, pieceSize), WINDOW_SIZE));
+      }
+   }
+}
+
+void testCompresses()
+{
+   const std::string json(inputs()[4]);
+   TEST_CHECK(compress<1024>(json, AbstractDeflateWriter::Format::GZIP, 64).size() < json.size() / 3);
+}
+
+void testIdentity()
+{
+   const std::string input(inputs()[2]);
+   TEST_CHECK_EQUAL(input, compress<512>(input, AbstractDeflateWriter::Format::IDENTITY, 5));
+}
+
+void testSelectFormat()
+{
+   TEST_CHECK(AbstractDeflateWriter::selectFormat("gzip, deflate, br") == AbstractDeflateWriter::Format::GZIP);
+   TEST_CHECK(AbstractDeflateWriter::selectFormat("deflate") == AbstractDeflateWriter::Format::DEFLATE);
+   TEST_CHECK(AbstractDeflateWriter::selectFormat("br") == AbstractDeflateWriter::Format::IDENTITY);
+   TEST_CHECK(AbstractDeflateWriter::selectFormat("") == AbstractDeflateWriter::Format::IDENTITY);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testRoundTrip<512>();
+   testRoundTrip<1024>();
+   testRoundTrip<16384>();
+   testCompresses();
+   testIdentity();
+   testSelectFormat();
+   return TestSupport::result("DeflateWriter");
+}
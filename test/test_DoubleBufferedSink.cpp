@@ -0,0 +1,215 @@
+//
+//! \file
+//  Unit test for DoubleBufferedSink
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "../src/internals/DoubleBufferedSink.hpp"
+#include "SimulatedStream.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Output keeping each write() apart, accepting at most _capacity_ bytes.
+struct RecordingOutput : Print
+{
+   RecordingOutput(size_t capacity = SIZE_MAX) : writes(), capacity(capacity) { };
+
+   using Print::write;
+   virtual size_t write(uint8_t byte) { return write(&byte, 1); };
+   virtual size_t write(const uint8_t* buffer, size_t size)
+   {
+      size = size < capacity ? size : capacity;
+      capacity -= size;
+      writes.push_back(std::string(reinterpret_cast<const char*>(buffer), size));
+      return size;
+   }
+
+   std::string written() const
+   {
+      std::string text;
+      for (const std::string& part : writes) { text += part; }
+      return text;
+   }
+
+   std::vector<std::string> writes;
+   size_t capacity;
+};
+
+//! Drains only when waited for, as a drain running concurrently would end
+//! at the latest. A buffer overwritten while handed over shows in the output.
+class DeferredSink: public AbstractDoubleBufferedSink
+{
+public:
+   DeferredSink(Print& out) : AbstractDoubleBufferedSink(out, m_buffers, sizeof(m_buffers) / 2), m_pending(false) { };
+   ~DeferredSink() { flush(); };
+
+protected:
+   virtual void startDrain() { m_pending = true; };
+   virtual void waitDrained()
+   {
+      if (m_pending)
+      {
+         m_pending = false;
+         drain();
+      }
+   };
+
+private:
+   char m_buffers[2 * 8];
+   bool m_pending;
+};
+
+std::string letters(size_t length)
+{
+   std::string text;
+   for (size_t i = 0; i < length; ++i) { text += static_cast<char>('a' + i % 26); }
+   return text;
+}
+
+//! Writes of any size come out as buffer sized writes, in order.
+template <class SINK>
+void checkBufferBoundaries()
+{
+   const std::string data(letters(45));
+   RecordingOutput out;
+   SINK sink(out);
+
+   size_t offset(0);
+   for (size_t size : { 3U, 5U, 1U, 7U, 16U, 2U, 11U })
+   {
+      TEST_CHECK_EQUAL(size, sink.write(reinterpret_cast<const uint8_t*>(data.c_str() + offset), size));
+      offset += size;
+   }
+   TEST_CHECK_EQUAL(data.size(), offset);
+
+   // The last 5 bytes are still collected, the full buffer before them may
+   // still be draining.
+   TEST_CHECK(out.written().size() >= 32 && out.written().size() <= 40);
+   TEST_CHECK_EQUAL(data.substr(0, out.written().size()), out.written());
+   TEST_CHECK(sink.finish());
+   TEST_CHECK_EQUAL(data, out.written());
+
+   const std::vector<std::string> expected{ data.substr(0, 8), data.substr(8, 8), data.substr(16, 8), data.substr(24, 8),
+                                            data.substr(32, 8), data.substr(40) };
+   TEST_CHECK(out.writes == expected);
+}
+
+void testBufferBoundaries()
+{
+   checkBufferBoundaries<DoubleBufferedSink<8> >();
+   checkBufferBoundaries<DeferredSink>();
+}
+
+//! finish() writes a partly filled buffer, and nothing when there is none.
+void testFinish()
+{
+   RecordingOutput out;
+   DoubleBufferedSink<8> sink(out);
+   TEST_CHECK(sink.finish());
+   TEST_CHECK(out.writes.empty());
+
+   sink.print("abc");
+   TEST_CHECK(out.writes.empty());
+   TEST_CHECK(sink.finish());
+   TEST_CHECK_EQUAL("abc", out.written());
+
+   sink.print("defghijk");
+   TEST_CHECK(sink.finish());
+   TEST_CHECK_EQUAL("abcdefghijk", out.written());
+   TEST_CHECK_EQUAL(2, out.writes.size());
+
+   // Destruction flushes what is left too.
+   RecordingOutput deferredOut;
+   {
+      DeferredSink deferred(deferredOut);
+      deferred.print("0123456789");
+      TEST_CHECK_EQUAL("", deferredOut.written());
+   }
+   TEST_CHECK_EQUAL("0123456789", deferredOut.written());
+}
+
+//! An output accepting less than it is given fails the sink; writers are
+//! told by write() returning 0 and nothing more reaches the output.
+template <class SINK>
+void checkOutputFailure()
+{
+   RecordingOutput out(12);
+   SINK sink(out);
+   TEST_CHECK_EQUAL(8, sink.print("01234567"));
+   TEST_CHECK_EQUAL(8, sink.print("89abcdef"));
+
+   size_t accepted(0);
+   for (int i = 0; i < 4; ++i)
+   {
+      accepted += sink.print("ghijklmn");
+   }
+   TEST_CHECK(accepted < 32);
+   TEST_CHECK_EQUAL(0, sink.print("x"));
+
+   TEST_CHECK(!sink.finish());
+   TEST_CHECK(sink.hasFailed());
+   TEST_CHECK_EQUAL("0123456789ab", out.written());
+   TEST_CHECK_EQUAL(2, out.writes.size());
+}
+
+void testOutputFailure()
+{
+   checkOutputFailure<DoubleBufferedSink<8> >();
+   checkOutputFailure<DeferredSink>();
+
+   // Failing on the last, partly filled buffer shows after flush().
+   RecordingOutput out(2);
+   DoubleBufferedSink<8> sink(out);
+   sink.print("abc");
+   TEST_CHECK(!sink.hasFailed());
+   sink.flush();
+   TEST_CHECK(sink.hasFailed());
+   TEST_CHECK(!sink.finish());
+}
+
+//! As the sink of StreamHttpRequest::streamBody().
+void testStreamBody()
+{
+   const std::string body(letters(100));
+   SimulatedStream stream("PUT /firmware HTTP/1.1\r\nContent-Length: 100\r\n\r\n" + body, NetworkConditions(), micros());
+   StreamHttpRequest<16> request(stream);
+   TEST_CHECK(request.readRequest());
+
+   RecordingOutput out;
+   DeferredSink sink(out);
+   TEST_CHECK(request.streamBody(sink));
+   TEST_CHECK(sink.finish());
+   TEST_CHECK_EQUAL(body, out.written());
+   TEST_CHECK_EQUAL(13, out.writes.size());
+
+   SimulatedStream failing("PUT /firmware HTTP/1.1\r\nContent-Length: 100\r\n\r\n" + body, NetworkConditions(), micros());
+   StreamHttpRequest<16> failingRequest(failing);
+   TEST_CHECK(failingRequest.readRequest());
+   RecordingOutput full(20);
+   DoubleBufferedSink<8> failingSink(full);
+   TEST_CHECK(!failingRequest.streamBody(failingSink));
+   TEST_CHECK(!failingSink.finish());
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+   testBufferBoundaries();
+   testFinish();
+   testOutputFailure();
+   testStreamBody();
+   return TestSupport::result("DoubleBufferedSink");
+}
@@ -0,0 +1,131 @@
+//
+//! \file
+//  Unit test for HttpMetrics
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/HttpMetrics.hpp"
+
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Collects what is printed to it.
+struct StringPrint : Print
+{
+   std::string text;
+   virtual size_t write(uint8_t byte) { text += static_cast<char>(byte); return 1; };
+};
+
+std::string printed(const HttpMetrics& metrics)
+{
+   StringPrint out;
+   metrics.printTo(out);
+   return out.text;
+}
+
+std::string printed(const HttpLatencyHistogram& histogram)
+{
+   StringPrint out;
+   histogram.printTo(out, "latency_seconds");
+   return out.text;
+}
+
+bool contains(const std::string& text, const std::string& line)
+{
+   return text.find(line + "\n") != std::string::npos;
+}
+
+//! Bounds are inclusive, buckets cumulative, larger durations only in +Inf.
+void testBuckets()
+{
+   HttpLatencyHistogram histogram;
+   histogram.record(0UL);
+   histogram.record(1000UL);
+   histogram.record(1001UL);
+   histogram.record(25000UL);
+   histogram.record(1000000UL);
+   histogram.record(1000001UL);
+   histogram.record(60000000UL);
+
+   TEST_CHECK_EQUAL(
+      "# TYPE latency_seconds histogram\n"
+      "latency_seconds_bucket{le=\"0.001\"} 2\n"
+      "latency_seconds_bucket{le=\"0.005\"} 3\n"
+      "latency_seconds_bucket{le=\"0.010\"} 3\n"
+      "latency_seconds_bucket{le=\"0.025\"} 4\n"
+      "latency_seconds_bucket{le=\"0.050\"} 4\n"
+      "latency_seconds_bucket{le=\"0.100\"} 4\n"
+      "latency_seconds_bucket{le=\"0.250\"} 4\n"
+      "latency_seconds_bucket{le=\"0.500\"} 4\n"
+      "latency_seconds_bucket{le=\"1.000\"} 5\n"
+      "latency_seconds_bucket{le=\"+Inf\"} 7\n"
+      "latency_seconds_sum 62.027002\n"
+      "latency_seconds_count 7\n", printed(histogram));
+}
+
+//! The sum is in seconds with microsecond resolution, also beyond 32 bits
+//! of microseconds.
+void testSum()
+{
+   HttpLatencyHistogram histogram;
+   TEST_CHECK(contains(printed(histogram), "latency_seconds_sum 0.000000"));
+
+   histogram.record(42UL);
+   TEST_CHECK(contains(printed(histogram), "latency_seconds_sum 0.000042"));
+
+   histogram.record(1000000UL - 42UL + 5UL);
+   TEST_CHECK(contains(printed(histogram), "latency_seconds_sum 1.000005"));
+
+   for (int i = 0; i < 3; ++i)
+   {
+      histogram.record(4000000000UL);
+   }
+   TEST_CHECK(contains(printed(histogram), "latency_seconds_sum 12001.000005"));
+   TEST_CHECK(contains(printed(histogram), "latency_seconds_count 5"));
+}
+
+//! Requests are counted per method, errors per kind, bytes in both directions.
+void testCounters()
+{
+   HttpMetrics metrics;
+   metrics.recordRequest(Method::Get, RequestError::OK, 120, 800UL);
+   metrics.recordRequest(Method::Get, RequestError::OK, 80, 2000UL);
+   metrics.recordRequest(Method::Post, RequestError::BODY_TIMEOUT, 300, 30000UL);
+   metrics.recordReply(1000, 4000UL);
+   metrics.recordReply(24, 2000000UL);
+
+   const std::string text(printed(metrics));
+   TEST_CHECK(contains(text, "http_requests_total{method=\"GET\"} 2"));
+   TEST_CHECK(contains(text, "http_requests_total{method=\"POST\"} 1"));
+   TEST_CHECK(contains(text, "http_requests_total{method=\"PUT\"} 0"));
+   TEST_CHECK(contains(text, "http_request_errors_total{error=\"body_timeout\"} 1"));
+   TEST_CHECK(contains(text, "http_request_errors_total{error=\"timeout\"} 0"));
+   TEST_CHECK(contains(text, "http_received_bytes_total 500"));
+   TEST_CHECK(contains(text, "http_sent_bytes_total 1024"));
+
+   TEST_CHECK(contains(text, "http_request_parse_duration_seconds_bucket{le=\"0.001\"} 1"));
+   TEST_CHECK(contains(text, "http_request_parse_duration_seconds_bucket{le=\"0.005\"} 2"));
+   TEST_CHECK(contains(text, "http_request_parse_duration_seconds_bucket{le=\"+Inf\"} 3"));
+   TEST_CHECK(contains(text, "http_request_parse_duration_seconds_sum 0.032800"));
+   TEST_CHECK(contains(text, "http_request_duration_seconds_bucket{le=\"1.000\"} 1"));
+   TEST_CHECK(contains(text, "http_request_duration_seconds_bucket{le=\"+Inf\"} 2"));
+   TEST_CHECK(contains(text, "http_request_duration_seconds_sum 2.004000"));
+   TEST_CHECK(contains(text, "http_request_duration_seconds_count 2"));
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testBuckets();
+   testSum();
+   testCounters();
+   return TestSupport::result("HttpMetrics");
+}
@@ -0,0 +1,244 @@
+//
+//! \file
+//  Unit test for HttpRequestParser
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/HttpRequestParser.hpp"
+
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+typedef HttpRequestParser<32> Parser;
+
+const std::string REQUEST(
+   "PUT /api/sensors/1?unit=C HTTP/1.1\r\n"
+   "Host: device.local\r\n"
+   "Content-Type: application/json\r\n"
+   "Content-Length: 11\r\n"
+   "\r\n"
+   "{\"on\":true}");
+const std::string NEXT_REQUEST("GET / HTTP/1.1\r\n\r\n");
+
+//! Feed _input_ in pieces of _pieceSize_ bytes, the first _firstPieceSize_ bytes long.
+//! \returns Bytes consumed.
+size_t feedInPieces(Parser& parser, const std::string& input, size_t firstPieceSize, size_t pieceSize)
+{
+   size_t consumed(0);
+   size_t length(firstPieceSize);
+   while (!parser.isDone() && consumed < input.size())
+   {
+      length = length < input.size() - consumed ? length : input.size() - consumed;
+      const size_t pieceConsumed(parser.feed(input.data() + consumed, length));
+      consumed += pieceConsumed;
+      if (pieceConsumed < length)
+      {
+         break;
+      }
+      length = pieceSize;
+   }
+   return consumed;
+}
+
+void checkRequest(const Parser& parser)
+{
+   TEST_CHECK(parser.getState() == Parser::State::COMPLETE);
+   TEST_CHECK(parser.getErrorCode() == RequestError::OK);
+   TEST_CHECK(parser.getMethod() == Method::Put);
+   TEST_CHECK_EQUAL("/api/sensors/1?unit=C", parser.getResource().toString().c_str());
+   TEST_CHECK_EQUAL("C", parser.getResource().getQueryParameter("unit").c_str());
+   TEST_CHECK_EQUAL(1, parser.getVersion().getMajor());
+   TEST_CHECK_EQUAL(1, parser.getVersion().getMinor());
+   TEST_CHECK_EQUAL("application/json", parser.getContentType().c_str());
+   TEST_CHECK_EQUAL(11, parser.getContentLength());
+   TEST_CHECK_EQUAL("{\"on\":true}", parser.getBody());
+   TEST_CHECK_EQUAL(11, parser.getBodyLength());
+   TEST_CHECK_EQUAL(0, parser.getUnreadBodyLength());
+}
+
+//! Every split of the request in two, followed by a pipelined request which must be left alone.
+void testSplitAnywhere()
+{
+   const std::string input(REQUEST + NEXT_REQUEST);
+   for (size_t split = 0; split <= REQUEST.size(); ++split)
+   {
+      Parser parser;
+      TEST_CHECK_EQUAL(REQUEST.size(), feedInPieces(parser, input, split, input.size()));
+      checkRequest(parser);
+   }
+}
+
+//! Pieces of every size from one byte, as slow clients and small TCP segments deliver them.
+void testFragmented()
+{
+   for (size_t pieceSize = 1; pieceSize <= REQUEST.size(); ++pieceSize)
+   {
+      Parser parser;
+      TEST_CHECK_EQUAL(REQUEST.size(), feedInPieces(parser, REQUEST + NEXT_REQUEST, pieceSize, pieceSize));
+      checkRequest(parser);
+   }
+}
+
+void testLineEndings()
+{
+   Parser parser;
+   const std::string input("\r\nGET /index.html HTTP/1.0\nContent-Type: text/plain\n\n");
+   TEST_CHECK_EQUAL(input.size(), feedInPieces(parser, input, 3, 5));
+   TEST_CHECK(parser.getState() == Parser::State::COMPLETE);
+   TEST_CHECK(parser.getMethod() == Method::Get);
+   TEST_CHECK_EQUAL("/index.html", parser.getResource().toString().c_str());
+   TEST_CHECK_EQUAL(1, parser.getVersion().getMajor());
+   TEST_CHECK_EQUAL(0, parser.getVersion().getMinor());
+   TEST_CHECK_EQUAL("text/plain", parser.getContentType().c_str());
+}
+
+//! The part of the body which does not fit the buffer is left in the input.
+void testBodyLargerThanBuffer()
+{
+   const std::string body(100, 'x');
+   const std::string header("POST /upload HTTP/1.1\r\nContent-Length: 100\r\n\r\n");
+
+   Parser parser;
+   TEST_CHECK_EQUAL(header.size() + 31, feedInPieces(parser, header + body, 7, 7));
+   TEST_CHECK(parser.getState() == Parser::State::COMPLETE);
+   TEST_CHECK_EQUAL(31, parser.getBodyLength());
+   TEST_CHECK_EQUAL(69, parser.getUnreadBodyLength());
+   TEST_CHECK_EQUAL(body.substr(0, 31), parser.getBody());
+}
+
+//! The version is the number after the slash, major and minor.
+void testHttpVersion()
+{
+   struct { const char* requestLine; int major; int minor; } const CASES[] = {
+      { "GET / HTTP/1.0\r\n\r\n", 1, 0 },
+      { "GET / HTTP/1.1\r\n\r\n", 1, 1 },
+      { "GET / HTTP/2.0\r\n\r\n", 2, 0 } };
+
+   for (const auto& testCase : CASES)
+   {
+      Parser parser;
+      feedInPieces(parser, testCase.requestLine, 3, 3);
+      TEST_CHECK(parser.getErrorCode() == RequestError::OK);
+      TEST_CHECK_EQUAL(testCase.major, parser.getVersion().getMajor());
+      TEST_CHECK_EQUAL(testCase.minor, parser.getVersion().getMinor());
+   }
+
+   for (const char* requestLine : { "GET / HTTP1.1\r\n\r\n", "GET / HTTP/\r\n\r\n", "GET / /1.1\r\n\r\n" })
+   {
+      Parser parser;
+      feedInPieces(parser, requestLine, 3, 3);
+      TEST_CHECK(parser.getErrorCode() == RequestError::PARSE_ERROR_INVALID_HTTP_VERSION);
+   }
+}
+
+void testInvalidRequests()
+{
+   {
+      Parser parser;
+      feedInPieces(parser, "BREW /pot HTTP/1.1\r\n\r\n", 4, 4);
+      TEST_CHECK(parser.getErrorCode() == RequestError::CANNOT_HANDLE_HTTP_METHOD);
+   }
+   {
+      Parser parser;
+      feedInPieces(parser, "GET /\r\n\r\n", 4, 4);
+      TEST_CHECK(parser.getState() == Parser::State::FAILED);
+   }
+}
+
+//! Rejects what the device does not serve, as early as possible.
+struct DeviceFilter : AbstractRequestFilter<32>
+{
+   std::string calls;
+
+   virtual const char* requestLineRead(const Request& request)
+   {
+      calls += "line ";
+      if (!request.getResource().toString().startsWith("/api/"))
+      {
+         return "404";
+      }
+      return request.getMethod() == Method::Delete ? "405" : 0;
+   }
+
+   virtual const char* headersRead(const Request& request)
+   {
+      calls += "headers:" + std::string(request.getContentType().c_str()) + " ";
+      return request.getContentLength() > 1000 ? "413" : 0;
+   }
+};
+
+//! Feed _input_ through DeviceFilter, _consumed_ set to the bytes taken.
+std::string filter(const std::string& input, DeviceFilter& deviceFilter, size_t& consumed)
+{
+   Parser parser;
+   parser.setFilter(&deviceFilter);
+   consumed = feedInPieces(parser, input, 5, 5);
+   TEST_CHECK(parser.isDone());
+   if (parser.getErrorCode() != RequestError::OK)
+   {
+      TEST_CHECK(parser.getErrorCode() == RequestError::REJECTED);
+      TEST_CHECK(parser.getState() == Parser::State::FAILED);
+   }
+   return parser.getErrorStatusCode();
+}
+
+void testFilter()
+{
+   const std::string fields("Content-Type: text/plain\r\nContent-Length: 5000\r\n\r\n");
+   size_t consumed(0);
+
+   {
+      // Rejected right after the request line: the fields are not even read.
+      DeviceFilter deviceFilter;
+      TEST_CHECK_EQUAL("404", filter("PUT /index.html HTTP/1.1\r\n" + fields, deviceFilter, consumed));
+      TEST_CHECK_EQUAL("line ", deviceFilter.calls);
+      TEST_CHECK_EQUAL(std::string("PUT /index.html HTTP/1.1\r\n").size(), consumed);
+   }
+   {
+      DeviceFilter deviceFilter;
+      TEST_CHECK_EQUAL("405", filter("DELETE /api/config HTTP/1.1\r\n" + fields, deviceFilter, consumed));
+   }
+   {
+      // Rejected after the header, before any of the body is read.
+      DeviceFilter deviceFilter;
+      const std::string header("PUT /api/config HTTP/1.1\r\n" + fields);
+      TEST_CHECK_EQUAL("413", filter(header + std::string(5000, 'x'), deviceFilter, consumed));
+      TEST_CHECK_EQUAL("line headers:text/plain ", deviceFilter.calls);
+      TEST_CHECK_EQUAL(header.size(), consumed);
+   }
+   {
+      DeviceFilter deviceFilter;
+      TEST_CHECK_EQUAL("200", filter("PUT /api/config HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc", deviceFilter, consumed));
+   }
+   {
+      // Detached again.
+      DeviceFilter deviceFilter;
+      Parser parser;
+      parser.setFilter(&deviceFilter);
+      parser.setFilter(0);
+      feedInPieces(parser, "GET /index.html HTTP/1.1\r\n\r\n", 64, 64);
+      TEST_CHECK(parser.getErrorCode() == RequestError::OK);
+      TEST_CHECK_EQUAL("", deviceFilter.calls);
+   }
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testSplitAnywhere();
+   testFragmented();
+   testLineEndings();
+   testBodyLargerThanBuffer();
+   testHttpVersion();
+   testInvalidRequests();
+   testFilter();
+   return TestSupport::result("HttpRequestParser");
+}
@@ -0,0 +1,156 @@
+//
+//! \file
+//  Unit test for HttpTrace
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Built twice: with ARDUINO_HTTP_SERVER_TRACE, against a library built with
+//! it, and without, where tracing has to compile to nothing.
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "../src/internals/StreamHttpReply.hpp"
+#include "SimulatedStream.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Collects what is printed to it.
+struct StringPrint : Print
+{
+   std::string text;
+   virtual size_t write(uint8_t byte) { text += static_cast<char>(byte); return 1; };
+};
+
+//! Read a request with a body and reply to it.
+void serveRequest()
+{
+   SimulatedStream stream("PUT /api/config HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc", NetworkConditions(), micros());
+   StreamHttpRequest<64> request(stream);
+   TEST_CHECK(request.readRequest());
+   StreamHttpReply(request, "text/plain").send("stored");
+   TEST_CHECK(stream.getOutput().find("HTTP/1.1 200 OK\r\n") == 0);
+}
+
+#ifdef ARDUINO_HTTP_SERVER_TRACE
+
+std::string dump()
+{
+   StringPrint out;
+   HttpTrace::dump(out);
+   return out.text;
+}
+
+//! The event names of a dump, in order.
+std::vector<std::string> eventNames(const std::string& dump)
+{
+   std::vector<std::string> names;
+   for (size_t offset = 0; offset < dump.size(); )
+   {
+      const size_t lineEnd(dump.find("\r\n", offset));
+      const size_t nameStart(dump.find(' ', offset) + 1);
+      names.push_back(dump.substr(nameStart, dump.find(' ', nameStart) - nameStart));
+      offset = lineEnd + 2;
+   }
+   return names;
+}
+
+//! The oldest events are overwritten; the dump starts with the oldest kept,
+//! each line timed relative to the one before.
+void testWrapAround()
+{
+   HttpTrace::clear();
+   TEST_CHECK_EQUAL("", dump());
+
+   for (int i = 0; i < ARDUINO_HTTP_SERVER_TRACE_SIZE + 3; ++i)
+   {
+      ArduinoHost::advanceClock(10UL * i);
+      HttpTrace::record(i % 2 == 0 ? HttpTrace::Event::LINE_READ : HttpTrace::Event::FIELD, i);
+   }
+
+   std::string expected("+0us field 3\r\n");
+   for (int i = 4; i < ARDUINO_HTTP_SERVER_TRACE_SIZE + 3; ++i)
+   {
+      expected += "+" + std::to_string(10 * i) + "us " + (i % 2 == 0 ? "line_read " : "field ") + std::to_string(i) + "\r\n";
+   }
+   TEST_CHECK_EQUAL(expected, dump());
+
+   HttpTrace::clear();
+   HttpTrace::record(HttpTrace::Event::REPLY_DONE, -1);
+   TEST_CHECK_EQUAL("+0us reply_done -1\r\n", dump());
+}
+
+//! Parse and reply events are recorded in the order they happen.
+void testRequestEvents()
+{
+   HttpTrace::clear();
+   serveRequest();
+
+   const std::vector<std::string> names(eventNames(dump()));
+   size_t position(0);
+   for (const char* name : { "request_start", "method", "header_done", "body_read", "request_done",
+                             "reply_start", "input_discarded", "reply_done" })
+   {
+      while (position < names.size() && names[position] != name)
+      {
+         ++position;
+      }
+      TEST_CHECK_EQUAL(name, position < names.size() ? names[position] : "(missing)");
+   }
+   TEST_CHECK_EQUAL("reply_done", names.back());
+}
+
+//! Served as a reply, without Content-Length.
+void testSendReply()
+{
+   HttpTrace::clear();
+   HttpTrace::record(HttpTrace::Event::REQUEST_START, 0);
+
+   SimulatedStream stream("", NetworkConditions(), micros());
+   HttpTrace::sendReply(stream);
+   TEST_CHECK(stream.getOutput().find("Content-Type: text/plain\r\n") != std::string::npos);
+   TEST_CHECK(stream.getOutput().find("Content-Length") == std::string::npos);
+   TEST_CHECK(stream.getOutput().find("\r\n\r\n+0us request_start 0\r\n") != std::string::npos);
+}
+
+#else
+
+//! Without ARDUINO_HTTP_SERVER_TRACE nothing of the trace log is compiled in,
+//! not even the arguments of AHS_TRACE().
+void testDisabled()
+{
+   #ifdef __ArduinoHttpServer__HttpTrace__
+   TEST_CHECK(false);
+   #endif
+
+   int evaluated(0);
+   AHS_TRACE(REQUEST_START, ++evaluated);
+   TEST_CHECK_EQUAL(0, evaluated);
+
+   serveRequest();
+}
+
+#endif
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+#ifdef ARDUINO_HTTP_SERVER_TRACE
+   testWrapAround();
+   testRequestEvents();
+   testSendReply();
+   return TestSupport::result("HttpTrace");
+#else
+   testDisabled();
+   return TestSupport::result("HttpTrace (disabled)");
+#endif
+}
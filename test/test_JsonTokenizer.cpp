@@ -0,0 +1,162 @@
+//
+//! \file
+//  Unit test for JsonTokenizer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/JsonTokenizer.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "SimulatedStream.hpp"
+
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Writes the events it receives as text, e.g. "{ k:on b:true }".
+struct Recorder : AbstractJsonHandler
+{
+   std::string events;
+
+   void startObject() override { events += "{ "; }
+   void endObject() override { events += "} "; }
+   void startArray() override { events += "[ "; }
+   void endArray() override { events += "] "; }
+   void key(const JsonToken& key) override { add("k", key); }
+   void value(const JsonToken& value) override
+   {
+      switch (value.getType())
+      {
+         case JsonToken::Type::STRING: add("s", value); break;
+         case JsonToken::Type::NUMBER: add("n", value); break;
+         case JsonToken::Type::BOOLEAN: add("b", value); break;
+         default: add("null", value); break;
+      }
+   }
+
+   void add(const char* pType, const JsonToken& token)
+   {
+      events += pType;
+      events += ':';
+      events.append(token.getData(), token.getLength());
+      events += ' ';
+   }
+};
+
+const std::string DOCUMENT(
+   "{\"name\": \"lamp \\\"1\\\"\", \"on\": true, \"level\": -12.5e1, \"tags\": [\"a\\nb\", \"\\u00e9\\ud83d\\ude00\", null],"
+   " \"nested\": {\"empty\": [], \"off\": false}}");
+const std::string EVENTS(
+   "{ k:name s:lamp \"1\" k:on b:true k:level n:-12.5e1 k:tags [ s:a\nb s:\xc3\xa9\xf0\x9f\x98\x80 null:null ] "
+   "k:nested { k:empty [ ] k:off b:false } } ");
+
+//! Feed _input_ in pieces of _pieceSize_ bytes, the first _firstPieceSize_ bytes long.
+std::string tokenize(const std::string& input, size_t firstPieceSize, size_t pieceSize, AbstractJsonTokenizer::Error* pError = 0)
+{
+   Recorder recorder;
+   JsonTokenizer<16> tokenizer(recorder);
+
+   size_t offset(0);
+   size_t length(firstPieceSize);
+   while (offset < input.size())
+   {
+      length = length < input.size() - offset ? length : input.size() - offset;
+      tokenizer.feed(input.data() + offset, length);
+      offset += length;
+      length = pieceSize;
+   }
+   const bool complete(tokenizer.finish());
+   if (pError != 0)
+   {
+      *pError = tokenizer.getError();
+   }
+   else
+   {
+      TEST_CHECK(complete);
+   }
+   return recorder.events;
+}
+
+void testSplitAnywhere()
+{
+   for (size_t split = 0; split <= DOCUMENT.size(); ++split)
+   {
+      TEST_CHECK_EQUAL(EVENTS, tokenize(DOCUMENT, split, DOCUMENT.size()));
+   }
+   TEST_CHECK_EQUAL(EVENTS, tokenize(DOCUMENT, 1, 1));
+}
+
+void testErrors()
+{
+   AbstractJsonTokenizer::Error error;
+
+   tokenize("{\"a\" 1}", 3, 3, &error);
+   TEST_CHECK(error == AbstractJsonTokenizer::Error::SYNTAX);
+
+   tokenize("[1, 2", 3, 3, &error);
+   TEST_CHECK(error == AbstractJsonTokenizer::Error::INCOMPLETE);
+
+   tokenize(std::string(AbstractJsonTokenizer::MAX_DEPTH + 1, '['), 8, 8, &error);
+   TEST_CHECK(error == AbstractJsonTokenizer::Error::TOO_DEEP);
+
+   // Split tokens are copied, so their length is bounded by the token buffer.
+   const std::string longString("[\"" + std::string(40, 'x') + "\"]");
+   tokenize(longString, 10, 10, &error);
+   TEST_CHECK(error == AbstractJsonTokenizer::Error::TOKEN_TOO_LONG);
+   TEST_CHECK_EQUAL("[ s:" + std::string(40, 'x') + " ] ", tokenize(longString, longString.size(), 1));
+}
+
+//! A body many times the body buffer, arriving in small packets, streamed
+//! through the tokenizer by streamBody().
+void testStreamBody()
+{
+   std::string body("[");
+   std::string events("[ ");
+   for (int i = 0; i < 100; ++i)
+   {
+      body += (i > 0 ? ", " : "") + std::string("{\"id\": ") + std::to_string(i) + ", \"label\": \"sensor\\t" + std::to_string(i) + "\"}";
+      events += "{ k:id n:" + std::to_string(i) + " k:label s:sensor\t" + std::to_string(i) + " } ";
+   }
+   body += "]";
+   events += "] ";
+   const std::string request("PUT /api/sensors HTTP/1.1\r\nContent-Type: application/json\r\nContent-Length: " +
+                             std::to_string(body.size()) + "\r\n\r\n" + body);
+
+   for (int peek = 0; peek < 2; ++peek)
+   {
+      NetworkConditions conditions;
+      conditions.minFragmentSize = 1;
+      conditions.maxFragmentSize = 97;
+      conditions.interPacketDelayUs = 200;
+      SimulatedStream stream(request, conditions, micros());
+      stream.setPeekBufferAPI(peek != 0);
+
+      StreamHttpRequest<32> httpRequest(stream);
+      TEST_CHECK(httpRequest.readRequest());
+      TEST_CHECK(httpRequest.getUnreadBodyLength() > 0);
+
+      Recorder recorder;
+      JsonTokenizer<16> tokenizer(recorder);
+      TEST_CHECK(httpRequest.streamBody(tokenizer));
+      TEST_CHECK(tokenizer.finish());
+      TEST_CHECK_EQUAL(events, recorder.events);
+      TEST_CHECK_EQUAL(0, httpRequest.getUnreadBodyLength());
+   }
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+   testSplitAnywhere();
+   testErrors();
+   testStreamBody();
+   return TestSupport::result("JsonTokenizer");
+}
@@ -0,0 +1,218 @@
+//
+//! \file
+//  Unit test for JsonWriter and StreamHttpChunkedReply
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/JsonWriter.hpp"
+#include "../src/internals/JsonTokenizer.hpp"
+#include "../src/internals/StreamHttpReply.hpp"
+#include "SimulatedStream.hpp"
+
+#include <stdlib.h>
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Collects what is printed to it.
+struct StringPrint : Print
+{
+   std::string text;
+   virtual size_t write(uint8_t byte) { text += static_cast<char>(byte); return 1; };
+};
+
+//! Stream taking at most _maxWrite_ bytes per write, and _capacity_ bytes in total.
+class ShortWriteStream: public SimulatedStream
+{
+public:
+   ShortWriteStream() : SimulatedStream("", NetworkConditions(), 0UL), maxWrite(SIZE_MAX), capacity(SIZE_MAX) { };
+
+   using SimulatedStream::write;
+   virtual size_t write(const uint8_t* buffer, size_t size)
+   {
+      size = size < maxWrite ? size : maxWrite;
+      size = size < capacity ? size : capacity;
+      capacity -= size;
+      return SimulatedStream::write(buffer, size);
+   }
+
+   size_t maxWrite;
+   size_t capacity;
+};
+
+//! Collects string values.
+struct StringValues : AbstractJsonHandler
+{
+   std::string values;
+   void value(const JsonToken& value) override { values.append(value.getData(), value.getLength()); values += '|'; }
+};
+
+const char TEXT[] = "say \"hi\"\\ \b\f\n\r\t\x01\x1f caf\xc3\xa9";
+const char ESCAPED[] = "say \\\"hi\\\"\\\\ \\b\\f\\n\\r\\t\\u0001\\u001f caf\xc3\xa9";
+
+void writeDocument(AbstractJsonWriter& json)
+{
+   json.beginObject();
+   json.key("text"); json.value(TEXT);
+   json.key("key \"quoted\""); json.value(-42);
+   json.key("list");
+   json.beginArray();
+   json.value(true); json.value(1.5); json.nullValue(); json.value(static_cast<const char*>(0));
+   json.beginObject(); json.endObject();
+   json.endArray();
+   json.endObject();
+}
+
+const std::string DOCUMENT(std::string("{\"text\":\"") + ESCAPED + "\",\"key \\\"quoted\\\"\":-42,"
+                           "\"list\":[true,1.50,null,null,{}]}");
+
+void testEscaping()
+{
+   StringPrint out;
+   {
+      JsonWriter<8> json(out);
+      writeDocument(json);
+   }
+   TEST_CHECK_EQUAL(DOCUMENT, out.text);
+
+   JsonWriter<> counter;
+   writeDocument(counter);
+   TEST_CHECK_EQUAL(DOCUMENT.size(), counter.getLength());
+}
+
+//! What the writer escapes, the tokenizer unescapes.
+void testRoundTrip()
+{
+   StringPrint out;
+   {
+      JsonWriter<> json(out);
+      json.beginArray();
+      json.value(TEXT);
+      json.endArray();
+   }
+
+   StringValues values;
+   JsonTokenizer<64> tokenizer(values);
+   tokenizer.feed(out.text.data(), out.text.size());
+   TEST_CHECK(tokenizer.finish());
+   TEST_CHECK_EQUAL(std::string(TEXT) + "|", values.values);
+}
+
+//! The body of a chunked reply, or "invalid" when the framing is broken.
+std::string dechunk(const std::string& reply, bool* pComplete)
+{
+   size_t offset(reply.find("\r\n\r\n"));
+   if (offset == std::string::npos)
+   {
+      return "invalid";
+   }
+   offset += 4;
+
+   std::string body;
+   *pComplete = false;
+   while (offset < reply.size())
+   {
+      const size_t lineEnd(reply.find("\r\n", offset));
+      if (lineEnd == std::string::npos)
+      {
+         return "invalid";
+      }
+      const size_t size(strtoul(reply.c_str() + offset, 0, 16));
+      offset = lineEnd + 2;
+      if (size == 0)
+      {
+         *pComplete = reply.compare(offset, std::string::npos, "\r\n") == 0;
+         return *pComplete ? body : "invalid";
+      }
+      if (offset + size > reply.size())
+      {
+         return "invalid";
+      }
+      body.append(reply, offset, size);
+      offset += size;
+      if (offset == reply.size())
+      {
+         break; // The chunk's CRLF follows with the next chunk.
+      }
+      if (reply.compare(offset, 2, "\r\n") != 0)
+      {
+         return "invalid";
+      }
+      offset += 2;
+   }
+   return body;
+}
+
+void testChunkedReply()
+{
+   ShortWriteStream stream;
+   StreamHttpChunkedReply httpReply(stream, "application/json");
+   httpReply.begin();
+   {
+      JsonWriter<16> json(httpReply);
+      writeDocument(json);
+   }
+   httpReply.end();
+
+   bool complete(false);
+   TEST_CHECK(stream.getOutput().find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+   TEST_CHECK_EQUAL(DOCUMENT, dechunk(stream.getOutput(), &complete));
+   TEST_CHECK(complete);
+   TEST_CHECK(!httpReply.hasFailed());
+}
+
+//! A stream taking only a few bytes at a time still gets whole chunks.
+void testChunkedReplyShortWrites()
+{
+   ShortWriteStream stream;
+   StreamHttpChunkedReply httpReply(stream, "application/json");
+   httpReply.begin();
+   stream.maxWrite = 3;
+   {
+      JsonWriter<16> json(httpReply);
+      writeDocument(json);
+   }
+   httpReply.end();
+
+   bool complete(false);
+   TEST_CHECK_EQUAL(DOCUMENT, dechunk(stream.getOutput(), &complete));
+   TEST_CHECK(complete);
+   TEST_CHECK(!httpReply.hasFailed());
+}
+
+//! A stream which stops taking data fails the reply: nothing follows, in
+//! particular no last chunk which would make the truncated body look complete.
+void testChunkedReplyFailed()
+{
+   ShortWriteStream stream;
+   StreamHttpChunkedReply httpReply(stream, "application/json");
+   httpReply.begin();
+   const size_t headerSize(stream.getOutput().size());
+   stream.capacity = 10;
+
+   TEST_CHECK_EQUAL(0, httpReply.write(reinterpret_cast<const uint8_t*>(DOCUMENT.data()), DOCUMENT.size()));
+   TEST_CHECK(httpReply.hasFailed());
+   stream.capacity = SIZE_MAX;
+   TEST_CHECK_EQUAL(0, httpReply.write(reinterpret_cast<const uint8_t*>("[]"), 2));
+   httpReply.end();
+
+   TEST_CHECK_EQUAL(headerSize + 10, stream.getOutput().size());
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testEscaping();
+   testRoundTrip();
+   testChunkedReply();
+   testChunkedReplyShortWrites();
+   testChunkedReplyFailed();
+   return TestSupport::result("JsonWriter");
+}
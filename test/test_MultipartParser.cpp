@@ -0,0 +1,120 @@
+//
+//! \file
+//  Unit test for MultipartParser
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/MultipartParser.hpp"
+
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Writes the parts it receives as text, e.g. "<name|file|type>content</>".
+struct Recorder : AbstractMultipartHandler
+{
+   std::string parts;
+
+   void partBegin(const char* name, const char* filename, const char* contentType) override
+   {
+      parts += std::string("<") + name + "|" + filename + "|" + contentType + ">";
+   }
+   void partData(const char* data, size_t length) override { parts.append(data, length); }
+   void partEnd() override { parts += "</>"; }
+};
+
+const char CONTENT_TYPE[] = "multipart/form-data; boundary=\"----Boundary7MA4YWxk\"";
+
+//! The content of the file part looks like the delimiter in several places.
+const std::string FILE_CONTENT("line 1\r\n----Boundary7MA4YWx\r\n--\r\n----Boundary7MA4YWxkX\n\r\n-\r\r\n");
+
+const std::string BODY(
+   "preamble, ignored\r\n"
+   "------Boundary7MA4YWxk\r\n"
+   "Content-Disposition: form-data; name=\"label\"\r\n"
+   "\r\n"
+   "kitchen\r\n"
+   "------Boundary7MA4YWxk\r\n"
+   "Content-Disposition: form-data; name=\"firmware\"; filename=\"fw.bin\"\r\n"
+   "Content-Type: application/octet-stream\r\n"
+   "\r\n" +
+   FILE_CONTENT + "\r\n"
+   "------Boundary7MA4YWxk--\r\n"
+   "epilogue, ignored");
+
+const std::string PARTS(
+   "<label||>kitchen</>"
+   "<firmware|fw.bin|application/octet-stream>" + FILE_CONTENT + "</>");
+
+//! Parse _input_ in pieces of _pieceSize_ bytes, the first _firstPieceSize_ bytes long.
+std::string parse(const std::string& input, size_t firstPieceSize, size_t pieceSize, bool* pFinished)
+{
+   Recorder recorder;
+   MultipartParser parser(recorder);
+   TEST_CHECK(parser.begin(CONTENT_TYPE));
+
+   size_t offset(0);
+   size_t length(firstPieceSize);
+   while (offset < input.size())
+   {
+      length = length < input.size() - offset ? length : input.size() - offset;
+      TEST_CHECK_EQUAL(length, parser.feed(input.data() + offset, length));
+      offset += length;
+      length = pieceSize;
+   }
+   *pFinished = parser.finish();
+   return recorder.parts;
+}
+
+//! Every split of the body in two, so the delimiter is split at every offset.
+void testSplitAnywhere()
+{
+   for (size_t split = 0; split <= BODY.size(); ++split)
+   {
+      bool finished(false);
+      TEST_CHECK_EQUAL(PARTS, parse(BODY, split, BODY.size(), &finished));
+      TEST_CHECK(finished);
+   }
+}
+
+void testFragmented()
+{
+   for (size_t pieceSize = 1; pieceSize <= 80; ++pieceSize)
+   {
+      bool finished(false);
+      TEST_CHECK_EQUAL(PARTS, parse(BODY, pieceSize, pieceSize, &finished));
+      TEST_CHECK(finished);
+   }
+}
+
+void testErrors()
+{
+   {
+      Recorder recorder;
+      MultipartParser parser(recorder);
+      TEST_CHECK(!parser.begin("multipart/form-data"));
+      TEST_CHECK(parser.getError() == MultipartParser::Error::NO_BOUNDARY);
+   }
+   {
+      // Cut off in the middle of the file.
+      bool finished(true);
+      parse(BODY.substr(0, BODY.find("line 1") + 4), 7, 7, &finished);
+      TEST_CHECK(!finished);
+   }
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testSplitAnywhere();
+   testFragmented();
+   testErrors();
+   return TestSupport::result("MultipartParser");
+}
@@ -0,0 +1,250 @@
+//
+//! \file
+//  Unit test for RecordingStream, RecordingBuffer and ReplayStream
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "../src/internals/StreamHttpReply.hpp"
+#include "../src/internals/RecordingStream.hpp"
+#include "SimulatedStream.hpp"
+#include "ReplayStream.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+typedef StreamHttpRequest<256> Request;
+
+//! Collects what is printed to it.
+struct StringPrint : Print
+{
+   std::string text;
+   using Print::write;
+   virtual size_t write(uint8_t byte) { text += static_cast<char>(byte); return 1; };
+   virtual size_t write(const uint8_t* buffer, size_t size) { text.append(reinterpret_cast<const char*>(buffer), size); return size; };
+};
+
+std::string bytes(std::initializer_list<uint8_t> values)
+{
+   return std::string(values.begin(), values.end());
+}
+
+std::vector<ReplayStream::Connection> parse(const std::string& capture)
+{
+   bool complete(false);
+   const std::vector<ReplayStream::Connection> connections(ReplayStream::parseCapture(capture, complete));
+   TEST_CHECK(complete);
+   return connections;
+}
+
+//! Unsigned LEB128: 7 bits per byte, least significant first, the high bit
+//! set on all but the last byte.
+void testVarint()
+{
+   struct { unsigned long value; std::string encoded; } const CASES[] = {
+      { 0UL, bytes({0x00}) },
+      { 1UL, bytes({0x01}) },
+      { 127UL, bytes({0x7F}) },
+      { 128UL, bytes({0x80, 0x01}) },
+      { 300UL, bytes({0xAC, 0x02}) },
+      { 16384UL, bytes({0x80, 0x80, 0x01}) },
+      { 0xFFFFFFFFUL, bytes({0xFF, 0xFF, 0xFF, 0xFF, 0x0F}) } };
+
+   for (const auto& testCase : CASES)
+   {
+      unsigned long value(1234UL);
+      const uint8_t* pIn(reinterpret_cast<const uint8_t*>(testCase.encoded.data()));
+      TEST_CHECK_EQUAL(testCase.encoded.size(), decodeRecordingVarint(pIn, testCase.encoded.size(), value));
+      TEST_CHECK_EQUAL(testCase.value, value);
+      // Cut short.
+      TEST_CHECK_EQUAL(0, decodeRecordingVarint(pIn, testCase.encoded.size() - 1, value));
+   }
+
+   // Longer than any number written.
+   const std::string tooLong(bytes({0x80, 0x80, 0x80, 0x80, 0x80, 0x01}));
+   unsigned long value(0);
+   TEST_CHECK_EQUAL(0, decodeRecordingVarint(reinterpret_cast<const uint8_t*>(tooLong.data()), tooLong.size(), value));
+
+   // As RecordingStream writes them: 300 us before the first read.
+   StringPrint capture;
+   SimulatedStream stream("GET", NetworkConditions(), micros());
+   {
+      const unsigned long startMs(millis());
+      RecordingStream recording(stream, capture);
+      ArduinoHost::advanceClock(300UL);
+      char buffer[3];
+      TEST_CHECK_EQUAL(3, recording.readBytes(buffer, 3));
+      recording.endRecording();
+
+      TEST_CHECK_EQUAL('C', capture.text[0]);
+      value = 0;
+      const size_t used(decodeRecordingVarint(reinterpret_cast<const uint8_t*>(capture.text.data()) + 1, capture.text.size() - 1, value));
+      TEST_CHECK_EQUAL(startMs, value);
+      TEST_CHECK_EQUAL(std::string("D") + bytes({0xAC, 0x02, 0x03}) + "GET", capture.text.substr(1 + used));
+   }
+}
+
+//! A record ends after RECORD_DATA_SIZE bytes, after a pause of more than
+//! RECORD_GAP_US between reads and when the reply is written.
+void testRecords()
+{
+   const std::string input(std::string(RecordingStream::RECORD_DATA_SIZE + 8, 'a') + "bcdef");
+   SimulatedStream stream(input, NetworkConditions(), micros());
+   StringPrint capture;
+   {
+      RecordingStream recording(stream, capture);
+      char buffer[64];
+      recording.readBytes(buffer, RecordingStream::RECORD_DATA_SIZE + 8);
+      ArduinoHost::advanceClock(RecordingStream::RECORD_GAP_US);
+      recording.read();
+      ArduinoHost::advanceClock(RecordingStream::RECORD_GAP_US + 1);
+      recording.readBytes(buffer, 2);
+      recording.print("reply");
+      recording.readBytes(buffer, 2);
+   }
+   TEST_CHECK_EQUAL("reply", stream.getOutput());
+
+   const std::vector<ReplayStream::Connection> connections(parse(capture.text));
+   TEST_CHECK_EQUAL(1, connections.size());
+   const std::vector<ReplayStream::Record>& records(connections[0].records);
+   TEST_CHECK_EQUAL(4, records.size());
+   if (records.size() == 4)
+   {
+      TEST_CHECK_EQUAL(std::string(RecordingStream::RECORD_DATA_SIZE, 'a'), records[0].data);
+      TEST_CHECK_EQUAL("aaaaaaaab", records[1].data);
+      TEST_CHECK_EQUAL("cd", records[2].data);
+      TEST_CHECK_EQUAL("ef", records[3].data);
+      TEST_CHECK_EQUAL(0, records[1].delayUs);
+      TEST_CHECK_EQUAL(2 * RecordingStream::RECORD_GAP_US + 1, records[2].delayUs);
+   }
+   TEST_CHECK_EQUAL(input, connections[0].getData());
+}
+
+//! A captured request replays with the same content and spacing, and is
+//! captured the same way again.
+void testRoundTrip()
+{
+   const std::string input("PUT /api/config HTTP/1.1\r\nHost: device.local\r\nContent-Length: 40\r\n\r\n" + std::string(40, 'x'));
+   NetworkConditions conditions;
+   conditions.minFragmentSize = 16U;
+   conditions.maxFragmentSize = 24U;
+   conditions.interPacketDelayUs = 5000UL;
+   conditions.jitterUs = 2000UL;
+   SimulatedStream stream(input, conditions, micros() + 3000UL);
+
+   StringPrint capture;
+   {
+      RecordingStream recording(stream, capture);
+      Request request(recording);
+      TEST_CHECK(request.readRequest());
+      StreamHttpReply(request, "text/plain").send("stored");
+   }
+   const std::vector<ReplayStream::Connection> connections(parse(capture.text));
+   TEST_CHECK_EQUAL(1, connections.size());
+   TEST_CHECK_EQUAL(input, connections[0].getData());
+   TEST_CHECK(connections[0].records.size() > 2);
+
+   ReplayStream replay(connections[0], micros());
+   StringPrint recapture;
+   {
+      RecordingStream recording(replay, recapture);
+      Request request(recording);
+      TEST_CHECK(request.readRequest());
+      TEST_CHECK(request.getMethod() == Method::Put);
+      TEST_CHECK_EQUAL("/api/config", request.getResource().toString().c_str());
+      TEST_CHECK_EQUAL(std::string(40, 'x'), std::string(request.getBody(), request.getBodyLength()));
+      StreamHttpReply(request, "text/plain").send("stored");
+   }
+   TEST_CHECK_EQUAL(stream.getOutput(), replay.getOutput());
+
+   const std::vector<ReplayStream::Connection> replayed(parse(recapture.text));
+   TEST_CHECK_EQUAL(1, replayed.size());
+   TEST_CHECK_EQUAL(connections[0].records.size(), replayed[0].records.size());
+   for (size_t i = 0; i < connections[0].records.size() && i < replayed[0].records.size(); ++i)
+   {
+      const ReplayStream::Record& original(connections[0].records[i]);
+      const ReplayStream::Record& again(replayed[0].records[i]);
+      TEST_CHECK_EQUAL(original.data, again.data);
+      const long difference(static_cast<long>(again.delayUs) - static_cast<long>(original.delayUs));
+      TEST_CHECK(difference >= -1000L && difference <= 1000L);
+   }
+
+   // A truncated capture replays up to the last whole record.
+   bool complete(true);
+   TEST_CHECK_EQUAL(1, ReplayStream::parseCapture(capture.text.substr(0, capture.text.size() - 1), complete).size());
+   TEST_CHECK(!complete);
+}
+
+//! Record _data_ as one connection into _sink_.
+void recordConnection(const std::string& data, Print& sink)
+{
+   SimulatedStream stream(data, NetworkConditions(), micros());
+   RecordingStream recording(stream, sink);
+   char buffer[256];
+   TEST_CHECK_EQUAL(data.size(), recording.readBytes(buffer, data.size()));
+   ArduinoHost::advanceClock(10000UL);
+}
+
+//! Whole connections are dropped from the front to make room; records of a
+//! connection larger than the buffer are dropped themselves.
+void testBufferOverflow()
+{
+   RecordingBuffer<96> buffer;
+   recordConnection("GET /1 HTTP/1.1\r\n\r\n", buffer);
+   recordConnection("GET /2 HTTP/1.1\r\n\r\n", buffer);
+   recordConnection("GET /3 HTTP/1.1\r\n\r\n", buffer);
+   TEST_CHECK_EQUAL(0, buffer.getDroppedRecords());
+
+   std::vector<ReplayStream::Connection> connections(parse(std::string(reinterpret_cast<const char*>(buffer.getData()), buffer.getLength())));
+   TEST_CHECK_EQUAL(3, connections.size());
+
+   recordConnection("GET /4 HTTP/1.1\r\n\r\n", buffer);
+   recordConnection("GET /5 HTTP/1.1\r\n\r\n", buffer);
+   TEST_CHECK(buffer.getLength() <= 96);
+   TEST_CHECK_EQUAL(RECORDING_TAG_CONNECTION, buffer.getData()[0]);
+   connections = parse(std::string(reinterpret_cast<const char*>(buffer.getData()), buffer.getLength()));
+   TEST_CHECK(connections.size() >= 2);
+   TEST_CHECK_EQUAL("GET /5 HTTP/1.1\r\n\r\n", connections.back().getData());
+   TEST_CHECK_EQUAL("GET /4 HTTP/1.1\r\n\r\n", connections[connections.size() - 2].getData());
+   TEST_CHECK_EQUAL(0, buffer.getDroppedRecords());
+
+   // Only its first records fit, all older connections dropped.
+   const std::string large("POST /upload HTTP/1.1\r\n\r\n" + std::string(200, 'u'));
+   recordConnection(large, buffer);
+   TEST_CHECK(buffer.getDroppedRecords() > 0);
+   connections = parse(std::string(reinterpret_cast<const char*>(buffer.getData()), buffer.getLength()));
+   TEST_CHECK_EQUAL(1, connections.size());
+   TEST_CHECK(!connections.empty() && large.compare(0, connections[0].getData().size(), connections[0].getData()) == 0);
+
+   // Served as it is.
+   SimulatedStream stream("", NetworkConditions(), micros());
+   buffer.sendReply(stream);
+   const std::string capture(reinterpret_cast<const char*>(buffer.getData()), buffer.getLength());
+   TEST_CHECK(stream.getOutput().size() > capture.size());
+   TEST_CHECK_EQUAL(capture, stream.getOutput().substr(stream.getOutput().size() - capture.size()));
+
+   buffer.clear();
+   TEST_CHECK_EQUAL(0, buffer.getLength());
+   TEST_CHECK_EQUAL(0, buffer.getDroppedRecords());
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+   testVarint();
+   testRecords();
+   testRoundTrip();
+   testBufferOverflow();
+   return TestSupport::result("RecordingStream");
+}
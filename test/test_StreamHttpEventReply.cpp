@@ -0,0 +1,194 @@
+//
+//! \file
+//  Unit test for StreamHttpEventReply and EventSubscribers
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "../src/internals/StreamHttpEventReply.hpp"
+#include "SimulatedStream.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! What the other end of a FakeClient sees.
+struct Connection
+{
+   Connection() : output(), writeSpace(1460), connected(true), stopped(false) { };
+
+   std::string output;
+   int writeSpace;
+   bool connected;
+   bool stopped;
+};
+
+//! Client handle, copies sharing the connection as WiFiClient copies do.
+class FakeClient: public Stream
+{
+public:
+   FakeClient() : m_connection() { };
+   explicit FakeClient(const std::shared_ptr<Connection>& connection) : m_connection(connection) { };
+
+   virtual int available() { return 0; };
+   virtual int read() { return -1; };
+   virtual int peek() { return -1; };
+   virtual size_t write(uint8_t byte) { m_connection->output += static_cast<char>(byte); return 1; };
+   virtual int availableForWrite() { return m_connection->writeSpace; };
+
+   bool connected() { return m_connection && m_connection->connected; };
+   void stop() { m_connection->stopped = true; };
+
+private:
+   std::shared_ptr<Connection> m_connection;
+};
+
+const char HEADER[] = "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Type: text/event-stream\r\n"
+                      "Cache-Control: no-cache\r\n\r\n";
+
+//! The header is that of any reply, with the retry delay after it.
+void testHeader()
+{
+   SimulatedStream stream("GET /events HTTP/1.1\r\nHost: device.local\r\n\r\n", NetworkConditions(), micros());
+   StreamHttpRequest<64> request(stream);
+   TEST_CHECK(request.readRequest());
+   StreamHttpEventReply httpReply(request);
+   httpReply.send(3000UL);
+   TEST_CHECK_EQUAL(std::string(HEADER) + "retry: 3000\n\n", stream.getOutput());
+
+   std::shared_ptr<Connection> connection(new Connection());
+   FakeClient client(connection);
+   StreamHttpEventReply(client).send();
+   TEST_CHECK_EQUAL(HEADER, connection->output);
+}
+
+//! Fields in order, each line of the data a field of its own, an empty line
+//! ending the event.
+void testFraming()
+{
+   std::shared_ptr<Connection> connection(new Connection());
+   FakeClient client(connection);
+   StreamHttpEventReply httpReply(client);
+
+   TEST_CHECK_EQUAL(42, httpReply.sendEvent(4294967295UL, "reading", "21.5"));
+   TEST_CHECK_EQUAL("id: 4294967295\nevent: reading\ndata: 21.5\n\n", connection->output);
+
+   connection->output.clear();
+   TEST_CHECK_EQUAL(9, httpReply.sendEvent(static_cast<const char*>(0), 0, "x"));
+   TEST_CHECK_EQUAL("data: x\n\n", connection->output);
+
+   connection->output.clear();
+   const char* pLines("first\r\nsecond\n\nlast");
+   const std::string expected("id: a\ndata: first\ndata: second\ndata: \ndata: last\n\n");
+   TEST_CHECK_EQUAL(expected.size(), StreamHttpEventReply::getEventLength("a", "", pLines));
+   TEST_CHECK_EQUAL(expected.size(), httpReply.sendEvent("a", "", pLines));
+   TEST_CHECK_EQUAL(expected, connection->output);
+
+   // Larger than the event buffer.
+   connection->output.clear();
+   const std::string data(150, 'd');
+   httpReply.sendEvent(1UL, 0, data.c_str());
+   TEST_CHECK_EQUAL("id: 1\ndata: " + data + "\n\n", connection->output);
+
+   connection->output.clear();
+   TEST_CHECK_EQUAL(11, httpReply.sendComment("ping\n"));
+   TEST_CHECK_EQUAL(": ping\n: \n\n", connection->output);
+}
+
+//! Events are written however full the send buffer is, unless dropping is
+//! enabled.
+void testDropWhenFull()
+{
+   std::shared_ptr<Connection> connection(new Connection());
+   FakeClient client(connection);
+   StreamHttpEventReply httpReply(client);
+   httpReply.send();
+   connection->output.clear();
+   connection->writeSpace = 0;
+
+   TEST_CHECK(httpReply.sendEvent(1UL, 0, "1") > 0);
+   TEST_CHECK_EQUAL("id: 1\ndata: 1\n\n", connection->output);
+
+   httpReply.setDropWhenFull(true);
+   TEST_CHECK_EQUAL(0, httpReply.sendEvent(2UL, 0, "2"));
+   connection->writeSpace = 13;
+   TEST_CHECK_EQUAL(0, httpReply.sendEvent(3UL, 0, "3"));
+   TEST_CHECK_EQUAL(0, httpReply.sendComment("keep alive"));
+   TEST_CHECK_EQUAL(3, httpReply.getDroppedEvents());
+   TEST_CHECK_EQUAL("id: 1\ndata: 1\n\n", connection->output);
+
+   connection->writeSpace = 15;
+   TEST_CHECK_EQUAL(15, httpReply.sendEvent(4UL, 0, "4"));
+   TEST_CHECK_EQUAL("id: 1\ndata: 1\n\nid: 4\ndata: 4\n\n", connection->output);
+}
+
+//! Slots are taken up to the maximum and freed when a client disconnects.
+void testSubscribers()
+{
+   std::shared_ptr<Connection> connections[3] = { std::make_shared<Connection>(), std::make_shared<Connection>(), std::make_shared<Connection>() };
+   EventSubscribers<FakeClient, 2> subscribers;
+
+   TEST_CHECK_EQUAL(0, subscribers.getCount());
+   TEST_CHECK(subscribers.add(FakeClient(connections[0]), 1000UL));
+   TEST_CHECK(subscribers.add(FakeClient(connections[1])));
+   TEST_CHECK(!subscribers.add(FakeClient(connections[2])));
+   TEST_CHECK_EQUAL(2, subscribers.getCount());
+   TEST_CHECK_EQUAL(std::string(HEADER) + "retry: 1000\n\n", connections[0]->output);
+   TEST_CHECK_EQUAL(HEADER, connections[1]->output);
+   TEST_CHECK_EQUAL("", connections[2]->output);
+
+   TEST_CHECK_EQUAL(2, subscribers.broadcast("reading", "42"));
+   TEST_CHECK_EQUAL(1, subscribers.getLastEventId());
+   TEST_CHECK_EQUAL(std::string(HEADER) + "id: 1\nevent: reading\ndata: 42\n\n", connections[1]->output);
+
+   connections[0]->connected = false;
+   TEST_CHECK_EQUAL(1, subscribers.getCount());
+   TEST_CHECK(connections[0]->stopped);
+   TEST_CHECK(!connections[1]->stopped);
+
+   TEST_CHECK(subscribers.add(FakeClient(connections[2])));
+   TEST_CHECK_EQUAL(2, subscribers.broadcast("reading", "43"));
+   TEST_CHECK_EQUAL(std::string(HEADER) + "id: 2\nevent: reading\ndata: 43\n\n", connections[2]->output);
+   TEST_CHECK(connections[0]->output.find("id: 2") == std::string::npos);
+
+   subscribers.keepAlive();
+   TEST_CHECK(connections[1]->output.find("data: 43\n\n: \n\n") != std::string::npos);
+   TEST_CHECK_EQUAL(0, subscribers.getDroppedEvents());
+}
+
+//! Subscribers constructed to drop events skip a full client only.
+void testSubscribersDropWhenFull()
+{
+   std::shared_ptr<Connection> full(new Connection());
+   std::shared_ptr<Connection> idle(new Connection());
+   EventSubscribers<FakeClient, 2> subscribers(true);
+   subscribers.add(FakeClient(full));
+   subscribers.add(FakeClient(idle));
+
+   full->writeSpace = 0;
+   TEST_CHECK_EQUAL(1, subscribers.broadcast("reading", "42"));
+   TEST_CHECK_EQUAL(1, subscribers.getDroppedEvents());
+   TEST_CHECK_EQUAL(HEADER, full->output);
+   TEST_CHECK(idle->output.find("id: 1\n") != std::string::npos);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+   testHeader();
+   testFraming();
+   testDropWhenFull();
+   testSubscribers();
+   testSubscribersDropWhenFull();
+   return TestSupport::result("StreamHttpEventReply");
+}
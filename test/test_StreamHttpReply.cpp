@@ -0,0 +1,364 @@
+//
+//! \file
+//  Unit test for StreamHttpReply
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "../src/internals/StreamHttpReply.hpp"
+#include "../src/internals/StreamHttpEventReply.hpp"
+#include "SimulatedStream.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+typedef StreamHttpRequest<64> Request;
+
+//! The header of _reply_, up to and including the empty line.
+std::string headerOf(const std::string& reply)
+{
+   const size_t end(reply.find("\r\n\r\n"));
+   return end != std::string::npos ? reply.substr(0, end + 4) : "invalid";
+}
+
+//! Reply to "_method_ /", sent by _sendReply_.
+template <class SEND_REPLY>
+std::string reply(const std::string& method, SEND_REPLY sendReply)
+{
+   SimulatedStream stream(method + " / HTTP/1.1\r\nHost: device.local\r\n\r\n", NetworkConditions(), micros());
+   Request request(stream);
+   TEST_CHECK(request.readRequest());
+   sendReply(request);
+   return stream.getOutput();
+}
+
+//! HEAD gets exactly the header GET gets, and no body.
+template <class SEND_REPLY>
+void checkHead(SEND_REPLY sendReply)
+{
+   const std::string get(reply("GET", sendReply));
+   const std::string head(reply("HEAD", sendReply));
+   TEST_CHECK_EQUAL(headerOf(get), head);
+   TEST_CHECK(get.size() > head.size());
+}
+
+//! Source of repeating digits, handing out at most _maxRead_ bytes per read()
+//! and nothing from _endOffset_ on.
+class DigitSource: public AbstractSegmentSource
+{
+public:
+   DigitSource(size_t maxRead, size_t endOffset = SIZE_MAX) : m_maxRead(maxRead), m_endOffset(endOffset) { };
+
+   virtual size_t read(size_t offset, uint8_t* pBuffer, size_t size)
+   {
+      size = size < m_maxRead ? size : m_maxRead;
+      size_t i(0);
+      for (; i < size && offset + i < m_endOffset; ++i) { pBuffer[i] = static_cast<uint8_t>('0' + (offset + i) % 10); }
+      return i;
+   }
+
+   static std::string digits(size_t length)
+   {
+      std::string text;
+      for (size_t i = 0; i < length; ++i) { text += static_cast<char>('0' + i % 10); }
+      return text;
+   }
+
+private:
+   const size_t m_maxRead;
+   const size_t m_endOffset;
+};
+
+//! Error page of its own, as applications customize it.
+class BrandedErrorReply: public StreamHttpErrorReply
+{
+public:
+   BrandedErrorReply(Request& request, const String& code) : StreamHttpErrorReply(request, "text/html", code) { };
+
+protected:
+   virtual String getHtmlBody(const String& data) { return "<html><body><h1>Weather station</h1>" + data + "</body></html>"; };
+};
+
+void testHead()
+{
+   checkHead([](Request& request) { StreamHttpReply(request, "application/json").send("{\"on\": true}"); });
+   checkHead([](Request& request) { StreamHttpReply(request, "application/octet-stream").send(reinterpret_cast<const uint8_t*>("\x01\x02"), 2); });
+   checkHead([](Request& request)
+   {
+      DigitSource source(SIZE_MAX);
+      StreamHttpReply(request, "text/html").send({ReplySegment::ram("<p>"), ReplySegment::pull(source, 300), ReplySegment::flash(F("</p>"))});
+   });
+
+   checkHead([](Request& request) { StreamHttpErrorReply(request, "text/html", "404").send("Not \"here\""); });
+   checkHead([](Request& request) { StreamHttpErrorReply(request, "application/json", "404").send("Not \"here\""); });
+   checkHead([](Request& request) { StreamHttpErrorReply(request, "text/plain", "404").send("Not here"); });
+   checkHead([](Request& request) { StreamHttpAuthenticateReply(request, "text/html").send(); });
+   checkHead([](Request& request) { BrandedErrorReply(request, "503").send("Sensor offline"); });
+
+   checkHead([](Request& request)
+   {
+      StreamHttpChunkedReply httpReply(request, "text/plain");
+      httpReply.begin();
+      httpReply.print("chunk");
+      httpReply.end();
+   });
+   checkHead([](Request& request)
+   {
+      StreamHttpEventReply httpReply(request);
+      httpReply.send(3000UL);
+      httpReply.sendEvent(1UL, "reading", "21.5");
+   });
+}
+
+//! SimulatedStream counting the writes it gets.
+class CountingStream: public SimulatedStream
+{
+public:
+   CountingStream() : SimulatedStream("", NetworkConditions(), 0UL), writes(0), maxWriteSize(0) { };
+
+   using SimulatedStream::write;
+   virtual size_t write(const uint8_t* buffer, size_t size)
+   {
+      ++writes;
+      maxWriteSize = size > maxWriteSize ? size : maxWriteSize;
+      return SimulatedStream::write(buffer, size);
+   }
+
+   size_t writes;
+   size_t maxWriteSize;
+};
+
+const char HEADER[] PROGMEM = "<html><body><p>Temperature: ";
+
+std::string bodyOf(const std::string& reply)
+{
+   const size_t end(reply.find("\r\n\r\n"));
+   return end != std::string::npos ? reply.substr(end + 4) : "invalid";
+}
+
+//! Content-Length is the sum of the segments, sent in the order given,
+//! whatever their kind and however they fall across the buffer.
+void testSegments()
+{
+   const std::string large(AbstractStreamHttpReply::SEGMENT_BUFFER_SIZE + 1, 'L');
+   DigitSource source(7);
+   CountingStream stream;
+   StreamHttpReply httpReply(stream, "text/html");
+   TEST_CHECK(httpReply.send({ReplySegment::flash(HEADER, strlen_P(HEADER)),
+                              ReplySegment::ram(String("21.5")),
+                              ReplySegment::pull(source, 300),
+                              ReplySegment::ram(large.c_str()),
+                              ReplySegment::ram(""),
+                              ReplySegment::flash(F(" &deg;C</p></body></html>"))}));
+
+   const std::string body(std::string(HEADER) + "21.5" + DigitSource::digits(300) + large + " &deg;C</p></body></html>");
+   TEST_CHECK_EQUAL(body, bodyOf(stream.getOutput()));
+   TEST_CHECK(stream.getOutput().find("Content-Length: " + std::to_string(body.size()) + "\r\n") != std::string::npos);
+   // Small pieces are collected in the buffer, large RAM segments written as they are.
+   TEST_CHECK(stream.maxWriteSize == large.size());
+   TEST_CHECK(stream.writes < 8);
+}
+
+//! Header and a small body go out in a single write.
+void testSegmentsSingleWrite()
+{
+   CountingStream stream;
+   StreamHttpReply httpReply(stream, "text/html");
+   TEST_CHECK(httpReply.send({ReplySegment::ram("<p>"), ReplySegment::ram(String(42)), ReplySegment::flash(F("</p>"))}));
+   TEST_CHECK_EQUAL("<p>42</p>", bodyOf(stream.getOutput()));
+   TEST_CHECK(stream.getOutput().find("Content-Length: 9\r\n") != std::string::npos);
+   TEST_CHECK_EQUAL(1, stream.writes);
+}
+
+//! A source ending early fails the reply, the body cut off where it ended.
+void testSegmentSourceEndsEarly()
+{
+   DigitSource source(16, 150);
+   CountingStream stream;
+   StreamHttpReply httpReply(stream, "text/plain");
+   TEST_CHECK(!httpReply.send({ReplySegment::ram("digits:"), ReplySegment::pull(source, 300), ReplySegment::ram("end")}));
+   TEST_CHECK_EQUAL("digits:" + DigitSource::digits(150), bodyOf(stream.getOutput()));
+   TEST_CHECK(stream.getOutput().find("Content-Length: 310\r\n") != std::string::npos);
+}
+
+//! A reply constructed from its request discards exactly the unread body,
+//! so the next request on the connection still parses.
+void testPipelined()
+{
+   const std::string first("PUT /config HTTP/1.1\r\nContent-Length: 100\r\n\r\n" + std::string(100, 'x'));
+   SimulatedStream stream(first + "GET /status HTTP/1.1\r\n\r\n", NetworkConditions(), micros());
+   {
+      Request request(stream);
+      TEST_CHECK(request.readRequest());
+      TEST_CHECK(request.getUnreadBodyLength() > 0);
+      TEST_CHECK_EQUAL(100, request.getBodyLength() + request.getUnreadBodyLength());
+      StreamHttpReply(request, "text/plain").send("stored");
+   }
+   Request request(stream);
+   TEST_CHECK(request.readRequest());
+   TEST_CHECK(request.getMethod() == Method::Get);
+   TEST_CHECK_EQUAL("/status", request.getResource().toString().c_str());
+}
+
+//! Error body of its own, in the format the API uses elsewhere.
+class ApiErrorReply: public StreamHttpErrorReply
+{
+public:
+   ApiErrorReply(Request& request) : StreamHttpErrorReply(request, "application/json", "404") { };
+
+protected:
+   virtual String getJsonBody(const String& data) { return "{\"code\": 404, \"message\": \"" + data + "\"}"; };
+};
+
+//! JSON errors are escaped while streamed, unless getJsonBody() is overridden.
+void testJsonBody()
+{
+   const std::string streamed(reply("GET", [](Request& request) { StreamHttpErrorReply(request, "application/json", "404").send("No \"x\\y\"\n"); }));
+   TEST_CHECK_EQUAL("{\"Error\":\"No \\\"x\\\\y\\\"\\n\"}", bodyOf(streamed));
+   TEST_CHECK(streamed.find("Content-Length: " + std::to_string(bodyOf(streamed).size()) + "\r\n") != std::string::npos);
+
+   const std::string overridden(reply("GET", [](Request& request) { ApiErrorReply(request).send("Not here"); }));
+   TEST_CHECK_EQUAL("{\"code\": 404, \"message\": \"Not here\"}\r\n", bodyOf(overridden));
+   checkHead([](Request& request) { ApiErrorReply(request).send("Not here"); });
+}
+
+//! An overridden getHtmlBody() is sent, and counted in Content-Length.
+void testOverriddenHtmlBody()
+{
+   const std::string get(reply("GET", [](Request& request) { BrandedErrorReply(request, "503").send("Sensor offline"); }));
+   const std::string body("<html><body><h1>Weather station</h1>Sensor offline</body></html>");
+   TEST_CHECK_EQUAL(body + "\r\n", bodyOf(get));
+   TEST_CHECK(get.find("Content-Length: " + std::to_string(body.size()) + "\r\n") != std::string::npos);
+}
+
+//! The request's error status code, unless given.
+void testErrorReplyCode()
+{
+   SimulatedStream stream("GET /\r\n\r\n", NetworkConditions(), micros());
+   Request request(stream);
+   TEST_CHECK(!request.readRequest());
+   StreamHttpErrorReply(request, "text/plain").send("Invalid");
+   TEST_CHECK_EQUAL(std::string("HTTP/1.1 ") + request.getErrorStatusCode() + " Invalid\r\n", stream.getOutput().substr(0, stream.getOutput().find("\r\n") + 2));
+}
+
+//! Replies constructed from a stream take the method as last argument.
+void testStreamMethod()
+{
+   SimulatedStream stream("", NetworkConditions(), micros());
+   StreamHttpReply httpReply(stream, "text/plain", Method::Head);
+   TEST_CHECK(!httpReply.hasBody());
+   httpReply.send("body");
+   TEST_CHECK_EQUAL(headerOf(stream.getOutput()), stream.getOutput());
+   TEST_CHECK(stream.getOutput().find("Content-Length: 4\r\n") != std::string::npos);
+}
+
+//! Logs what it is told, timestamps checked to never go back.
+class RecordingObserver: public AbstractHttpObserver
+{
+public:
+   RecordingObserver() : lastUs(0), ordered(true) { };
+
+   virtual void requestStarted(unsigned long timestampUs) { log("started", timestampUs); }
+   virtual void phaseEnded(Phase phase, unsigned long timestampUs)
+   {
+      static const char* const NAMES[] = { "wait_for_data", "request_line", "headers", "body", "handler", "reply" };
+      log(NAMES[static_cast<int>(phase)], timestampUs);
+      phaseEndUs.push_back(timestampUs);
+   }
+   virtual void requestRead(Method method, RequestError error, size_t bytesRead, unsigned int headerCount)
+   {
+      events.push_back("read " + std::to_string(bytesRead) + " bytes, " + std::to_string(headerCount) + " fields" +
+                       (error == RequestError::OK ? "" : ", failed"));
+   }
+   virtual void replySent(size_t bytesWritten) { events.push_back("sent " + std::to_string(bytesWritten) + " bytes"); }
+
+   std::vector<std::string> events;
+   std::vector<unsigned long> phaseEndUs;
+   unsigned long lastUs;
+   bool ordered;
+
+private:
+   void log(const char* name, unsigned long timestampUs)
+   {
+      ordered = ordered && timestampUs >= lastUs;
+      lastUs = timestampUs;
+      events.push_back(name);
+   }
+};
+
+//! All phases are reported in order, with the bytes read and written, the
+//! handler phase ending where the reply begins.
+template <class SEND_REPLY>
+void checkObserved(SEND_REPLY sendReply)
+{
+   const std::string input("PUT /config HTTP/1.1\r\nHost: device.local\r\nContent-Length: 5\r\n\r\nhello");
+   SimulatedStream stream(input, NetworkConditions(), micros() + 2000UL);
+   RecordingObserver observer;
+
+   Request request(stream);
+   request.setObserver(&observer);
+   TEST_CHECK(request.readRequest());
+   ArduinoHost::advanceClock(5000UL);
+   sendReply(request, observer);
+
+   const std::vector<std::string> expected{ "started", "wait_for_data", "request_line", "headers", "body",
+      "read " + std::to_string(input.size()) + " bytes, 2 fields", "handler", "reply",
+      "sent " + std::to_string(stream.getOutput().size()) + " bytes" };
+   TEST_CHECK(observer.events == expected);
+   TEST_CHECK(observer.ordered);
+   TEST_CHECK(observer.phaseEndUs.size() == 6 && observer.phaseEndUs[0] >= 2000UL);
+   TEST_CHECK(observer.phaseEndUs.size() == 6 && observer.phaseEndUs[4] - observer.phaseEndUs[3] >= 5000UL);
+}
+
+void testObserver()
+{
+   checkObserved([](Request& request, RecordingObserver& observer)
+   {
+      StreamHttpReply httpReply(request, "text/plain");
+      httpReply.setObserver(&observer);
+      httpReply.send("stored");
+   });
+   checkObserved([](Request& request, RecordingObserver& observer)
+   {
+      StreamHttpErrorReply httpReply(request, "application/json", "409");
+      httpReply.setObserver(&observer);
+      httpReply.send("Conflict");
+   });
+   checkObserved([](Request& request, RecordingObserver& observer)
+   {
+      StreamHttpChunkedReply httpReply(request, "text/plain");
+      httpReply.setObserver(&observer);
+      httpReply.begin();
+      ArduinoHost::advanceClock(1000UL);
+      httpReply.print("chunk");
+      httpReply.end();
+   });
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+   testHead();
+   testSegments();
+   testSegmentsSingleWrite();
+   testSegmentSourceEndsEarly();
+   testPipelined();
+   testOverriddenHtmlBody();
+   testJsonBody();
+   testErrorReplyCode();
+   testStreamMethod();
+   testObserver();
+   return TestSupport::result("StreamHttpReply");
+}
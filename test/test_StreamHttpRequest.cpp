@@ -0,0 +1,475 @@
+//
+//! \file
+//  Unit test for StreamHttpRequest
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+//! Runs on the virtual clock, so deadlines are checked without waiting for them.
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamHttpRequest.hpp"
+#include "SimulatedStream.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+typedef StreamHttpRequest<64> Request;
+
+//! SimulatedStream taking its input packet by packet.
+class PacketStream: public SimulatedStream
+{
+public:
+   PacketStream() : SimulatedStream() { };
+   using SimulatedStream::addPacket;
+};
+
+//! Input arriving _packetSize_ bytes every _intervalMs_, the first packet right away.
+NetworkConditions trickle(size_t packetSize, unsigned long intervalMs)
+{
+   NetworkConditions conditions;
+   conditions.minFragmentSize = packetSize;
+   conditions.maxFragmentSize = packetSize;
+   conditions.interPacketDelayUs = intervalMs * 1000UL;
+   return conditions;
+}
+
+RequestLimits shortLimits()
+{
+   RequestLimits limits;
+   limits.firstByteTimeoutMs = 500UL;
+   limits.headerTimeoutMs = 1000UL;
+   limits.bodyTimeoutMs = 1000UL;
+   limits.streamBodyTimeoutMs = 1000UL;
+   limits.maxHeaderFields = 4U;
+   limits.maxHeaderBytes = 256U;
+   return limits;
+}
+
+//! Read _input_ arriving as _conditions_ describe, within shortLimits().
+RequestError readRequest(const std::string& input, const NetworkConditions& conditions, std::string* pStatusCode = 0)
+{
+   SimulatedStream stream(input, conditions, micros());
+   Request request(stream);
+   request.setLimits(shortLimits());
+   request.readRequest();
+   if (pStatusCode != 0)
+   {
+      *pStatusCode = request.getErrorStatusCode();
+   }
+   return request.getErrorCode();
+}
+
+//! A client sending each byte well within any per byte timeout still has to
+//! complete the header within headerTimeoutMs (slowloris).
+void testHeaderDeadlineIsAbsolute()
+{
+   const std::string input("GET /api/status HTTP/1.1\r\nHost: device.local\r\n\r\n");
+   std::string statusCode;
+
+   TEST_CHECK(readRequest(input, trickle(1, 5)) == RequestError::OK);
+   TEST_CHECK(readRequest(input, trickle(1, 50), &statusCode) == RequestError::HEADER_TIMEOUT);
+   TEST_CHECK_EQUAL("408", statusCode);
+}
+
+//! A 40 byte body arriving a byte every _intervalMs_, after a header arriving at once.
+RequestError readSlowBody(unsigned long intervalMs)
+{
+   const std::string header("PUT /api/config HTTP/1.1\r\nContent-Length: 40\r\n\r\n");
+
+   PacketStream stream;
+   unsigned long arrivalUs(micros());
+   stream.addPacket(header.data(), header.size(), arrivalUs);
+   for (int i = 0; i < 40; ++i)
+   {
+      arrivalUs += intervalMs * 1000UL;
+      stream.addPacket("x", 1, arrivalUs);
+   }
+
+   Request request(stream);
+   request.setLimits(shortLimits());
+   request.readRequest();
+   return request.getErrorCode();
+}
+
+void testBodyDeadlineIsAbsolute()
+{
+   TEST_CHECK(readSlowBody(10) == RequestError::OK);
+   TEST_CHECK(readSlowBody(50) == RequestError::BODY_TIMEOUT);
+}
+
+//! Counts what it is given.
+struct CountingSink : Print
+{
+   size_t count = 0;
+   virtual size_t write(uint8_t byte) { ++count; return 1; };
+};
+
+//! The rest of a body beyond the body buffer has to arrive within
+//! streamBodyTimeoutMs, however steadily it trickles.
+bool streamSlowBody(unsigned long intervalMs)
+{
+   const std::string header("PUT /api/firmware HTTP/1.1\r\nContent-Length: 264\r\n\r\n");
+
+   PacketStream stream;
+   unsigned long arrivalUs(micros());
+   stream.addPacket(header.data(), header.size(), arrivalUs);
+   stream.addPacket(std::string(64, 'x').data(), 64, arrivalUs);
+   for (int i = 0; i < 200; ++i)
+   {
+      arrivalUs += intervalMs * 1000UL;
+      stream.addPacket("x", 1, arrivalUs);
+   }
+
+   Request request(stream);
+   request.setLimits(shortLimits());
+   TEST_CHECK(request.readRequest());
+
+   CountingSink sink;
+   const bool streamed(request.streamBody(sink));
+   TEST_CHECK(streamed == (sink.count == 264));
+   TEST_CHECK(streamed || request.getErrorCode() == RequestError::BODY_TIMEOUT);
+   return streamed;
+}
+
+void testStreamBodyDeadlineIsAbsolute()
+{
+   TEST_CHECK(streamSlowBody(2));
+   TEST_CHECK(!streamSlowBody(10));
+}
+
+void testFirstByteDeadline()
+{
+   SimulatedStream stream("GET / HTTP/1.1\r\n\r\n", NetworkConditions(), micros() + 600000UL);
+   Request request(stream);
+   request.setLimits(shortLimits());
+
+   TEST_CHECK(!request.readRequest());
+   TEST_CHECK(request.getErrorCode() == RequestError::TIMEOUT);
+   TEST_CHECK_EQUAL("408", request.getErrorStatusCode());
+}
+
+void testTooManyFields()
+{
+   std::string statusCode;
+   const std::string fields("A: 1\r\nB: 2\r\nC: 3\r\nD: 4\r\n");
+
+   TEST_CHECK(readRequest("GET / HTTP/1.1\r\n" + fields + "\r\n", trickle(16, 1)) == RequestError::OK);
+   TEST_CHECK(readRequest("GET / HTTP/1.1\r\n" + fields + "E: 5\r\n\r\n", trickle(16, 1), &statusCode) == RequestError::TOO_MANY_HEADER_FIELDS);
+   TEST_CHECK_EQUAL("431", statusCode);
+}
+
+void testHeaderTooLarge()
+{
+   std::string statusCode;
+   const std::string cookie("Cookie: " + std::string(300, 'c') + "\r\n");
+
+   TEST_CHECK(readRequest("GET / HTTP/1.1\r\n" + cookie + "\r\n", trickle(64, 1), &statusCode) == RequestError::HEADER_TOO_LARGE);
+   TEST_CHECK_EQUAL("431", statusCode);
+
+   // A line which never ends is cut off at the limit as well, rather than at the deadline.
+   TEST_CHECK(readRequest("GET /" + std::string(400, 'a'), trickle(64, 1), &statusCode) == RequestError::HEADER_TOO_LARGE);
+   TEST_CHECK_EQUAL("431", statusCode);
+}
+
+//! What readRequest() made of a request, and what it left in the stream.
+struct ReadResult
+{
+   RequestError error;
+   Method method;
+   std::string resource;
+   std::string contentType;
+   int contentLength;
+   std::string body;
+   std::string rest;
+};
+
+//! Read _input_ arriving in packets ending at _splits_, through the bulk peek
+//! API when _peek_ is set and by copying otherwise.
+ReadResult readInPackets(const std::string& input, const std::vector<size_t>& splits, bool peek)
+{
+   PacketStream stream;
+   stream.setPeekBufferAPI(peek);
+   unsigned long arrivalUs(micros());
+   size_t start(0);
+   for (size_t end : splits)
+   {
+      stream.addPacket(input.data() + start, end - start, arrivalUs);
+      arrivalUs += 1000UL;
+      start = end;
+   }
+   stream.addPacket(input.data() + start, input.size() - start, arrivalUs);
+
+   Request request(stream);
+   request.setLimits(shortLimits());
+   request.readRequest();
+
+   ReadResult result;
+   result.error = request.getErrorCode();
+   result.method = request.getMethod();
+   result.resource = request.getResource().toString().c_str();
+   result.contentType = request.getContentType().c_str();
+   result.contentLength = request.getContentLength();
+   result.body.assign(request.getBody(), request.getBodyLength());
+
+   ArduinoHost::advanceClock(1000000UL);
+   for (int ch = stream.read(); ch >= 0; ch = stream.read())
+   {
+      result.rest += static_cast<char>(ch);
+   }
+   return result;
+}
+
+void checkSameResult(const ReadResult& expected, const ReadResult& actual)
+{
+   TEST_CHECK(expected.error == actual.error);
+   TEST_CHECK(expected.method == actual.method);
+   TEST_CHECK_EQUAL(expected.resource, actual.resource);
+   TEST_CHECK_EQUAL(expected.contentType, actual.contentType);
+   TEST_CHECK_EQUAL(expected.contentLength, actual.contentLength);
+   TEST_CHECK_EQUAL(expected.body, actual.body);
+   TEST_CHECK_EQUAL(expected.rest, actual.rest);
+}
+
+const std::string PIPELINED_REQUESTS(
+   "POST /api/sensors?unit=C HTTP/1.1\r\n"
+   "Content-Type: application/json\r\n"
+   "Content-Length: 11\r\n"
+   "\r\n"
+   "{\"on\":true}"
+   "GET /next HTTP/1.1\r\n\r\n");
+
+//! The request split over two peek buffers at every offset, request line and
+//! fields included, parses as it does when copied.
+void testPeekSplitAnywhere()
+{
+   const ReadResult expected(readInPackets(PIPELINED_REQUESTS, std::vector<size_t>(), false));
+   TEST_CHECK(expected.error == RequestError::OK);
+   TEST_CHECK(expected.method == Method::Post);
+   TEST_CHECK_EQUAL("/api/sensors?unit=C", expected.resource);
+   TEST_CHECK_EQUAL("application/json", expected.contentType);
+   TEST_CHECK_EQUAL("{\"on\":true}", expected.body);
+   TEST_CHECK_EQUAL("GET /next HTTP/1.1\r\n\r\n", expected.rest);
+
+   for (size_t split = 1; split < PIPELINED_REQUESTS.size(); ++split)
+   {
+      const std::vector<size_t> splits(1, split);
+      checkSameResult(expected, readInPackets(PIPELINED_REQUESTS, splits, true));
+      checkSameResult(expected, readInPackets(PIPELINED_REQUESTS, splits, false));
+   }
+}
+
+//! Every line ending split between CR and LF, each line in its own peek buffer.
+void testPeekSplitCrLf()
+{
+   std::vector<size_t> splits;
+   for (size_t position = PIPELINED_REQUESTS.find("\r\n"); position != std::string::npos; position = PIPELINED_REQUESTS.find("\r\n", position + 1))
+   {
+      splits.push_back(position + 1);
+   }
+
+   checkSameResult(readInPackets(PIPELINED_REQUESTS, std::vector<size_t>(), false),
+                   readInPackets(PIPELINED_REQUESTS, splits, true));
+}
+
+//! Client sending its header, and its body only once it got "100 Continue".
+class ContinueClient: public SimulatedStream
+{
+public:
+   ContinueClient(const std::string& header, const std::string& body) : SimulatedStream(), m_body(body)
+   {
+      addPacket(header.data(), header.size(), micros());
+   }
+
+   using SimulatedStream::write;
+   virtual size_t write(const uint8_t* buffer, size_t size)
+   {
+      const size_t written(SimulatedStream::write(buffer, size));
+      if (!m_body.empty() && getOutput().find("100 Continue") != std::string::npos)
+      {
+         addPacket(m_body.data(), m_body.size(), micros());
+         m_body.clear();
+      }
+      return written;
+   }
+
+private:
+   std::string m_body;
+};
+
+//! Rejects requests to anything but /api/firmware.
+struct FirmwareFilter : AbstractRequestFilter<64>
+{
+   virtual const char* requestLineRead(const Request& request) { return request.getResource().toString() == "/api/firmware" ? 0 : "404"; };
+   virtual const char* headersRead(const Request& request) { return request.getContentLength() <= 1000 ? 0 : "413"; };
+};
+
+const std::string CONTINUE("HTTP/1.1 100 Continue\r\n\r\n");
+
+//! Read an upload of _body_ with _fields_ from a ContinueClient.
+//! \returns What was sent to the client.
+std::string readUpload(const std::string& requestLine, const std::string& fields, const std::string& body, bool peek, RequestError expectedError)
+{
+   ContinueClient client(requestLine + "Content-Length: " + std::to_string(body.size()) + "\r\n" + fields + "\r\n", body);
+   client.setPeekBufferAPI(peek);
+
+   FirmwareFilter filter;
+   Request request(client);
+   request.setLimits(shortLimits());
+   request.setFilter(&filter);
+   request.readRequest();
+
+   TEST_CHECK(request.getErrorCode() == expectedError);
+   if (expectedError == RequestError::OK)
+   {
+      TEST_CHECK_EQUAL(body.substr(0, 63), std::string(request.getBody(), request.getBodyLength()));
+   }
+   return client.getOutput();
+}
+
+void testExpectContinue()
+{
+   const std::string putLine("PUT /api/firmware HTTP/1.1\r\n");
+   const std::string expect("Expect: 100-continue\r\n");
+
+   for (int peek = 0; peek < 2; ++peek)
+   {
+      TEST_CHECK_EQUAL(CONTINUE, readUpload(putLine, expect, "0123456789", peek != 0, RequestError::OK));
+      TEST_CHECK_EQUAL(CONTINUE, readUpload(putLine, "EXPECT: 100-Continue\r\n", std::string(500, 'x'), peek != 0, RequestError::OK));
+
+      // No 100 Continue without Expect, nor for HTTP/1.0, which has no 1xx replies; this client keeps waiting.
+      TEST_CHECK_EQUAL("", readUpload(putLine, "", "abc", peek != 0, RequestError::BODY_TIMEOUT));
+      TEST_CHECK_EQUAL("", readUpload("PUT /api/firmware HTTP/1.0\r\n", expect, "abc", peek != 0, RequestError::BODY_TIMEOUT));
+
+      // Nothing to continue without a body.
+      TEST_CHECK_EQUAL("", readUpload(putLine, expect, "", peek != 0, RequestError::OK));
+
+      // Rejected requests get no 100 Continue, their body is never sent.
+      TEST_CHECK_EQUAL("", readUpload("PUT /api/other HTTP/1.1\r\n", expect, "abc", peek != 0, RequestError::REJECTED));
+      TEST_CHECK_EQUAL("", readUpload(putLine, expect, std::string(2000, 'x'), peek != 0, RequestError::REJECTED));
+   }
+}
+
+
+//! Discards what is available, up to _maxBytes_, waiting at most _waitMs_ for more.
+void testDiscardInput()
+{
+   {
+      SimulatedStream stream(std::string(300, 'x'), NetworkConditions(), micros());
+      TEST_CHECK_EQUAL(200, discardInput(stream, 200, 0UL));
+      TEST_CHECK_EQUAL(100, stream.available());
+   }
+   {
+      PacketStream stream;
+      const unsigned long startUs(micros());
+      stream.addPacket(std::string(100, 'a').data(), 100, startUs);
+      stream.addPacket(std::string(50, 'b').data(), 50, startUs + 500000UL);
+      stream.addPacket(std::string(50, 'c').data(), 50, startUs + 3000000UL);
+
+      TEST_CHECK_EQUAL(100, discardInput(stream, 1000, 0UL));
+      TEST_CHECK(micros() - startUs < 500000UL);
+
+      // The second packet arrives within the budget, the third does not.
+      TEST_CHECK_EQUAL(50, discardInput(stream, 1000, 1000UL));
+      TEST_CHECK(micros() - startUs >= 1000000UL);
+      TEST_CHECK(micros() - startUs < 3000000UL);
+      TEST_CHECK_EQUAL(0, stream.available());
+      TEST_CHECK_EQUAL(50, discardInput(stream, 1000, 5000UL));
+   }
+}
+
+//! Request with a 200 byte body, of which _arrivedBytes_ arrive at once and the rest after _restDelayMs_.
+//! The next request follows the body.
+void addUpload(PacketStream& stream, size_t arrivedBytes, unsigned long restDelayMs)
+{
+   const std::string header("PUT /api/firmware HTTP/1.1\r\nContent-Length: 200\r\n\r\n");
+   const std::string rest(std::string(200 - arrivedBytes, 'y') + "GET /next HTTP/1.1\r\n\r\n");
+   const unsigned long startUs(micros());
+   stream.addPacket((header + std::string(arrivedBytes, 'x')).data(), header.size() + arrivedBytes, startUs);
+   stream.addPacket(rest.data(), rest.size(), startUs + restDelayMs * 1000UL);
+}
+
+//! The body buffer holds part of the body; discardBody() skips the rest, exactly.
+void testDiscardBody()
+{
+   PacketStream stream;
+   addUpload(stream, 100, 200UL);
+
+   Request request(stream);
+   request.setLimits(shortLimits());
+   TEST_CHECK(request.readRequest());
+   TEST_CHECK_EQUAL(200, request.getBodyLength() + request.getUnreadBodyLength());
+
+   TEST_CHECK(request.discardBody());
+   TEST_CHECK_EQUAL(0, request.getUnreadBodyLength());
+
+   Request next(stream);
+   TEST_CHECK(next.readRequest());
+   TEST_CHECK_EQUAL("/next", next.getResource().toString().c_str());
+}
+
+//! More than RequestLimits::maxDiscardBytes is not even started on.
+void testDiscardBodyTooLarge()
+{
+   PacketStream stream;
+   addUpload(stream, 100, 0UL);
+
+   Request request(stream);
+   RequestLimits limits(shortLimits());
+   limits.maxDiscardBytes = 100U;
+   request.setLimits(limits);
+   TEST_CHECK(request.readRequest());
+
+   const size_t unread(request.getUnreadBodyLength());
+   const int available(stream.available());
+   TEST_CHECK(!request.discardBody());
+   TEST_CHECK_EQUAL(unread, request.getUnreadBodyLength());
+   TEST_CHECK_EQUAL(available, stream.available());
+}
+
+//! A body which does not arrive within RequestLimits::discardTimeoutMs is
+//! given up, what was discarded accounted for.
+void testDiscardBodyTimeout()
+{
+   PacketStream stream;
+   addUpload(stream, 100, 5000UL);
+
+   Request request(stream);
+   RequestLimits limits(shortLimits());
+   limits.discardTimeoutMs = 300UL;
+   request.setLimits(limits);
+   TEST_CHECK(request.readRequest());
+
+   const unsigned long startUs(micros());
+   TEST_CHECK(!request.discardBody());
+   TEST_CHECK_EQUAL(100, request.getUnreadBodyLength());
+   TEST_CHECK(micros() - startUs >= 300000UL);
+   TEST_CHECK(micros() - startUs < 5000000UL);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   ArduinoHost::useVirtualClock(true);
+
+   testHeaderDeadlineIsAbsolute();
+   testBodyDeadlineIsAbsolute();
+   testStreamBodyDeadlineIsAbsolute();
+   testFirstByteDeadline();
+   testTooManyFields();
+   testHeaderTooLarge();
+   testPeekSplitAnywhere();
+   testPeekSplitCrLf();
+   testExpectContinue();
+   testDiscardInput();
+   testDiscardBody();
+   testDiscardBodyTooLarge();
+   testDiscardBodyTimeout();
+   return TestSupport::result("StreamHttpRequest");
+}
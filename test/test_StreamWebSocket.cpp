@@ -0,0 +1,182 @@
+//
+//! \file
+//  Unit test for StreamWebSocket
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/StreamWebSocket.hpp"
+#include "SimulatedStream.hpp"
+
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+typedef HttpRequestParser<16> Parser;
+
+const std::string SAMPLE_KEY("dGhlIHNhbXBsZSBub25jZQ==");
+
+//! The handshake of RFC 6455, 1.3, with _fields_ added.
+std::string handshake(const std::string& fields)
+{
+   return "GET /chat HTTP/1.1\r\n"
+          "Host: server.example.com\r\n"
+          "Sec-WebSocket-Key: " + SAMPLE_KEY + "\r\n" +
+          fields +
+          "\r\n";
+}
+
+void parse(Parser& parser, const std::string& request)
+{
+   parser.feed(request.data(), request.size());
+   TEST_CHECK(parser.getState() == Parser::State::COMPLETE);
+}
+
+//! The sample of RFC 6455, 1.3.
+void testAcceptKey()
+{
+   char acceptKey[29];
+   StreamWebSocket::computeAcceptKey(SAMPLE_KEY.c_str(), acceptKey);
+   TEST_CHECK_EQUAL("s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", acceptKey);
+}
+
+void testUpgradeRequest()
+{
+   {
+      Parser parser;
+      parse(parser, handshake("Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 13\r\n"));
+      TEST_CHECK(StreamWebSocket::isUpgradeRequest(parser));
+      TEST_CHECK(!StreamWebSocket::isOtherVersionRequest(parser));
+   }
+   {
+      // Firefox sends "keep-alive, Upgrade".
+      Parser parser;
+      parse(parser, handshake("Upgrade: WebSocket\r\nConnection: keep-alive, Upgrade\r\nSec-WebSocket-Version: 13\r\n"));
+      TEST_CHECK(StreamWebSocket::isUpgradeRequest(parser));
+   }
+   {
+      Parser parser;
+      parse(parser, handshake("Upgrade: websocket\r\nSec-WebSocket-Version: 13\r\n"));
+      TEST_CHECK(!StreamWebSocket::isUpgradeRequest(parser));
+      TEST_CHECK(!StreamWebSocket::isOtherVersionRequest(parser));
+   }
+   {
+      Parser parser;
+      parse(parser, handshake("Upgrade: websocket\r\nConnection: keep-alive, Upgraded\r\nSec-WebSocket-Version: 13\r\n"));
+      TEST_CHECK(!StreamWebSocket::isUpgradeRequest(parser));
+   }
+   {
+      Parser parser;
+      parse(parser, handshake("Upgrade: websocket\r\nConnection: Upgrade\r\n"));
+      TEST_CHECK(!StreamWebSocket::isUpgradeRequest(parser));
+      TEST_CHECK(StreamWebSocket::isOtherVersionRequest(parser));
+   }
+}
+
+void testAccept()
+{
+   Parser parser;
+   parse(parser, handshake("Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 13\r\n"));
+
+   SimulatedStream stream("", NetworkConditions(), 0UL);
+   StreamWebSocket webSocket(stream);
+   TEST_CHECK(webSocket.accept(parser));
+   TEST_CHECK(webSocket.isOpen());
+   TEST_CHECK_EQUAL("HTTP/1.1 101 Switching Protocols\r\n"
+                    "Upgrade: websocket\r\n"
+                    "Connection: Upgrade\r\n"
+                    "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"
+                    "\r\n", stream.getOutput());
+}
+
+void testRejectVersion()
+{
+   Parser parser;
+   parse(parser, handshake("Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 8\r\n"));
+
+   SimulatedStream stream("", NetworkConditions(), 0UL);
+   StreamWebSocket webSocket(stream);
+   TEST_CHECK(!webSocket.accept(parser));
+   TEST_CHECK(!webSocket.isOpen());
+   TEST_CHECK_EQUAL("HTTP/1.1 426 Upgrade Required\r\n"
+                    "Sec-WebSocket-Version: 13\r\n"
+                    "Content-Length: 0\r\n"
+                    "Connection: close\r\n"
+                    "\r\n", stream.getOutput());
+}
+
+//! Stream whose flush() throws away received data, as WiFiClient::flush()
+//! does on the ESP32 core 2.x.
+class DiscardingFlushStream: public SimulatedStream
+{
+public:
+   DiscardingFlushStream(const std::string& input) : SimulatedStream(input, NetworkConditions(), 0UL) { };
+   virtual void flush() { while (read() >= 0) { } };
+};
+
+//! Client frame, masked as clients have to.
+std::string clientFrame(uint8_t opcode, const std::string& payload)
+{
+   const uint8_t mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+   std::string frame;
+   frame += static_cast<char>(0x80 | opcode);
+   frame += static_cast<char>(0x80 | payload.size());
+   frame.append(reinterpret_cast<const char*>(mask), sizeof(mask));
+   for (size_t i = 0; i < payload.size(); ++i)
+   {
+      frame += static_cast<char>(payload[i] ^ mask[i % 4]);
+   }
+   return frame;
+}
+
+//! Frames the client sends right after the handshake, or in reply to a
+//! close, are not lost to a flush.
+void testInputKeptAfterSending()
+{
+   Parser parser;
+   parse(parser, handshake("Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Version: 13\r\n"));
+
+   DiscardingFlushStream stream(clientFrame(0x1, "hello") + clientFrame(0x8, std::string("\x03\xe8", 2)));
+   StreamWebSocket webSocket(stream);
+   TEST_CHECK(webSocket.accept(parser));
+
+   char buffer[16];
+   const int length(webSocket.read(buffer, sizeof(buffer)));
+   TEST_CHECK_EQUAL("hello", std::string(buffer, length > 0 ? length : 0));
+   TEST_CHECK(webSocket.isMessageComplete());
+
+   webSocket.close();
+   TEST_CHECK(webSocket.getState() == StreamWebSocket::State::CLOSING);
+   webSocket.read(buffer, sizeof(buffer));
+   TEST_CHECK(webSocket.getState() == StreamWebSocket::State::CLOSED);
+}
+
+//! A request which is no handshake at all is left to the caller.
+void testNoHandshake()
+{
+   Parser parser;
+   parse(parser, "GET / HTTP/1.1\r\n\r\n");
+
+   SimulatedStream stream("", NetworkConditions(), 0UL);
+   StreamWebSocket webSocket(stream);
+   TEST_CHECK(!webSocket.accept(parser));
+   TEST_CHECK_EQUAL("", stream.getOutput());
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testAcceptKey();
+   testUpgradeRequest();
+   testAccept();
+   testRejectVersion();
+   testInputKeptAfterSending();
+   testNoHandshake();
+   return TestSupport::result("StreamWebSocket");
+}
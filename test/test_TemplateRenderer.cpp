@@ -0,0 +1,186 @@
+//
+//! \file
+//  Unit test for TemplateRenderer
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/TemplateRenderer.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+//! Output keeping each write() apart, accepting at most _capacity_ bytes.
+struct RecordingOutput : Print
+{
+   RecordingOutput(size_t capacity = SIZE_MAX) : writes(), capacity(capacity) { };
+
+   using Print::write;
+   virtual size_t write(uint8_t byte) { return write(&byte, 1); };
+   virtual size_t write(const uint8_t* buffer, size_t size)
+   {
+      size = size < capacity ? size : capacity;
+      capacity -= size;
+      writes.push_back(std::string(reinterpret_cast<const char*>(buffer), size));
+      return size;
+   }
+
+   std::string written() const
+   {
+      std::string text;
+      for (const std::string& part : writes) { text += part; }
+      return text;
+   }
+
+   std::vector<std::string> writes;
+   size_t capacity;
+};
+
+//! Values by name, writing nothing for unknown names. Keeps the names asked for.
+struct MapHandler : AbstractTemplateHandler
+{
+   virtual void placeholder(const char* name, Print& out)
+   {
+      names.push_back(name);
+      const std::map<std::string, std::string>::const_iterator value(values.find(name));
+      if (value != values.end())
+      {
+         out.print(value->second.c_str());
+      }
+   }
+
+   std::map<std::string, std::string> values;
+   std::vector<std::string> names;
+};
+
+MapHandler handler()
+{
+   MapHandler values;
+   values.values["name"] = "Weather station";
+   values.values["ssid"] = "garden";
+   values.values["long"] = std::string(40, 'v');
+   values.values["braces"] = "{{name}}";
+   return values;
+}
+
+template <size_t BLOCK_SIZE>
+std::string render(PGM_P pTemplate, MapHandler& values)
+{
+   RecordingOutput out;
+   TemplateRenderer<BLOCK_SIZE> renderer(values);
+   TEST_CHECK(renderer.render(pTemplate, out));
+   for (const std::string& part : out.writes)
+   {
+      TEST_CHECK(part.size() <= BLOCK_SIZE);
+   }
+   return out.written();
+}
+
+//! The same output whichever block size, so wherever the flash reads split
+//! a placeholder or the text around it.
+void checkRender(PGM_P pTemplate, const std::string& expected)
+{
+   MapHandler values(handler());
+   TEST_CHECK_EQUAL(expected, render<1>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<2>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<3>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<5>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<7>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<11>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<16>(pTemplate, values));
+   TEST_CHECK_EQUAL(expected, render<128>(pTemplate, values));
+}
+
+const char PAGE[] PROGMEM = "<html><body><h1>{{name}}</h1>SSID: {{ ssid }}{{long}}.</body></html>";
+
+void testPlaceholders()
+{
+   checkRender(PAGE, "<html><body><h1>Weather station</h1>SSID: garden" + std::string(40, 'v') + ".</body></html>");
+   checkRender("{{name}}", "Weather station");
+   checkRender("{{name}}{{ssid}}", "Weather stationgarden");
+   checkRender("", "");
+
+   MapHandler values(handler());
+   render<5>(PAGE, values);
+   const std::vector<std::string> names{ "name", "ssid", "long" };
+   TEST_CHECK(values.names == names);
+}
+
+//! Unknown names are asked for and replaced by what the handler writes:
+//! nothing here.
+void testUnknownPlaceholder()
+{
+   checkRender("a{{unknown}}b{{ other }}c", "abc");
+
+   MapHandler values(handler());
+   render<4>("a{{unknown}}b", values);
+   TEST_CHECK(values.names == std::vector<std::string>{ "unknown" });
+}
+
+//! Anything but "{{", a name and "}}" is copied as it is, up to the end of
+//! the template.
+void testUnterminated()
+{
+   checkRender("SSID: {{ssid", "SSID: {{ssid");
+   checkRender("SSID: {{ssid}", "SSID: {{ssid}");
+   checkRender("SSID: {{ssid }", "SSID: {{ssid }");
+   checkRender("SSID: {{", "SSID: {{");
+   checkRender("SSID: {", "SSID: {");
+   checkRender("{{ssid {{name}}", "{{ssid Weather station");
+   checkRender("{{ssid\n}} {{name}}", "{{ssid\n}} Weather station");
+}
+
+//! Braces of scripts, style sheets and JSON need no escaping, nor do names
+//! too long or with spaces in them. Values are not rendered again.
+void testLiteralBraces()
+{
+   checkRender("body { color: red; }", "body { color: red; }");
+   checkRender("var config = {{\"ssid\": 1}};", "var config = {{\"ssid\": 1}};");
+   checkRender("{{}} {{ }} {{a b}}", "{{}} {{ }} {{a b}}");
+   checkRender("{{{name}}}", "{Weather station}");
+   checkRender("}}{{name}}{{", "}}Weather station{{");
+
+   const std::string longName("{{" + std::string(AbstractTemplateRenderer::MAX_NAME_SIZE, 'n') + "}}");
+   checkRender(longName.c_str(), longName);
+   const std::string longestName(std::string(AbstractTemplateRenderer::MAX_NAME_SIZE - 1, 'n'));
+   MapHandler values(handler());
+   values.values[longestName] = "fits";
+   TEST_CHECK_EQUAL("fits", render<8>(("{{" + longestName + "}}").c_str(), values));
+
+   checkRender("<p>{{braces}}</p>", "<p>{{name}}</p>");
+}
+
+//! render() fails when the output does not accept everything.
+void testOutputFailure()
+{
+   MapHandler values(handler());
+   RecordingOutput out(20);
+   TemplateRenderer<8> renderer(values);
+   TEST_CHECK(!renderer.render(PAGE, out));
+   TEST_CHECK_EQUAL("<html><body><h1>Weat", out.written());
+
+   // The renderer can be used again.
+   RecordingOutput next;
+   TEST_CHECK(renderer.render("{{ssid}}", next));
+   TEST_CHECK_EQUAL("garden", next.written());
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testPlaceholders();
+   testUnknownPlaceholder();
+   testUnterminated();
+   testLiteralBraces();
+   testOutputFailure();
+   return TestSupport::result("TemplateRenderer");
+}
@@ -0,0 +1,110 @@
+//
+//! \file
+//  Unit test for UrlEncodedForm
+//
+//  Created on 19-10-26.
+//  Copyright (c) 2026 ArduinoHttpServer contributors. All rights reserved.
+//
+
+#include "TestSupport.hpp"
+#include "../src/internals/UrlEncodedForm.hpp"
+#include "../src/internals/HttpResource.hpp"
+
+#include <string>
+
+using namespace ArduinoHttpServer;
+
+namespace
+{
+
+std::string decode(const std::string& encoded)
+{
+   std::string decoded(encoded);
+   decoded.resize(urlDecode(&decoded[0], decoded.size(), &decoded[0]));
+   return decoded;
+}
+
+std::string valueOf(const FormField* pField)
+{
+   return pField != 0 ? std::string(pField->getValue(), pField->getValueLength()) : "(missing)";
+}
+
+void testDecode()
+{
+   TEST_CHECK_EQUAL("dark red", decode("dark+red"));
+   TEST_CHECK_EQUAL("dark red", decode("dark%20red"));
+   TEST_CHECK_EQUAL("a&b=c/d", decode("a%26b%3Dc%2fd"));
+   TEST_CHECK_EQUAL("caf\xc3\xa9", decode("caf%C3%A9"));
+   // Malformed escapes are kept.
+   TEST_CHECK_EQUAL("100% %zz %4", decode("100%25 %zz %4"));
+   TEST_CHECK_EQUAL("%", decode("%"));
+
+   TEST_CHECK(urlDecodedEquals("dark+red%21", 11, "dark red!"));
+   TEST_CHECK(!urlDecodedEquals("dark+red%21", 11, "dark red"));
+   TEST_CHECK(!urlDecodedEquals("dark+red", 8, "dark red!"));
+}
+
+void testForm()
+{
+   char data[] = "ssid=My+Home%26Garden&password=p%3Ds&&empty=&flag&level=-12";
+   UrlEncodedForm<8> form(data, strlen(data));
+
+   TEST_CHECK_EQUAL(5, form.getCount());
+   TEST_CHECK(!form.isTruncated());
+   TEST_CHECK_EQUAL("My Home&Garden", valueOf(form.find("ssid")));
+   TEST_CHECK_EQUAL("p=s", valueOf(form.find("password")));
+   TEST_CHECK_EQUAL("", valueOf(form.find("empty")));
+   TEST_CHECK_EQUAL("", valueOf(form.find("flag")));
+   TEST_CHECK_EQUAL(-12, form.find("level")->toLong());
+   TEST_CHECK(form.find("missing") == 0);
+
+   // In the order they were sent.
+   std::string keys;
+   for (const FormField& field : form)
+   {
+      keys.append(field.getKey(), field.getKeyLength());
+      keys += ' ';
+   }
+   TEST_CHECK_EQUAL("ssid password empty flag level ", keys);
+}
+
+void testEncodedKeys()
+{
+   char data[] = "a%3Db=1&c%26d=2";
+   UrlEncodedForm<> form(data, strlen(data));
+   TEST_CHECK_EQUAL("1", valueOf(form.find("a=b")));
+   TEST_CHECK_EQUAL("2", valueOf(form.find("c&d")));
+}
+
+void testTruncated()
+{
+   char data[] = "a=1&b=2&c=3";
+   UrlEncodedForm<2> form(data, strlen(data));
+   TEST_CHECK_EQUAL(2, form.getCount());
+   TEST_CHECK(form.isTruncated());
+   TEST_CHECK(form.find("c") == 0);
+}
+
+//! Query parameters decode the same way, also across the decoding buffer.
+void testQueryParameters()
+{
+   const std::string longValue(40, 'x');
+   HttpResource resource(String(("/api/led?color=dark%20red&name=" + longValue + "%21%21&on").c_str()));
+
+   TEST_CHECK_EQUAL("dark red", resource.getQueryParameter("color").c_str());
+   TEST_CHECK_EQUAL(longValue + "!!", resource.getQueryParameter("name").c_str());
+   TEST_CHECK(resource.hasQueryParameter("on"));
+   TEST_CHECK(!resource.hasQueryParameter("off"));
+}
+
+}
+
+int main(int argc, char **argv)
+{
+   testDecode();
+   testForm();
+   testEncodedKeys();
+   testTruncated();
+   testQueryParameters();
+   return TestSupport::result("UrlEncodedForm");
+}